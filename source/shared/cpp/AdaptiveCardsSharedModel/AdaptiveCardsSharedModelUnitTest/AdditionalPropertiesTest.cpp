@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "stdafx.h"
+#include "Container.h"
 #include "ParseUtil.h"
+#include "TextBlock.h"
 #include "TextRun.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -209,5 +211,25 @@ namespace AdaptiveCardsSharedModelUnitTest
             Assert::AreEqual("{\"actions\":[],\"body\":[{\"text\":\"Standard textblock\",\"type\":\"TextBlock\"},{\"property\":\"value\",\"someOtherProperty\":\"some other value\",\"type\":\"SomeRandomType\"}],\"type\":\"AdaptiveCard\",\"version\":\"1.0\"}\n"s,
                 outputCard);
         }
+
+        TEST_METHOD(KnownPropertiesAreSharedPerTypeTest)
+        {
+            TextBlock firstTextBlock;
+            TextBlock secondTextBlock;
+            Container container;
+
+            // every instance of a type shares its type's set...
+            Assert::IsTrue(&firstTextBlock.GetKnownProperties() == &secondTextBlock.GetKnownProperties());
+            Assert::IsTrue(&firstTextBlock.GetKnownProperties() != &container.GetKnownProperties());
+
+            // ...which includes the properties of the types it derives from
+            const auto& textBlockProperties = firstTextBlock.GetKnownProperties();
+            for (const auto& property : {"id"s, "isVisible"s, "text"s, "wrap"s})
+            {
+                Assert::IsTrue(textBlockProperties.find(property) != textBlockProperties.end());
+            }
+            Assert::IsTrue(textBlockProperties.find("items"s) == textBlockProperties.end());
+            Assert::IsTrue(container.GetKnownProperties().find("items"s) != container.GetKnownProperties().end());
+        }
     };
 }
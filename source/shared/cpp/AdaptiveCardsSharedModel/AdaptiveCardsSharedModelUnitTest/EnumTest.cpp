@@ -12,12 +12,14 @@ using namespace std::string_literals;
 #define ENUM_TO_FROM_STRING_TEST(ENUMNAME, VALIDVALUE, VALIDSTRING) \
         Assert::AreEqual(ENUMNAME##ToString(VALIDVALUE), VALIDSTRING); \
         Assert::IsTrue(ENUMNAME##FromString(VALIDSTRING) == VALIDVALUE); \
+        Assert::IsTrue(ENUMNAME##TryFromString(VALIDSTRING) == VALIDVALUE); \
 
 #define ENUM_TEST(ENUMNAME, VALIDVALUE, VALIDSTRING) \
     ENUM_TEST_START(ENUMNAME)                                           \
     {                                                                   \
         ENUM_TO_FROM_STRING_TEST(ENUMNAME, VALIDVALUE, VALIDSTRING);    \
         Assert::ExpectException<std::out_of_range>([]() { ENUMNAME##FromString("This is invalid."); }); \
+        Assert::IsFalse(ENUMNAME##TryFromString("This is invalid.").has_value()); \
     }                                                                   \
 
 #define ENUM_TEST_WITH_REVERSE_MAP(ENUMNAME, VALIDVALUE, VALIDSTRING, ...) \
@@ -58,5 +60,73 @@ namespace AdaptiveCardsSharedModelUnitTest
         ENUM_TEST_WITH_REVERSE_MAP(TextSize, TextSize::Large, "Large"s, {{"Normal", TextSize::Default}});
         ENUM_TEST_WITH_REVERSE_MAP(TextWeight, TextWeight::Bolder, "Bolder"s, {{"Normal", TextWeight::Default}});
         ENUM_TEST(VerticalContentAlignment, VerticalContentAlignment::Center, "Center"s);
+
+        TEST_METHOD(CaseInsensitiveHashTest)
+        {
+            const CaseInsensitiveHash hash;
+            Assert::IsTrue(hash("Left"s) == hash("LEFT"s));
+            Assert::IsTrue(hash("Left"s) == hash("left"s));
+
+            // anagrams used to collide
+            Assert::IsTrue(hash("Dark"s) != hash("Drak"s));
+            Assert::IsTrue(hash("Top"s) != hash("Pot"s));
+
+            Assert::IsTrue(HorizontalAlignmentTryFromString("RIGHT") == HorizontalAlignment::Right);
+        }
+
+        TEST_METHOD(CaseInsensitiveCompareTest)
+        {
+            // lengths either side of the eight bytes compared at a time
+            Assert::IsTrue(CaseInsensitive::Equals("Action.ShowCard", "action.showcard"));
+            Assert::IsTrue(CaseInsensitive::Equals("ACTION.SHOWCARD", "action.showcard"));
+            Assert::IsTrue(CaseInsensitive::Equals("Drop", "drop"));
+            Assert::IsTrue(CaseInsensitive::Equals("", ""));
+            Assert::IsFalse(CaseInsensitive::Equals("Action.ShowCard", "action.showcarx"));
+            Assert::IsFalse(CaseInsensitive::Equals("Drop", "drops"));
+
+            // only ASCII letters fold; '@' and '[' sit either side of 'A'-'Z', and the UTF-8 for 'É' and 'é' differ
+            Assert::IsFalse(CaseInsensitive::Equals("@[", "`{"));
+            Assert::IsFalse(CaseInsensitive::Equals("\xc3\x89t\xc3\xa9", "\xc3\xa9t\xc3\xa9"));
+            Assert::IsTrue(CaseInsensitive::Equals("\xc3\xa9T\xc3\xa9", "\xc3\xa9t\xc3\xa9"));
+
+            Assert::IsTrue(CaseInsensitive::Compare("TextBlock", "textblock") == 0);
+            Assert::IsTrue(CaseInsensitive::Compare("ColumnSet", "column") > 0);
+            Assert::IsTrue(CaseInsensitive::Compare("Action.Submit", "ACTION.TOGGLEVISIBILITY") < 0);
+            Assert::IsTrue(CaseInsensitive::Compare("Image", "imageset") < 0);
+
+            const CaseInsensitiveHash hash;
+            Assert::IsTrue(hash("Action.ToggleVisibility"s) == hash("ACTION.TOGGLEVISIBILITY"s));
+            Assert::IsTrue(hash("Action.ToggleVisibility"s) != hash("Action.ToggleVisibilitx"s));
+            Assert::IsTrue(hash("a"s) != hash("a\0"s));
+
+            // other string types fold the same way
+            const CaseInsensitiveEqualTo equalTo;
+            Assert::IsTrue(equalTo(L"TextBlock"s, L"TEXTBLOCK"s));
+            Assert::IsFalse(equalTo(L"TextBlock"s, L"TextBlocks"s));
+            Assert::IsTrue(hash(L"TextBlock"s) == hash(L"textblock"s));
+
+            std::string value = "Auto\xc3\x89";
+            CaseInsensitive::ToLowerInPlace(value);
+            Assert::AreEqual("auto\xc3\x89"s, value);
+        }
+
+        TEST_METHOD(AdaptiveCardSchemaKeyTableTest)
+        {
+            // ToString is served from a table indexed by value; make sure it agrees with the reverse mapping at
+            // both ends of the enum and still rejects values that have no string
+            for (int key = static_cast<int>(AdaptiveCardSchemaKey::Accent); key <= static_cast<int>(AdaptiveCardSchemaKey::Wrap); ++key)
+            {
+                const auto schemaKey = static_cast<AdaptiveCardSchemaKey>(key);
+                if (schemaKey == AdaptiveCardSchemaKey::ActionOrientation)
+                {
+                    continue;
+                }
+                // (compare strings -- a couple of keys share a string)
+                const auto& keyString = AdaptiveCardSchemaKeyToString(schemaKey);
+                Assert::AreEqual(keyString, AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKeyFromString(keyString)));
+            }
+            Assert::AreEqual("wrap"s, AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap));
+            Assert::ExpectException<std::out_of_range>([]() { AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ActionOrientation); });
+        }
     };
 }
@@ -7,6 +7,9 @@
 #include "ColumnSet.h"
 #include "Container.h"
 #include "FeatureRegistration.h"
+#include "HostFeatures.h"
+#include "Image.h"
+#include "ImageSet.h"
 #include "Media.h"
 #include "OpenUrlAction.h"
 #include "ParseContext.h"
@@ -774,5 +777,97 @@ namespace AdaptiveCardsSharedModelUnitTest
             auto column = (std::static_pointer_cast<ColumnSet>(parseResult->GetAdaptiveCard()->GetBody().at(0)))->GetColumns().at(0);
             Assert::IsTrue(FallbackType::None == column->GetFallbackType());
         }
+
+        TEST_METHOD(ResolveForHost)
+        {
+            std::string cardStr = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "TextBlock", "text": "Plain" },
+                    {
+                        "type": "Container",
+                        "items": [ { "type": "TextBlock", "text": "Inside" }, { "type": "Graph" } ],
+                        "fallback": { "type": "TextBlock", "text": "Container fallback" }
+                    },
+                    { "type": "TextBlock", "text": "Needs foobar 2", "requires": { "FooBar": "2" }, "fallback": "drop" },
+                    { "type": "Media", "sources": [ { "mimeType": "video/mp4", "url": "https://adaptivecards.io/video.mp4" } ], "fallback": { "type": "TextBlock", "text": "No media" } },
+                    { "type": "Graph" }
+                ],
+                "actions": [
+                    { "type": "Action.Execute", "title": "Execute", "fallback": { "type": "Action.Submit", "title": "Submit" } },
+                    { "type": "Action.ShowCard", "title": "More", "card": { "type": "AdaptiveCard", "body": [ { "type": "Graph" }, { "type": "TextBlock", "text": "Shown" } ] } }
+                ]
+            })card";
+            const auto card = AdaptiveCard::DeserializeFromString(cardStr, "1.2")->GetAdaptiveCard();
+
+            FeatureRegistration featureRegistration;
+            featureRegistration.AddFeature("foobar", "1");
+            const HostFeatures hostFeatures(featureRegistration, {"Media", "Action.Execute"});
+            Assert::IsFalse(hostFeatures.MeetsRequirements(*card->GetBody()[2]));
+            Assert::IsFalse(hostFeatures.IsSupported(*card->GetBody()[3]));
+            Assert::IsFalse(hostFeatures.IsSupported(*card->GetBody()[4]));
+
+            const auto parseResult = hostFeatures.Resolve(*card);
+            const auto resolved = parseResult->GetAdaptiveCard();
+            const auto& body = resolved->GetBody();
+            Assert::AreEqual(3u, static_cast<unsigned int>(body.size()));
+            Assert::IsTrue(body[0] == card->GetBody()[0]);
+            Assert::AreEqual("Container fallback"s, std::static_pointer_cast<TextBlock>(body[1])->GetText());
+            Assert::AreEqual("No media"s, std::static_pointer_cast<TextBlock>(body[2])->GetText());
+
+            const auto& actions = resolved->GetActions();
+            Assert::AreEqual(2u, static_cast<unsigned int>(actions.size()));
+            Assert::AreEqual("Action.Submit"s, actions[0]->GetElementTypeString());
+            const auto showCard = std::static_pointer_cast<ShowCardAction>(actions[1])->GetCard();
+            Assert::AreEqual(1u, static_cast<unsigned int>(showCard->GetBody().size()));
+            Assert::AreEqual("Shown"s, std::static_pointer_cast<TextBlock>(showCard->GetBody()[0])->GetText());
+
+            // Container fallback, drop, Media fallback, unsupported Graph, Execute fallback, and the Graph in the ShowCard
+            Assert::AreEqual(6u, static_cast<unsigned int>(parseResult->GetWarnings().size()));
+
+            // the original card is untouched
+            Assert::AreEqual(5u, static_cast<unsigned int>(card->GetBody().size()));
+            Assert::AreEqual(2u, static_cast<unsigned int>(std::static_pointer_cast<Container>(card->GetBody()[1])->GetItems().size()));
+            Assert::AreEqual(2u,
+                             static_cast<unsigned int>(std::static_pointer_cast<ShowCardAction>(card->GetActions()[1])->GetCard()->GetBody().size()));
+
+            // any version of a feature registered as "*" will do
+            FeatureRegistration anyFoobar;
+            anyFoobar.AddFeature("foobar", "*");
+            const HostFeatures anyFoobarFeatures(anyFoobar);
+            Assert::IsTrue(anyFoobarFeatures.MeetsRequirements(*card->GetBody()[2]));
+            Assert::IsTrue(anyFoobarFeatures.Resolve(*card)->GetAdaptiveCard()->GetBody()[2] == card->GetBody()[2]);
+        }
+
+        TEST_METHOD(ResolveForHostWrongFallbackType)
+        {
+            std::string cardStr = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "ImageSet",
+                        "images": [
+                            { "type": "Image", "url": "https://adaptivecards.io/first.png" },
+                            { "type": "Image", "url": "https://adaptivecards.io/second.png", "requires": { "FooBar": "2" }, "fallback": { "type": "TextBlock", "text": "Not an image" } }
+                        ]
+                    }
+                ]
+            })card";
+            const auto card = AdaptiveCard::DeserializeFromString(cardStr, "1.2")->GetAdaptiveCard();
+
+            const HostFeatures hostFeatures{FeatureRegistration()};
+            const auto parseResult = hostFeatures.Resolve(*card);
+            const auto imageSet = std::static_pointer_cast<ImageSet>(parseResult->GetAdaptiveCard()->GetBody()[0]);
+            Assert::AreEqual(1u, static_cast<unsigned int>(imageSet->GetImages().size()));
+            Assert::AreEqual("https://adaptivecards.io/first.png"s, imageSet->GetImages()[0]->GetUrl());
+
+            // the fallback taken, and the TextBlock it produced being dropped from the ImageSet
+            const auto& warnings = parseResult->GetWarnings();
+            Assert::AreEqual(2u, static_cast<unsigned int>(warnings.size()));
+            Assert::IsTrue(WarningStatusCode::UnknownElementType == warnings[1]->GetStatusCode());
+            Assert::AreEqual("Dropping fallback content 'TextBlock', which can't stand in for 'Image'"s, warnings[1]->GetReason());
+        }
     };
 }
@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "stdafx.h"
+#include "Fact.h"
+#include "MarkDownCache.h"
 #include "MarkDownParser.h"
+#include "TextBlock.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace AdaptiveCards;
@@ -417,6 +420,14 @@ namespace AdaptiveCardsSharedModelUnitTest
             Assert::AreEqual<bool>(parser.HasHtmlTags(), true);
         }
 
+        TEST_METHOD(LinkBasicValidationTest_UnclosedLinkDestinationTest)
+        {
+            // the destination has no closing parenthesis for the link to drop
+            MarkDownParser parser("[a](<b");
+            Assert::AreEqual<std::string>("<p><a href=\"\">a</a>&lt;b</p>", parser.TransformToHtml());
+            Assert::AreEqual<bool>(true, parser.HasHtmlTags());
+        }
+
         TEST_METHOD(LinkBasicValidationTest_ValidLinkTestWithUnMatchingBracketsWithChars)
         {
             MarkDownParser parser("[a[b[hello](www.naver.com)");
@@ -683,6 +694,45 @@ namespace AdaptiveCardsSharedModelUnitTest
             Assert::AreEqual<std::string>("<p>Green Eggs &amp; Ham</p>", parser.TransformToHtml());
         }
 
+        TEST_METHOD(EscapeHtmlCharactersTest_LongTextTest)
+        {
+            // escaped chars in and across 16 byte blocks, and in the text after the last whole block
+            MarkDownParser parser("The quick brown <fox> jumps over \"the\" lazy dog & cat <");
+            Assert::AreEqual<std::string>("<p>The quick brown &lt;fox&gt; jumps over &quot;the&quot; lazy dog &amp; cat &lt;</p>",
+                parser.TransformToHtml());
+            Assert::AreEqual<bool>(false, parser.HasHtmlTags());
+            Assert::AreEqual<bool>(true, parser.IsEscaped());
+
+            MarkDownParser markDownParser("The quick brown fox jumps over the **lazy** dog");
+            Assert::AreEqual<std::string>("<p>The quick brown fox jumps over the <strong>lazy</strong> dog</p>",
+                markDownParser.TransformToHtml());
+            Assert::AreEqual<bool>(false, markDownParser.IsEscaped());
+        }
+
+        TEST_METHOD(PlainTextTest_ListMarkerTest)
+        {
+            // list markers start lists only at the start of a block, which plain text has one of
+            MarkDownParser parser("a - b + c 1. d");
+            Assert::AreEqual<std::string>("<p>a - b + c 1. d</p>", parser.TransformToHtml());
+
+            MarkDownParser listParser("- b");
+            Assert::AreEqual<std::string>("<ul><li>b</li></ul>", listParser.TransformToHtml());
+
+            MarkDownParser orderedListParser("1. b");
+            Assert::AreEqual<std::string>("<ol start=\"1\"><li>b</li></ol>", orderedListParser.TransformToHtml());
+        }
+
+        TEST_METHOD(PlainTextTest_RunsTest)
+        {
+            MarkDownParser parser("Green Eggs & Ham");
+            MarkDownRuns runs = parser.TransformToRuns();
+            Assert::AreEqual<size_t>(1, runs.runs.size());
+            Assert::AreEqual<std::string>("Green Eggs & Ham", runs.text.substr(runs.runs[0].offset, runs.runs[0].length));
+            Assert::AreEqual<bool>(true, runs.runs[0].startsParagraph);
+            Assert::AreEqual<bool>(false, runs.runs[0].isBold);
+            Assert::AreEqual<std::string>("<p>Green Eggs &amp; Ham</p>", parser.TransformToHtml());
+        }
+
         TEST_METHOD(NonLatinCharacters_NoMarkdown)
         {
             MarkDownParser parser("以前の製品のリンクで検索");
@@ -760,5 +810,160 @@ namespace AdaptiveCardsSharedModelUnitTest
             (void) parser3.TransformToHtml();
             Assert::AreEqual<bool>(true, parser3.IsEscaped());
         }
+
+        TEST_METHOD(RunsTest_EmphasisTest)
+        {
+            MarkDownParser parser("a **b** _c_ & d");
+            MarkDownRuns runs = parser.TransformToRuns();
+            Assert::AreEqual<size_t>(5, runs.runs.size());
+
+            const std::string texts[] = {"a ", "b", " ", "c", " & d"};
+            const bool bold[] = {false, true, false, false, false};
+            const bool italic[] = {false, false, false, true, false};
+            for (size_t i = 0; i < runs.runs.size(); i++)
+            {
+                const MarkDownRun& run = runs.runs[i];
+                Assert::AreEqual<std::string>(texts[i], runs.text.substr(run.offset, run.length));
+                Assert::AreEqual<bool>(bold[i], run.isBold);
+                Assert::AreEqual<bool>(italic[i], run.isItalic);
+                Assert::AreEqual<bool>(false, run.isLink);
+                Assert::AreEqual<bool>(i == 0, run.startsParagraph);
+            }
+        }
+
+        TEST_METHOD(RunsTest_LinkTest)
+        {
+            MarkDownParser parser("Click [**here**](https://www.microsoft.com?a=1&b=2)");
+            MarkDownRuns runs = parser.TransformToRuns();
+            Assert::AreEqual<size_t>(2, runs.runs.size());
+
+            const MarkDownRun& text = runs.runs[0];
+            Assert::AreEqual<std::string>("Click ", runs.text.substr(text.offset, text.length));
+            Assert::AreEqual<bool>(false, text.isLink);
+
+            const MarkDownRun& link = runs.runs[1];
+            Assert::AreEqual<std::string>("here", runs.text.substr(link.offset, link.length));
+            Assert::AreEqual<bool>(true, link.isLink);
+            Assert::AreEqual<bool>(true, link.isBold);
+            Assert::AreEqual<std::string>("https://www.microsoft.com?a=1&b=2", runs.text.substr(link.urlOffset, link.urlLength));
+        }
+
+        TEST_METHOD(RunsTest_ListTest)
+        {
+            MarkDownParser parser("Steps\r3. one\r4. *two*\r- three");
+            MarkDownRuns runs = parser.TransformToRuns();
+            Assert::AreEqual<size_t>(4, runs.runs.size());
+
+            const std::string texts[] = {"Steps", "one", "two", "three"};
+            const unsigned int numbers[] = {0, 3, 4, 0};
+            for (size_t i = 0; i < runs.runs.size(); i++)
+            {
+                const MarkDownRun& run = runs.runs[i];
+                Assert::AreEqual<std::string>(texts[i], runs.text.substr(run.offset, run.length));
+                Assert::AreEqual<bool>(i == 0, run.startsParagraph);
+                Assert::AreEqual<bool>(i != 0, run.startsListItem);
+                Assert::AreEqual<bool>(i == 1 || i == 2, run.isOrderedListItem);
+                Assert::AreEqual<unsigned int>(numbers[i], run.listItemNumber);
+            }
+            Assert::AreEqual<bool>(true, runs.runs[2].isItalic);
+        }
+
+        TEST_METHOD(RunsTest_EmptyTest)
+        {
+            MarkDownParser parser("");
+            MarkDownRuns runs = parser.TransformToRuns();
+            Assert::AreEqual<size_t>(1, runs.runs.size());
+            Assert::AreEqual<size_t>(0, runs.runs[0].length);
+            Assert::AreEqual<bool>(true, runs.runs[0].startsParagraph);
+        }
+
+        TEST_METHOD(RunsTest_SameParseAsHtmlTest)
+        {
+            MarkDownParser parser("- [a](b)");
+            Assert::AreEqual<std::string>("<ul><li><a href=\"b\">a</a></li></ul>", parser.TransformToHtml());
+
+            MarkDownRuns runs = parser.TransformToRuns();
+            Assert::AreEqual<size_t>(1, runs.runs.size());
+            Assert::AreEqual<bool>(true, runs.runs[0].startsListItem);
+            Assert::AreEqual<bool>(true, runs.runs[0].isLink);
+            Assert::AreEqual<std::string>("<ul><li><a href=\"b\">a</a></li></ul>", parser.TransformToHtml());
+        }
+
+        TEST_METHOD(MarkDownCacheTest)
+        {
+            MarkDownCache cache;
+            const auto first = cache.Transform("**Status:** Approved");
+            const auto second = cache.Transform("**Status:** Approved");
+            Assert::IsTrue(first == second);
+            Assert::AreEqual<std::string>("<p><strong>Status:</strong> Approved</p>", first->html);
+            Assert::AreEqual<bool>(true, first->hasHtmlTags);
+            Assert::AreEqual<size_t>(2, first->runs.runs.size());
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().hits));
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().misses));
+
+            // entries are keyed by the bytes of the text
+            Assert::IsTrue(cache.Transform("**status:** Approved") != first);
+            Assert::AreEqual(2u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+
+            // least recently used entries are evicted to stay within the budget
+            const size_t bytes = cache.GetStatistics().byteCount;
+            cache.Transform("**Status:** Approved");
+            cache.SetMaxBytes(bytes - 1);
+            Assert::AreEqual(1u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().evictions));
+            Assert::IsTrue(cache.Transform("**Status:** Approved") == first);
+
+            cache.SetMaxBytes(0);
+            Assert::AreEqual(0u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+            Assert::IsTrue(cache.Transform("**Status:** Approved") != first);
+            Assert::AreEqual(0u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+
+            // concurrent lookups of the same few strings
+            cache.SetMaxBytes(MarkDownCache::DefaultMaxBytes);
+            cache.Clear();
+            std::vector<std::thread> threads;
+            std::vector<std::string> html(8);
+            for (size_t i = 0; i < html.size(); ++i)
+            {
+                threads.emplace_back([&cache, &html, i]() {
+                    for (int iteration = 0; iteration < 50; ++iteration)
+                    {
+                        html[i] = cache.Transform((iteration % 2) ? "**Status:** Approved" : "- _a_")->html;
+                    }
+                });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            Assert::AreEqual(2u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+            for (const auto& result : html)
+            {
+                Assert::AreEqual<std::string>("<p><strong>Status:</strong> Approved</p>", result);
+            }
+        }
+
+        TEST_METHOD(MarkDownResultOnElementTest)
+        {
+            MarkDownCache cache;
+            TextBlock textBlock;
+            textBlock.SetText("**Status:** Approved");
+
+            // the element keeps its result, so later renders don't go to the cache
+            const auto first = textBlock.GetMarkDownResult(textBlock.GetText(), &cache);
+            Assert::IsTrue(textBlock.GetMarkDownResult(textBlock.GetText(), &cache) == first);
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().misses));
+            Assert::AreEqual(0ui64, static_cast<unsigned long long>(cache.GetStatistics().hits));
+
+            // but only for the same text
+            const auto changed = textBlock.GetMarkDownResult("Status: _Approved_", &cache);
+            Assert::AreEqual<std::string>("<p>Status: <em>Approved</em></p>", changed->html);
+
+            // another element with the same text shares the cache's result
+            Fact fact("**Status:** Approved", "Approved");
+            Assert::IsTrue(fact.GetTitleMarkDownResult(fact.GetTitle(), &cache) == first);
+            Assert::AreEqual<std::string>("<p>Approved</p>", fact.GetValueMarkDownResult(fact.GetValue())->html);
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().hits));
+        }
     };
 }
@@ -2,20 +2,37 @@
 // Licensed under the MIT License.
 #include "stdafx.h"
 
+#include "CardPatch.h"
+#include "CardSnapshot.h"
 #include "ChoiceSetInput.h"
 #include "Column.h"
 #include "ColumnSet.h"
 #include "Container.h"
+#include "ElementIndex.h"
+#include "Fact.h"
+#include "FactSet.h"
 #include "FeatureRegistration.h"
+#include "ImmutableCard.h"
 #include "Media.h"
+#include "NumberInput.h"
 #include "OpenUrlAction.h"
 #include "ParseContext.h"
+#include "ParsedCardCache.h"
+#include "RichTextBlock.h"
 #include "ShowCardAction.h"
 #include "SubmitAction.h"
 #include "TextBlock.h"
 #include "TextInput.h"
+#include "TextRun.h"
 #include "ToggleInput.h"
+#include "ToggleVisibilityAction.h"
 #include "UnknownElement.h"
+#include <filesystem>
+
+// the samples, relative to this directory; builds that run the tests from elsewhere define their own
+#ifndef ADAPTIVECARDS_SAMPLES_DIR
+#define ADAPTIVECARDS_SAMPLES_DIR "../../../../../samples"
+#endif
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace AdaptiveCards;
@@ -739,5 +756,944 @@ namespace AdaptiveCardsSharedModelUnitTest
             const auto serializedCard = card->SerializeToJsonValue();
             Assert::IsTrue(serializedCard["body"][0]["isMultiline"].asBool());
         }
+
+        TEST_METHOD(StreamingDeserializationMatchesDomTest)
+        {
+            const std::string testjson{ R"(
+                    {
+                        "$schema": "http://adaptivecards.io/schemas/adaptive-card.json",
+                        "type": "AdaptiveCard",
+                        "version": "1.2",
+                        // comments are allowed by the regular parser, so they're allowed here too
+                        "body": [
+                            {
+                                "type": "Container",
+                                "bleed": true,
+                                "style": "emphasis",
+                                "items": [ { "type": "TextBlock", "text": "brackets in strings [{\"}]" } ]
+                            },
+                            {
+                                "type": "Unknown",
+                                "id": "fancy",
+                                "fallback": { "type": "Input.Text", "id": "fancy" }
+                            }
+                        ],
+                        "actions": [ { "type": "Action.Submit", "title": "Submit" } ],
+                        "minHeight": "50px",
+                        "selectAction": { "type": "Action.OpenUrl", "url": "https://adaptivecards.io" },
+                        "unknownProperty": [ 1, 2, 3 ]
+                    }
+                )"};
+
+            const auto domResult = AdaptiveCard::DeserializeFromString(testjson, "1.2");
+            const auto streamingResult = AdaptiveCard::DeserializeFromStringStreaming(testjson, "1.2");
+
+            Assert::AreEqual(domResult->GetAdaptiveCard()->Serialize(), streamingResult->GetAdaptiveCard()->Serialize());
+            Assert::AreEqual(domResult->GetWarnings().size(), streamingResult->GetWarnings().size());
+        }
+
+        TEST_METHOD(StreamingDeserializationErrorsTest)
+        {
+            // duplicate ids are still detected across streamed elements
+            const std::string duplicateIds{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.0",
+                "body": [ { "type": "Input.Text", "id": "duplicate" } ],
+                "actions": [ { "type": "Action.Submit", "id": "duplicate" } ]
+            })"};
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { AdaptiveCard::DeserializeFromStringStreaming(duplicateIds, "1.0"); });
+
+            // body that isn't an array is reported exactly as it is by the regular parser
+            const std::string bodyNotArray{ R"({ "type": "AdaptiveCard", "version": "1.0", "body": { "type": "TextBlock" } })"};
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { AdaptiveCard::DeserializeFromStringStreaming(bodyNotArray, "1.0"); });
+
+            // truncated json
+            const std::string truncated{ R"({ "type": "AdaptiveCard", "version": "1.0", "body": [ { "type": "TextBlock", )"};
+            try
+            {
+                AdaptiveCard::DeserializeFromStringStreaming(truncated, "1.0");
+                Assert::Fail(L"Truncated json should throw");
+            }
+            catch (const AdaptiveCardParseException& e)
+            {
+                Assert::IsTrue(ErrorStatusCode::InvalidJson == e.GetStatusCode());
+            }
+
+            Assert::ExpectException<AdaptiveCardParseException>([]() { AdaptiveCard::DeserializeFromStringStreaming("definitely not json", "1.0"); });
+        }
+
+        TEST_METHOD(DeserializeBatchTest)
+        {
+            // duplicate ids in fallback content are only legal because of the internal ids that link fallback to
+            // its parent, so this also checks that internal ids stay consistent while other threads are parsing
+            const std::string validCard{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "Unknown", "id": "fancy", "fallback": { "type": "Input.Text", "id": "fancy" } },
+                    { "type": "Container", "items": [ { "type": "TextBlock", "id": "text", "text": "hello" } ] }
+                ],
+                "actions": [ { "type": "Action.Submit", "id": "submit" } ]
+            })"};
+            const std::string duplicateIds{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.0",
+                "body": [ { "type": "Input.Text", "id": "duplicate" }, { "type": "Input.Text", "id": "duplicate" } ]
+            })"};
+
+            std::vector<std::string> cards(64, validCard);
+            cards[17] = duplicateIds;
+            cards[40] = "not json";
+
+            const std::string expected = AdaptiveCard::DeserializeFromString(validCard, "1.2")->GetAdaptiveCard()->Serialize();
+
+            for (unsigned int threads : {1u, 4u})
+            {
+                std::vector<std::exception_ptr> errors;
+                const auto results = AdaptiveCard::DeserializeBatch(cards, "1.2", nullptr, nullptr, threads, &errors);
+
+                Assert::AreEqual(cards.size(), results.size());
+                Assert::AreEqual(cards.size(), errors.size());
+                for (size_t i = 0; i < cards.size(); ++i)
+                {
+                    if (i == 17 || i == 40)
+                    {
+                        Assert::IsTrue(results[i] == nullptr);
+                        Assert::ExpectException<AdaptiveCardParseException>([&]() { std::rethrow_exception(errors[i]); });
+                    }
+                    else
+                    {
+                        Assert::IsTrue(errors[i] == nullptr);
+                        Assert::AreEqual(expected, results[i]->GetAdaptiveCard()->Serialize());
+                    }
+                }
+            }
+
+            Assert::IsTrue(AdaptiveCard::DeserializeBatch({}, "1.2").empty());
+        }
+
+        TEST_METHOD(ParallelParseMatchesSerialTest)
+        {
+            // A container with many siblings, some with fallback sharing their id, some producing warnings, plus a
+            // table whose rows are parsed in parallel as well
+            auto makeCard = [](const std::string& extraElement) {
+                std::string items;
+                for (int i = 0; i < 200; ++i)
+                {
+                    const std::string id = "item" + std::to_string(i);
+                    items += (i % 7 == 0) ? R"({ "type": "Fancy", "id": ")" + id + R"(", "fallback": { "type": "TextBlock", "id": ")" + id + R"(", "text": "fallback" } },)" :
+                             (i % 11 == 0) ? R"({ "type": "Unknown", "id": ")" + id + R"(" },)" :
+                                             R"({ "type": "Container", "id": ")" + id + R"(", "style": "emphasis", "items": [ { "type": "TextBlock", "text": "hi" } ] },)";
+                }
+
+                std::string rows;
+                for (int i = 0; i < 50; ++i)
+                {
+                    rows += R"({ "type": "TableRow", "cells": [ { "type": "TableCell", "id": "cell)" + std::to_string(i) +
+                            R"(", "items": [ { "type": "TextBlock", "text": "cell" } ] } ] },)";
+                }
+                rows.pop_back();
+
+                return R"({ "type": "AdaptiveCard", "version": "1.5", "body": [ { "type": "Container", "items": [ )" + items +
+                       extraElement + R"({ "type": "Table", "columns": [ { "width": 1 } ], "rows": [ )" + rows + "] } ] } ] }";
+            };
+
+            auto parse = [](const std::string& json, size_t threshold) {
+                ParseContext context;
+                context.SetParallelParseThreshold(threshold);
+                try
+                {
+                    const auto parseResult = AdaptiveCard::DeserializeFromString(json, "1.5", context);
+                    std::string result = parseResult->GetAdaptiveCard()->Serialize();
+                    for (const auto& warning : parseResult->GetWarnings())
+                    {
+                        result += std::to_string(static_cast<int>(warning->GetStatusCode())) + warning->GetReason();
+                    }
+                    return result;
+                }
+                catch (const AdaptiveCardParseException& e)
+                {
+                    return std::to_string(static_cast<int>(e.GetStatusCode())) + e.GetReason();
+                }
+            };
+
+            const std::string validCard = makeCard("");
+            Assert::AreEqual(parse(validCard, 0), parse(validCard, 2));
+            Assert::AreEqual(parse(validCard, 0), parse(validCard, 100));
+            Assert::IsTrue(parse(validCard, 0).find(R"("type":"Table")") != std::string::npos);
+
+            // collision with an element parsed on another thread
+            const std::string collision = makeCard(R"({ "type": "TextBlock", "id": "item3", "text": "oops" },)");
+            Assert::AreEqual(parse(collision, 0), parse(collision, 2));
+            Assert::IsTrue(parse(collision, 2).find("Collision detected for id 'item3'") != std::string::npos);
+
+            // fallback content may share its parent's id, but not an id used elsewhere
+            const std::string fallbackCollision =
+                makeCard(R"({ "type": "Fancy", "fallback": { "type": "TextBlock", "id": "item14", "text": "oops" } },)");
+            Assert::AreEqual(parse(fallbackCollision, 0), parse(fallbackCollision, 2));
+
+            // when there's more than one error, the one reported is the one a serial parse hits first
+            const std::string twoErrors = makeCard(R"({ "type": "TextBlock", "id": "item3", "text": "oops" }, { "type": "Image" },)");
+            Assert::AreEqual(parse(twoErrors, 0), parse(twoErrors, 2));
+            const std::string twoErrorsReversed = makeCard(R"({ "type": "Image" }, { "type": "TextBlock", "id": "item3", "text": "oops" },)");
+            Assert::AreEqual(parse(twoErrorsReversed, 0), parse(twoErrorsReversed, 2));
+            Assert::IsTrue(parse(twoErrors, 2) != parse(twoErrorsReversed, 2));
+        }
+
+        TEST_METHOD(ParallelParseAfterShowCardMatchesSerialTest)
+        {
+            // The card of an Action.ShowCard leaves its language and style on the context, so elements after it are
+            // parsed with them
+            std::string items = R"({ "type": "ActionSet", "actions": [ { "type": "Action.ShowCard", "card": {
+                "type": "AdaptiveCard", "lang": "fr", "style": "emphasis", "body": [] } } ] },)";
+            for (int i = 0; i < 1000; ++i)
+            {
+                items += (i % 2 == 0) ? R"({ "type": "TextBlock", "text": "hi" },)" :
+                                        R"({ "type": "Container", "style": "emphasis", "items": [] },)";
+            }
+            items.pop_back();
+            const std::string cardJson = R"({ "type": "AdaptiveCard", "version": "1.5", "body": [ )" + items + "] }";
+
+            auto describe = [&cardJson](size_t threshold) {
+                ParseContext context;
+                context.SetParallelParseThreshold(threshold);
+                const auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.5", context)->GetAdaptiveCard();
+                std::string description;
+                for (const auto& element : card->GetBody())
+                {
+                    if (const auto textBlock = std::dynamic_pointer_cast<TextBlock>(element))
+                    {
+                        description += textBlock->GetLanguage() + ",";
+                    }
+                    else if (const auto container = std::dynamic_pointer_cast<Container>(element))
+                    {
+                        description += container->GetPadding() ? "padded," : "unpadded,";
+                    }
+                }
+                return description;
+            };
+
+            const std::string serial = describe(0);
+            Assert::IsTrue(serial.find("fr,unpadded,") != std::string::npos);
+            Assert::AreEqual(serial, describe(2));
+        }
+
+        TEST_METHOD(ArenaAllocationTest)
+        {
+            const std::string testjson{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.3",
+                "body": [
+                    { "type": "TextBlock", "text": "first" },
+                    { "type": "Container", "items": [ { "type": "Input.ChoiceSet", "id": "choices", "choices": [ { "title": "a", "value": "1" } ] } ] },
+                    { "type": "FactSet", "facts": [ { "title": "t", "value": "v" } ] }
+                ],
+                "actions": [ { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "text": "shown" } ] } } ]
+            })"};
+
+            // off by default
+            const auto heapResult = AdaptiveCard::DeserializeFromString(testjson, "1.3");
+            Assert::IsTrue(heapResult->GetArena() == nullptr);
+
+            std::weak_ptr<ParseArena> weakArena;
+            std::shared_ptr<BaseCardElement> retainedElement;
+            {
+                ParseContext context;
+                context.SetUseArenaAllocation(true);
+                Assert::IsTrue(context.GetUseArenaAllocation());
+
+                const auto arenaResult = AdaptiveCard::DeserializeFromString(testjson, "1.3", context);
+                Assert::AreEqual(heapResult->GetAdaptiveCard()->Serialize(), arenaResult->GetAdaptiveCard()->Serialize());
+
+                const auto arena = arenaResult->GetArena();
+                // 2 cards (each with its refresh, authentication, and token exchange resource), 5 elements, 1 action,
+                // 1 choice, and 1 fact
+                Assert::AreEqual(16ui64, static_cast<unsigned long long>(arena->GetAllocationCount()));
+                Assert::IsTrue(arena->GetAllocatedBytes() <= arena->GetReservedBytes());
+
+                // every parse gets an arena of its own
+                Assert::IsTrue(context.GetArena() == nullptr);
+                const auto secondResult = AdaptiveCard::DeserializeFromString(
+                    R"({ "type": "AdaptiveCard", "version": "1.3", "body": [ { "type": "TextBlock", "text": "second" } ] })", "1.3", context);
+                Assert::IsTrue(secondResult->GetArena() != arena);
+                Assert::AreEqual(16ui64, static_cast<unsigned long long>(arena->GetAllocationCount()));
+                Assert::AreEqual(5ui64, static_cast<unsigned long long>(secondResult->GetArena()->GetAllocationCount()));
+
+                weakArena = arena;
+                retainedElement = arenaResult->GetAdaptiveCard()->GetBody().front();
+            }
+
+            // elements keep their arena alive on their own...
+            Assert::IsFalse(weakArena.expired());
+            Assert::AreEqual(std::string("first"), std::dynamic_pointer_cast<TextBlock>(retainedElement)->GetText());
+
+            // ...and it's released with the last of them
+            retainedElement.reset();
+            Assert::IsTrue(weakArena.expired());
+        }
+
+        TEST_METHOD(CardSnapshotRoundTripTest)
+        {
+            const std::string testjson{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "customProperty": { "nested": [ null, true, -3, 4000000000, 2.5, "\u00e9t\u00e9" ] },
+                "body": [
+                    { "type": "TextBlock", "id": "title", "text": "Hello", "size": "large", "wrap": true },
+                    { "type": "Container", "items": [ { "type": "Image", "url": "https://adaptivecards.io/image.png" } ] },
+                    { "type": "Unknown", "whatever": "kept" },
+                    { "type": "TextBlock", "text": "Hello" }
+                ],
+                "actions": [ { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "text": "shown" } ] } } ]
+            })"};
+
+            const auto card = AdaptiveCard::DeserializeFromString(testjson, "1.5")->GetAdaptiveCard();
+            const std::vector<uint8_t> snapshot = CardSnapshot::Save(*card);
+
+            const auto loaded = CardSnapshot::Load(snapshot.data(), snapshot.size(), "1.5");
+            Assert::AreEqual(card->Serialize(), loaded->GetAdaptiveCard()->Serialize());
+
+            // the elements are the types they were parsed as, with their parsed properties
+            const auto& body = loaded->GetAdaptiveCard()->GetBody();
+            Assert::AreEqual(4u, static_cast<unsigned int>(body.size()));
+            const auto title = std::dynamic_pointer_cast<TextBlock>(body[0]);
+            Assert::IsTrue(title != nullptr);
+            Assert::AreEqual("Hello"s, title->GetText());
+            Assert::IsTrue(title->GetTextSize() == TextSize::Large);
+            Assert::IsTrue(title->GetWrap());
+            Assert::IsTrue(std::dynamic_pointer_cast<Container>(body[1]) != nullptr);
+            Assert::IsTrue(std::dynamic_pointer_cast<UnknownElement>(body[2]) != nullptr);
+            Assert::AreEqual("Unknown"s, body[2]->GetElementTypeString());
+            Assert::IsTrue(card->GetBody()[0]->GetInternalId() != title->GetInternalId());
+
+            const auto showCard = std::dynamic_pointer_cast<ShowCardAction>(loaded->GetAdaptiveCard()->GetActions()[0]);
+            Assert::IsTrue(showCard != nullptr && showCard->GetCard() != nullptr);
+            Assert::AreEqual("shown"s, std::dynamic_pointer_cast<TextBlock>(showCard->GetCard()->GetBody()[0])->GetText());
+
+            // the version is checked as parsing checks it
+            const auto tooNew = CardSnapshot::Load(snapshot.data(), snapshot.size(), "1.0");
+            Assert::IsTrue(tooNew->GetAdaptiveCard()->GetBody().size() == 1);
+            Assert::IsTrue(tooNew->GetWarnings().front()->GetStatusCode() == WarningStatusCode::UnsupportedSchemaVersion);
+
+            // repeated strings are only stored once
+            const std::string asText = ParseUtil::JsonToString(card->SerializeToJsonValue());
+            Assert::IsTrue(snapshot.size() < asText.size() * 2);
+            size_t hellos = 0;
+            for (size_t found = 0; (found = std::string(snapshot.begin(), snapshot.end()).find("Hello", found)) != std::string::npos; ++found)
+            {
+                ++hellos;
+            }
+            Assert::AreEqual(1u, static_cast<unsigned int>(hellos));
+        }
+
+        TEST_METHOD(CardSnapshotCorpusTest)
+        {
+            unsigned int cardCount = 0;
+            for (const std::string version : {"v1.0", "v1.1", "v1.2", "v1.3", "v1.4", "v1.5", "v1.6"})
+            {
+                const std::filesystem::path directory = std::filesystem::path(ADAPTIVECARDS_SAMPLES_DIR) / version;
+                if (!std::filesystem::is_directory(directory))
+                {
+                    continue;
+                }
+
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+                {
+                    if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                    {
+                        continue;
+                    }
+
+                    std::shared_ptr<AdaptiveCard> card;
+                    try
+                    {
+                        card = AdaptiveCard::DeserializeFromFile(entry.path().string(), "1.6")->GetAdaptiveCard();
+                    }
+                    catch (const AdaptiveCardParseException&)
+                    {
+                        // some of the samples are meant not to parse
+                        continue;
+                    }
+
+                    const std::vector<uint8_t> snapshot = CardSnapshot::Save(*card);
+                    const auto loaded = CardSnapshot::Load(snapshot.data(), snapshot.size(), "1.6");
+                    Assert::AreEqual(card->Serialize(), loaded->GetAdaptiveCard()->Serialize(), entry.path().wstring().c_str());
+                    ++cardCount;
+                }
+            }
+            Assert::IsTrue(cardCount > 0);
+        }
+
+        TEST_METHOD(ParsedCardCacheTest)
+        {
+            const std::string testjson{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.0",
+                "lang": "not a language",
+                "body": [ { "type": "Fancy", "text": "Hello" }, { "type": "TextBlock", "text": "Hello" } ]
+            })"};
+
+            ParsedCardCache cache;
+            const auto first = cache.DeserializeFromString(testjson, "1.0");
+            const auto second = cache.DeserializeFromString(testjson, "1.0");
+            Assert::IsTrue(first == second);
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().hits));
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().misses));
+            Assert::AreEqual(1u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+
+            // hits report the card's warnings and set its language like a parse does
+            ParseContext hitContext;
+            cache.DeserializeFromString(testjson, "1.0", hitContext);
+            Assert::AreEqual(first->GetWarnings().size(), hitContext.warnings.size());
+            Assert::IsFalse(hitContext.warnings.empty());
+            Assert::AreEqual(std::string("not a language"), hitContext.GetLanguage());
+
+            // a different renderer version or set of custom parsers is a different card
+            Assert::IsTrue(cache.DeserializeFromString(testjson, "1.5") != first);
+
+            class FancyParser : public BaseCardElementParser
+            {
+            public:
+                std::shared_ptr<BaseCardElement> Deserialize(ParseContext& /*context*/, const Json::Value& value) override
+                {
+                    auto textBlock = std::make_shared<TextBlock>();
+                    textBlock->SetText(value["text"].asString());
+                    return textBlock;
+                }
+                std::shared_ptr<BaseCardElement> DeserializeFromString(ParseContext& context, const std::string& value) override
+                {
+                    return Deserialize(context, ParseUtil::GetJsonValueFromString(value));
+                }
+            };
+            auto elementRegistration = std::make_shared<ElementParserRegistration>();
+            elementRegistration->AddParser("Fancy", std::make_shared<FancyParser>());
+            ParseContext customContext(elementRegistration, std::make_shared<ActionParserRegistration>());
+            const auto custom = cache.DeserializeFromString(testjson, "1.0", customContext);
+            Assert::IsTrue(custom != first);
+            Assert::IsTrue(custom->GetAdaptiveCard()->GetBody().front()->GetElementType() == CardElementType::TextBlock);
+            Assert::AreEqual(3ui64, static_cast<unsigned long long>(cache.GetStatistics().misses));
+
+            // an equivalent registration finds the same entry
+            ParseContext sameCustomContext(elementRegistration, std::make_shared<ActionParserRegistration>());
+            Assert::IsTrue(cache.DeserializeFromString(testjson, "1.0", sameCustomContext) == custom);
+
+            // registrations are told apart by their changes, not by the addresses of their parsers, which can be reused
+            Assert::AreEqual(0u, static_cast<unsigned int>(ElementParserRegistration().GetFingerprint()));
+            const auto fancyParser = elementRegistration->GetParser("Fancy");
+            auto otherRegistration = std::make_shared<ElementParserRegistration>();
+            otherRegistration->AddParser("Fancy", fancyParser);
+            Assert::IsTrue(otherRegistration->GetFingerprint() != elementRegistration->GetFingerprint());
+            const size_t fingerprint = otherRegistration->GetFingerprint();
+            otherRegistration->RemoveParser("Fancy");
+            otherRegistration->AddParser("Fancy", fancyParser);
+            Assert::IsTrue(otherRegistration->GetFingerprint() != fingerprint);
+
+            // a hit doesn't report the statistics of the parse that filled the entry
+            const auto parseWithStatistics = [&cache, &testjson]() {
+                ParseContext statisticsContext;
+                statisticsContext.SetCollectStatistics(true);
+                return cache.DeserializeFromString(testjson, "1.2", statisticsContext);
+            };
+            Assert::IsTrue(parseWithStatistics()->GetStatistics() != nullptr);
+            Assert::IsTrue(parseWithStatistics()->GetStatistics() == nullptr);
+
+            // failed parses aren't cached
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { cache.DeserializeFromString("not json", "1.0"); });
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { cache.DeserializeFromString("not json", "1.0"); });
+            Assert::AreEqual(4u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+
+            // least recently used entries go first when the budget shrinks
+            const size_t bytes = cache.GetStatistics().byteCount;
+            cache.DeserializeFromString(testjson, "1.0");
+            cache.SetMaxBytes(bytes - 1);
+            Assert::AreEqual(1ui64, static_cast<unsigned long long>(cache.GetStatistics().evictions));
+            Assert::IsTrue(cache.DeserializeFromString(testjson, "1.0") == first);
+            Assert::IsTrue(cache.GetStatistics().byteCount <= bytes - 1);
+
+            cache.SetMaxBytes(0);
+            Assert::AreEqual(0u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+            Assert::AreEqual(0u, static_cast<unsigned int>(cache.GetStatistics().byteCount));
+            Assert::IsTrue(cache.DeserializeFromString(testjson, "1.0") != first);
+
+            // concurrent lookups of the same few cards
+            cache.SetMaxBytes(ParsedCardCache::DefaultMaxBytes);
+            cache.Clear();
+            const auto before = cache.GetStatistics();
+            std::vector<std::thread> threads;
+            std::vector<std::string> serialized(8);
+            for (size_t i = 0; i < serialized.size(); ++i)
+            {
+                threads.emplace_back([&cache, &testjson, &serialized, i]() {
+                    for (int iteration = 0; iteration < 50; ++iteration)
+                    {
+                        serialized[i] = cache.DeserializeFromString(testjson, (iteration % 2) ? "1.0" : "1.5")->GetAdaptiveCard()->Serialize();
+                    }
+                });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            Assert::AreEqual(2u, static_cast<unsigned int>(cache.GetStatistics().entryCount));
+            const auto after = cache.GetStatistics();
+            Assert::AreEqual(400ui64, static_cast<unsigned long long>(after.hits + after.misses - before.hits - before.misses));
+            for (const auto& result : serialized)
+            {
+                Assert::AreEqual(first->GetAdaptiveCard()->Serialize(), result);
+            }
+        }
+
+        TEST_METHOD(ImmutableCardTest)
+        {
+            const std::string testjson{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [
+                    { "type": "TextBlock", "id": "title", "text": "Hello" },
+                    { "type": "Container", "id": "outer", "items": [
+                        { "type": "ColumnSet", "columns": [ { "type": "Column", "id": "column", "items": [
+                            { "type": "Input.Text", "id": "name" },
+                            { "type": "Input.Number", "id": "age" }
+                        ] } ] }
+                    ] },
+                    { "type": "Container", "id": "sibling", "items": [ { "type": "TextBlock", "text": "unchanged" } ] }
+                ],
+                "actions": [ { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "Input.Toggle", "id": "agree", "title": "Agree" } ] } } ]
+            })"};
+
+            const auto parsed = AdaptiveCard::DeserializeFromString(testjson, "1.5")->GetAdaptiveCard();
+            const std::string original = parsed->Serialize();
+            const ImmutableCard card(parsed);
+
+            const ImmutableCard named = card.WithInputValue("name", "Ada");
+            const ImmutableCard variant = named.WithInputValue("age", "36").WithIsVisible("title", false).WithInputValue("agree", "true");
+
+            // the originals are untouched
+            Assert::AreEqual(original, parsed->Serialize());
+            Assert::AreEqual(original, card.GetCard()->Serialize());
+
+            const auto edited = variant.GetCard();
+            const auto outer = std::static_pointer_cast<Container>(edited->GetBody()[1]);
+            const auto column = std::static_pointer_cast<ColumnSet>(outer->GetItems()[0])->GetColumns()[0];
+            Assert::AreEqual(std::string("Ada"), std::static_pointer_cast<TextInput>(column->GetItems()[0])->GetValue());
+            Assert::AreEqual(36.0, *std::static_pointer_cast<NumberInput>(column->GetItems()[1])->GetValue());
+            Assert::IsFalse(edited->GetBody()[0]->GetIsVisible());
+            const auto showCard = std::static_pointer_cast<ShowCardAction>(edited->GetActions()[0]);
+            Assert::AreEqual(std::string("true"), std::static_pointer_cast<ToggleInput>(showCard->GetCard()->GetBody()[0])->GetValue());
+
+            // only the path down to each edit was copied
+            Assert::IsTrue(edited->GetBody()[2] == parsed->GetBody()[2]);
+            Assert::IsTrue(named.GetCard()->GetBody()[0] == parsed->GetBody()[0]);
+            Assert::IsTrue(named.GetCard()->GetActions()[0] == parsed->GetActions()[0]);
+            Assert::IsTrue(named.GetCard()->GetBody()[1] != parsed->GetBody()[1]);
+
+            // a replacement must fit where it goes
+            auto replacement = std::make_shared<TextBlock>();
+            replacement->SetText("replaced");
+            Assert::AreEqual(std::string("replaced"),
+                             std::static_pointer_cast<TextBlock>(card.WithElement("title", replacement).GetCard()->GetBody()[0])->GetText());
+            Assert::ExpectException<std::invalid_argument>([&]() { card.WithElement("column", replacement); });
+
+            Assert::ExpectException<std::invalid_argument>([&]() { card.WithInputValue("missing", "value"); });
+            Assert::ExpectException<std::invalid_argument>([&]() { card.WithInputValue("title", "value"); });
+            Assert::ExpectException<std::invalid_argument>([&]() { card.WithInputValue("age", "not a number"); });
+        }
+
+        TEST_METHOD(ImmutableCardWithEditTest)
+        {
+            const auto parsed = AdaptiveCard::DeserializeFromString(R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [
+                    { "type": "TextBlock", "id": "title", "text": "Hello" },
+                    { "type": "RichTextBlock", "id": "rich", "inlines": [
+                        { "type": "TextRun", "text": "run", "selectAction": { "type": "Action.OpenUrl", "url": "https://adaptivecards.io" } }
+                    ] },
+                    { "type": "FactSet", "id": "facts", "facts": [ { "title": "Name", "value": "Ada" } ] },
+                    { "type": "Container", "id": "outer", "selectAction": { "type": "Action.ToggleVisibility", "targetElements": [ "title" ] },
+                      "items": [ { "type": "TextBlock", "text": "inner" } ] }
+                ]
+            })", "1.5")->GetAdaptiveCard();
+            const std::string original = parsed->Serialize();
+            const ImmutableCard card(parsed);
+
+            const ImmutableCard edited = card.WithEdit("title", [](BaseCardElement& element) { static_cast<TextBlock&>(element).SetText("Goodbye"); })
+                                             .WithEdit("rich", [](BaseCardElement& element) {
+                                                 const auto run = std::static_pointer_cast<TextRun>(static_cast<RichTextBlock&>(element).GetInlines()[0]);
+                                                 run->SetText("edited run");
+                                                 std::static_pointer_cast<OpenUrlAction>(run->GetSelectAction())->SetUrl("https://example.com");
+                                             })
+                                             .WithEdit("facts", [](BaseCardElement& element) {
+                                                 static_cast<FactSet&>(element).GetFacts()[0]->SetValue("Grace");
+                                             })
+                                             .WithEdit("outer", [](BaseCardElement& element) {
+                                                 const auto action = std::static_pointer_cast<ToggleVisibilityAction>(
+                                                     static_cast<Container&>(element).GetSelectAction());
+                                                 action->GetTargetElements()[0]->SetIsVisible(IsVisible::IsVisibleFalse);
+                                             });
+
+            // edits through an element's sub-objects don't reach the original
+            Assert::AreEqual(original, parsed->Serialize());
+            Assert::AreEqual(std::string("Hello"), std::static_pointer_cast<TextBlock>(parsed->GetBody()[0])->GetText());
+
+            const auto body = edited.GetCard()->GetBody();
+            Assert::AreEqual(std::string("Goodbye"), std::static_pointer_cast<TextBlock>(body[0])->GetText());
+            const auto run = std::static_pointer_cast<TextRun>(std::static_pointer_cast<RichTextBlock>(body[1])->GetInlines()[0]);
+            Assert::AreEqual(std::string("edited run"), run->GetText());
+            Assert::AreEqual(std::string("https://example.com"), std::static_pointer_cast<OpenUrlAction>(run->GetSelectAction())->GetUrl());
+            Assert::AreEqual(std::string("Grace"), std::static_pointer_cast<FactSet>(body[2])->GetFacts()[0]->GetValue());
+
+            // children are still shared with the original
+            Assert::IsTrue(std::static_pointer_cast<Container>(body[3])->GetItems()[0] ==
+                           std::static_pointer_cast<Container>(parsed->GetBody()[3])->GetItems()[0]);
+
+            // a host's subclass of a built-in container can't be copied, so nothing below it can be edited
+            class HostContainer : public Container
+            {
+            public:
+                HostContainer()
+                {
+                    SetTypeString("HostContainer");
+                }
+            };
+            auto hostContainer = std::make_shared<HostContainer>();
+            auto input = std::make_shared<TextInput>();
+            input->SetId("name");
+            hostContainer->GetItems().push_back(input);
+            auto hostCard = std::make_shared<AdaptiveCard>();
+            hostCard->GetBody().push_back(hostContainer);
+            try
+            {
+                ImmutableCard(hostCard).WithInputValue("name", "Ada");
+                Assert::Fail(L"Expected std::invalid_argument");
+            }
+            catch (const std::invalid_argument& e)
+            {
+                Assert::AreEqual(std::string("Can't edit 'name' below custom element 'HostContainer'"), std::string(e.what()));
+            }
+        }
+
+        TEST_METHOD(CardPatchTest)
+        {
+            const auto from = AdaptiveCard::DeserializeFromString(R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [
+                    { "type": "TextBlock", "id": "first", "text": "one" },
+                    { "type": "Input.Text", "id": "name", "placeholder": "Name" },
+                    { "type": "TextBlock", "text": "no id" },
+                    { "type": "Image", "url": "https://adaptivecards.io/removed.png" }
+                ],
+                "actions": [ { "type": "Action.Submit", "title": "Send" } ]
+            })", "1.5")->GetAdaptiveCard();
+            const auto to = AdaptiveCard::DeserializeFromString(R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [
+                    { "type": "Input.Text", "id": "name", "placeholder": "Name" },
+                    { "type": "TextBlock", "id": "first", "text": "uno" },
+                    { "type": "TextBlock", "text": "no id", "wrap": true },
+                    { "type": "Input.Toggle", "id": "added", "title": "New" }
+                ],
+                "actions": [ { "type": "Action.Submit", "title": "Send" } ]
+            })", "1.5")->GetAdaptiveCard();
+
+            Assert::IsTrue(CardPatch::Diff(*from, *from).IsEmpty());
+
+            const CardPatch patch = CardPatch::Diff(*from, *to);
+            Assert::AreEqual(std::string(R"([)"
+                                         R"({"op":"remove","path":"/body/3"},)"
+                                         R"({"from":"/body/1","op":"move","path":"/body/0"},)"
+                                         R"({"op":"add","path":"/body/3","value":{"id":"added","title":"New","type":"Input.Toggle"}},)"
+                                         R"({"op":"replace","path":"/body/1/text","value":"uno"},)"
+                                         R"({"op":"add","path":"/body/2/wrap","value":true})"
+                                         "]\n"),
+                             patch.Serialize());
+
+            Assert::AreEqual(to->Serialize(), patch.Apply(*from, "1.5")->GetAdaptiveCard()->Serialize());
+            Assert::AreEqual(to->Serialize(), CardPatch::FromJsonPatchString(patch.Serialize()).Apply(*from, "1.5")->GetAdaptiveCard()->Serialize());
+
+            // JSON Pointer escaping
+            Json::Value json = ParseUtil::GetJsonValueFromString(R"({ "a/b": { "c~d": [ 1, 2 ] } })");
+            const CardPatch escaped = CardPatch::Diff(json, ParseUtil::GetJsonValueFromString(R"({ "a/b": { "c~d": [ 1, 3 ] } })"));
+            Assert::AreEqual(std::string("/a~1b/c~0d"), escaped.GetOperations().front().path);
+            escaped.Apply(json);
+            Assert::AreEqual(3, json["a/b"]["c~d"][1].asInt());
+
+            const auto expectInvalid = [&from](const std::string& patchJson) {
+                try
+                {
+                    CardPatch::FromJsonPatchString(patchJson).Apply(*from, "1.5");
+                    Assert::Fail(L"Expected AdaptiveCardParseException");
+                }
+                catch (const AdaptiveCardParseException& e)
+                {
+                    Assert::IsTrue(e.GetStatusCode() == ErrorStatusCode::InvalidJson);
+                }
+            };
+            expectInvalid(R"({ "op": "remove", "path": "/body/0" })");
+            expectInvalid(R"([ { "op": "test", "path": "/body/0", "value": 1 } ])");
+            expectInvalid(R"([ { "op": "remove", "path": "/body/4" } ])");
+            expectInvalid(R"([ { "op": "remove", "path": "/body/01" } ])");
+            expectInvalid(R"([ { "op": "replace", "path": "/missing", "value": 1 } ])");
+            expectInvalid(R"([ { "op": "move", "from": "/body", "path": "/body/0" } ])");
+            expectInvalid(R"([ 1 ])");
+            expectInvalid(R"([ { "op": "add", "path": "/body/\u0661" , "value": 1 } ])");
+
+            // paths through or into an empty array, which must be left as it was
+            Json::Value withEmpty = ParseUtil::GetJsonValueFromString(R"({ "list": [] })");
+            for (const char* patchJson : {R"([ { "op": "add", "path": "/list/-/x", "value": 1 } ])",
+                                          R"([ { "op": "add", "path": "/list/0/x", "value": 1 } ])",
+                                          R"([ { "op": "replace", "path": "/list/0", "value": 1 } ])",
+                                          R"([ { "op": "remove", "path": "/list/-" } ])"})
+            {
+                Assert::ExpectException<AdaptiveCardParseException>([&]() { CardPatch::FromJsonPatchString(patchJson).Apply(withEmpty); });
+                Assert::AreEqual(0u, withEmpty["list"].size());
+            }
+        }
+
+        TEST_METHOD(ElementIndexTest)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [
+                    { "type": "Container", "id": "outer", "selectAction": { "type": "Action.Submit", "id": "select" }, "items": [
+                        { "type": "Input.Text", "id": "name" },
+                        { "type": "Fancy", "id": "fancy", "fallback": { "type": "TextBlock", "id": "fancy", "text": "fallback" } }
+                    ] },
+                    { "type": "Input.Number", "id": "age" }
+                ],
+                "actions": [ { "type": "Action.ShowCard", "id": "more", "card": { "type": "AdaptiveCard", "body": [ { "type": "Input.Toggle", "id": "agree", "title": "Agree" } ] } } ]
+            })", "1.5")->GetAdaptiveCard();
+
+            const ElementIndex index(*card);
+
+            const auto& name = index.Find("name");
+            Assert::AreEqual(1u, static_cast<unsigned int>(name.size()));
+            Assert::AreEqual(std::string("/body/0/items/0"), name[0].path);
+            Assert::IsTrue(name[0].parent == card->GetBody()[0]);
+            Assert::IsTrue(name[0].showCard == nullptr);
+            Assert::IsTrue(index.GetElement("outer") == card->GetBody()[0]);
+            Assert::IsTrue(index.Find("outer")[0].parent == nullptr);
+
+            Assert::AreEqual(std::string("/body/0/selectAction"), index.Find("select")[0].path);
+
+            // fallback content shares its parent's id
+            const auto& fancy = index.Find("fancy");
+            Assert::AreEqual(2u, static_cast<unsigned int>(fancy.size()));
+            Assert::IsFalse(fancy[0].isFallback);
+            Assert::IsTrue(fancy[1].isFallback);
+            Assert::AreEqual(std::string("/body/0/items/1/fallback"), fancy[1].path);
+            Assert::IsTrue(index.GetElement("fancy") == fancy[0].element);
+
+            const auto& agree = index.Find("agree");
+            Assert::AreEqual(std::string("/actions/0/card/body/0"), agree[0].path);
+            Assert::IsTrue(agree[0].showCard == std::static_pointer_cast<ShowCardAction>(card->GetActions()[0])->GetCard());
+
+            const auto& inputs = index.GetInputs();
+            Assert::AreEqual(3u, static_cast<unsigned int>(inputs.size()));
+            Assert::AreEqual(std::string("name"), inputs[0].element->GetId());
+            Assert::AreEqual(std::string("age"), inputs[1].element->GetId());
+            Assert::AreEqual(std::string("agree"), inputs[2].element->GetId());
+
+            Assert::IsTrue(index.Find("missing").empty());
+            Assert::IsTrue(index.GetElement("missing") == nullptr);
+
+            // an index is a snapshot of the card when it was built
+            auto added = std::make_shared<TextInput>();
+            added->SetId("added");
+            card->GetBody().push_back(added);
+            Assert::IsTrue(index.GetElement("added") == nullptr);
+            const ElementIndex rebuilt(*card);
+            Assert::IsTrue(rebuilt.GetElement("added") == added);
+            Assert::AreEqual(4u, static_cast<unsigned int>(rebuilt.GetInputs().size()));
+        }
+
+        TEST_METHOD(CardSnapshotCorruptTest)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(
+                R"({ "type": "AdaptiveCard", "version": "1.0", "body": [ { "type": "TextBlock", "text": "Hello" } ] })", "1.0")->GetAdaptiveCard();
+            const std::vector<uint8_t> snapshot = CardSnapshot::Save(*card);
+
+            const auto expectInvalid = [](const std::vector<uint8_t>& data) {
+                try
+                {
+                    CardSnapshot::Load(data.data(), data.size(), "1.0");
+                    Assert::Fail(L"Expected AdaptiveCardParseException");
+                }
+                catch (const AdaptiveCardParseException& e)
+                {
+                    Assert::IsTrue(e.GetStatusCode() == ErrorStatusCode::InvalidJson);
+                }
+            };
+
+            expectInvalid({});
+            expectInvalid(std::vector<uint8_t>(snapshot.begin(), snapshot.end() - 1));
+
+            std::vector<uint8_t> badMagic = snapshot;
+            badMagic[0] = 'X';
+            expectInvalid(badMagic);
+
+            std::vector<uint8_t> badVersion = snapshot;
+            badVersion[4] = CardSnapshot::FormatVersion + 1;
+            expectInvalid(badVersion);
+
+            // every single-byte corruption past the header either still loads or is reported as invalid; none of
+            // them may read out of bounds or loop
+            for (size_t i = 24; i < snapshot.size(); ++i)
+            {
+                for (const uint8_t value : {0x00, 0x7f, 0xff})
+                {
+                    std::vector<uint8_t> corrupt = snapshot;
+                    corrupt[i] = value;
+                    try
+                    {
+                        CardSnapshot::Load(corrupt.data(), corrupt.size(), "1.0");
+                    }
+                    catch (const AdaptiveCardParseException&)
+                    {
+                    }
+                }
+            }
+        }
+
+        TEST_METHOD(LazyParsingTest)
+        {
+            auto parse = [](const std::string& json, bool lazy) {
+                ParseContext context;
+                context.SetUseLazyParsing(lazy);
+                return AdaptiveCard::DeserializeFromString(json, "1.5", context)->GetAdaptiveCard();
+            };
+
+            const std::string validCard{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [
+                    { "type": "Fancy", "id": "fancy", "fallback": { "type": "Input.Text", "id": "fancy", "placeholder": "fallback" } }
+                ],
+                "actions": [ { "type": "Action.ShowCard", "title": "More", "card": { "type": "AdaptiveCard", "body": [
+                    { "type": "Container", "items": [ { "type": "Input.Toggle", "id": "agree", "title": "Agree" } ] }
+                ] } } ]
+            })" };
+
+            const auto eager = parse(validCard, false);
+            const auto lazy = parse(validCard, true);
+            Assert::AreEqual(eager->Serialize(), lazy->Serialize());
+
+            const auto showCard = std::static_pointer_cast<ShowCardAction>(lazy->GetActions()[0]);
+            Assert::IsTrue(showCard->GetCard() == showCard->GetCard());
+            Assert::AreEqual(std::string("1.5"), showCard->GetCard()->GetVersion());
+            Assert::AreEqual(std::string("agree"),
+                             std::static_pointer_cast<Container>(showCard->GetCard()->GetBody()[0])->GetItems()[0]->GetId());
+            Assert::IsTrue(lazy->GetBody()[0]->GetFallbackType() == FallbackType::Content);
+            Assert::AreEqual(std::string("fallback"),
+                             std::static_pointer_cast<TextInput>(lazy->GetBody()[0]->GetFallbackContent())->GetPlaceholder());
+
+            // the index parses deferred parts, so it covers them
+            const auto unparsed = parse(validCard, true);
+            const ElementIndex index(*unparsed);
+            Assert::AreEqual(2u, static_cast<unsigned int>(index.Find("fancy").size()));
+            Assert::AreEqual(std::string("/actions/0/card/body/0/items/0"), index.Find("agree")[0].path);
+
+            // ids in the deferred parts still collide with the rest of the card when it's parsed
+            const std::string collision{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [ { "type": "TextBlock", "id": "agree", "text": "oops" } ],
+                "actions": [ { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [
+                    { "type": "Container", "items": [ { "type": "Input.Toggle", "id": "agree", "title": "Agree" } ] }
+                ] } } ]
+            })" };
+            try
+            {
+                parse(collision, true);
+                Assert::Fail(L"Expected AdaptiveCardParseException");
+            }
+            catch (const AdaptiveCardParseException& e)
+            {
+                Assert::IsTrue(e.GetStatusCode() == ErrorStatusCode::IdCollision);
+            }
+
+            // other errors in the deferred parts are reported when they're first used
+            const std::string invalidCard{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "body": [ { "type": "Fancy", "fallback": { "type": "Image" } } ],
+                "actions": [ { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "Image" } ] } } ]
+            })" };
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { parse(invalidCard, false); });
+            const auto invalid = parse(invalidCard, true);
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { ElementIndex{*invalid}; });
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { invalid->GetBody()[0]->GetFallbackContent(); });
+            Assert::ExpectException<AdaptiveCardParseException>(
+                [&]() { std::static_pointer_cast<ShowCardAction>(invalid->GetActions()[0])->GetCard(); });
+        }
+
+        TEST_METHOD(ParseStatisticsTest)
+        {
+            const std::string cardJson{ R"({
+                "type": "AdaptiveCard",
+                "version": "1.5",
+                "custom": "kept",
+                "body": [
+                    { "type": "TextBlock", "id": "title", "text": "Title" },
+                    { "type": "Container", "minHeight": "99999999999px", "items": [ { "type": "TextBlock", "text": "one" }, { "type": "TextBlock", "text": "two" } ] },
+                    { "type": "Fancy", "fallback": { "type": "TextBlock", "text": "fallback" } }
+                ],
+                "actions": [
+                    { "type": "Action.Submit", "data": { "x": 1 } },
+                    { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "text": "more" } ] } }
+                ]
+            })" };
+
+            Assert::IsTrue(AdaptiveCard::DeserializeFromString(cardJson, "1.5")->GetStatistics() == nullptr);
+
+            ParseContext context;
+            size_t counterCalls = 0;
+            context.SetCollectStatistics(true);
+            context.SetAllocationCounter([&counterCalls]() {
+                ++counterCalls;
+                return ParseStatistics::AllocationCounts{counterCalls * 10, counterCalls * 100};
+            });
+
+            const auto result = AdaptiveCard::DeserializeFromString(cardJson, "1.5", context);
+            const auto statistics = result->GetStatistics();
+            Assert::IsTrue(statistics != nullptr);
+
+            Assert::AreEqual<size_t>(7, statistics->elements);
+            Assert::AreEqual<size_t>(5, statistics->elementsByType.at("TextBlock"));
+            Assert::AreEqual<size_t>(1, statistics->elementsByType.at("Container"));
+            Assert::AreEqual<size_t>(1, statistics->elementsByType.at("Fancy"));
+            Assert::AreEqual<size_t>(2, statistics->actions);
+            Assert::AreEqual<size_t>(1, statistics->actionsByType.at("Action.ShowCard"));
+
+            // the unknown element, the submit data, and the card's unknown property
+            Assert::AreEqual<size_t>(3, statistics->jsonValueCopies);
+            // fallback content sits below both its element and the element's fallback marker
+            Assert::AreEqual<size_t>(3, statistics->maxDepth);
+            // the out of range minHeight is caught and reported as a warning
+            Assert::AreEqual<size_t>(1, statistics->exceptionsCaught);
+            Assert::AreEqual(result->GetWarnings().size(), statistics->warnings);
+            Assert::AreEqual<size_t>(10, statistics->allocations);
+            Assert::AreEqual<size_t>(100, statistics->allocatedBytes);
+            Assert::IsTrue(statistics->totalTime >= statistics->jsonParseTime + statistics->buildTime - std::chrono::nanoseconds(1));
+
+            // a later parse gets its own statistics
+            const auto smaller = AdaptiveCard::DeserializeFromString(R"({ "type": "AdaptiveCard", "version": "1.5" })", "1.5", context);
+            Assert::AreEqual<size_t>(0, smaller->GetStatistics()->elements);
+            Assert::AreEqual<size_t>(7, statistics->elements);
+
+            // siblings parsed concurrently add up to the same counts
+            ParseContext parallelContext;
+            parallelContext.SetCollectStatistics(true);
+            parallelContext.SetParallelParseThreshold(2);
+            const auto parallel = AdaptiveCard::DeserializeFromString(cardJson, "1.5", parallelContext)->GetStatistics();
+            Assert::IsTrue(parallel->elementsByType == statistics->elementsByType);
+            Assert::IsTrue(parallel->actionsByType == statistics->actionsByType);
+            Assert::AreEqual(statistics->jsonValueCopies, parallel->jsonValueCopies);
+            Assert::AreEqual(statistics->exceptionsCaught, parallel->exceptionsCaught);
+            Assert::AreEqual(statistics->maxDepth, parallel->maxDepth);
+        }
     };
 }
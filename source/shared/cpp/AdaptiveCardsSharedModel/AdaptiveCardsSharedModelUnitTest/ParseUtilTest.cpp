@@ -183,6 +183,22 @@ namespace AdaptiveCardsSharedModelUnitTest
             Assert::AreEqual(arrayRet[1].asCString(), "thing2");
         }
 
+        TEST_METHOD(GetJsonValueReturnsReferenceTests)
+        {
+            auto jsonObj = s_GetJsonObjectWithAccent("[\"thing1\", { \"nested\": [ 1, 2, 3 ] }]"s);
+
+            // lookups hand out the value stored in the json, not a copy of it
+            const Json::Value* found = ParseUtil::FindJsonValue(jsonObj, AdaptiveCardSchemaKey::Accent);
+            Assert::IsTrue(found == &jsonObj["accent"]);
+            Assert::IsTrue(&ParseUtil::GetJsonValue(jsonObj, AdaptiveCardSchemaKey::Accent) == found);
+            Assert::IsTrue(&ParseUtil::GetArray(jsonObj, AdaptiveCardSchemaKey::Accent) == found);
+            Assert::IsTrue(&ParseUtil::ExtractJsonValue(jsonObj, AdaptiveCardSchemaKey::Accent) == found);
+
+            // missing properties resolve to null
+            Assert::IsTrue(ParseUtil::FindJsonValue(jsonObj, AdaptiveCardSchemaKey::Actions) == nullptr);
+            Assert::IsTrue(ParseUtil::GetJsonValue(jsonObj, AdaptiveCardSchemaKey::Actions).isNull());
+        }
+
         TEST_METHOD(GetBoolTests)
         {
             auto jsonObj = s_GetValidJsonObject();
@@ -271,5 +287,59 @@ namespace AdaptiveCardsSharedModelUnitTest
             auto actualString = ParseUtil::GetJsonString(jsonObjWithValidType, AdaptiveCardSchemaKey::Accent, true);
             Assert::AreEqual(actualString, "\"Valid\"\n"s);
         }
+
+        TEST_METHOD(JsonToStringMatchesStreamWriterTests)
+        {
+            // what JsonToString used to do
+            auto writeWithStreamWriter = [](const Json::Value& json) {
+                Json::StreamWriterBuilder builder;
+                builder["commentStyle"] = "None";
+                builder["indentation"] = "";
+                std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+                std::ostringstream outStream;
+                writer->write(json, &outStream);
+                outStream << std::endl;
+                return outStream.str();
+            };
+
+            Json::Value json = s_GetJsonObject(R"({
+                "type": "AdaptiveCard",
+                "body": [ { "type": "TextBlock", "text": "Hello \"world\"\n\ttab \\ slash / \u0001" } ],
+                "emptyArray": [], "emptyObject": {}, "nested": [ [ [] ], { "a": [ {} ] } ],
+                "numbers": [ 0, -1, 42, 4294967296, -9223372036854775808, 18446744073709551615, 0.1, -2.5, 1e300, 3.0 ]
+            })");
+
+            // strings that exercise the UTF-8 handling: non-ASCII only, mixed, outside the BMP, and malformed
+            json["nonAscii"] = "\xe6\x97\xa5\xe6\x9c\xac";
+            json["mixed"] = "caf\xc3\xa9 \xf0\x9f\x98\x80";
+            json["malformed"] = "bad \xc3 \xed\xa0\x80 \xff end";
+            json["\xc3\xa9key"] = true;
+            json["embeddedNul"] = std::string("a\0b", 3);
+            json["empty"] = "";
+            json["null"] = Json::Value();
+            json["false"] = false;
+            json["minInt"] = Json::Value(std::numeric_limits<Json::Int64>::min());
+            json["infinity"] = std::numeric_limits<double>::infinity();
+            json["negativeInfinity"] = -std::numeric_limits<double>::infinity();
+            json["nan"] = std::numeric_limits<double>::quiet_NaN();
+            json["tiny"] = 5e-324;
+            json["negativeZero"] = -0.0;
+
+            Json::Value longArray(Json::arrayValue);
+            for (int i = 0; i < 40; ++i)
+            {
+                longArray.append(i * 1000);
+            }
+            json["longArray"] = longArray;
+
+            Assert::AreEqual(writeWithStreamWriter(json), ParseUtil::JsonToString(json));
+            Assert::AreEqual(writeWithStreamWriter(Json::Value("top level")), ParseUtil::JsonToString(Json::Value("top level")));
+            Assert::AreEqual(writeWithStreamWriter(Json::Value()), ParseUtil::JsonToString(Json::Value()));
+
+            // the buffer is replaced rather than appended to
+            std::string buffer{"previous contents"};
+            ParseUtil::JsonToString(json, buffer);
+            Assert::AreEqual(writeWithStreamWriter(json), buffer);
+        }
     };
 }
@@ -121,5 +121,31 @@ namespace AdaptiveCardsSharedModelUnitTest
             Assert::ExpectException<AdaptiveCardParseException>([&]() { elementParser.RemoveParser(CardElementTypeToString(CardElementType::Container)); });
             Assert::IsTrue((bool)elementParser.GetParser(CardElementTypeToString(CardElementType::Container)));
         }
+
+        TEST_METHOD(ParserWrappersAreReusedTests)
+        {
+            ActionParserRegistration actionParser;
+            ElementParserRegistration elementParser;
+
+            // handing out a parser doesn't wrap it again, regardless of the case used to look it up
+            const auto textBlockParser = elementParser.GetParser("TextBlock");
+            Assert::IsTrue(textBlockParser == elementParser.GetParser("TextBlock"));
+            Assert::IsTrue(textBlockParser == elementParser.GetParser("textblock"));
+            Assert::IsTrue(nullptr != std::dynamic_pointer_cast<BaseCardElementParserWrapper>(textBlockParser));
+
+            const auto submitParser = actionParser.GetParser("Action.Submit");
+            Assert::IsTrue(submitParser == actionParser.GetParser("Action.Submit"));
+            Assert::IsTrue(nullptr != std::dynamic_pointer_cast<ActionElementParserWrapper>(submitParser));
+
+            // registering a new parser for a type replaces its wrapper
+            const auto customParser = std::make_shared<BaseCardElementParserWrapper>(textBlockParser);
+            elementParser.AddParser("Custom", customParser);
+            const auto customWrapper = elementParser.GetParser("Custom");
+            Assert::IsTrue(customWrapper == elementParser.GetParser("Custom"));
+
+            elementParser.AddParser("Custom", customParser);
+            Assert::IsTrue(customWrapper != elementParser.GetParser("Custom"));
+            Assert::IsTrue(customParser == std::static_pointer_cast<BaseCardElementParserWrapper>(elementParser.GetParser("Custom"))->GetActualParser());
+        }
     };
 }
@@ -27,6 +27,12 @@ std::shared_ptr<BaseActionElement> ActionElementParserWrapper::Deserialize(Parse
     std::shared_ptr<BaseActionElement> element = m_parser->Deserialize(context, value);
     context.PopElement();
 
+    ParseStatistics* statistics = context.GetStatistics();
+    if (statistics && element)
+    {
+        statistics->CountAction(element->GetElementTypeString());
+    }
+
     return element;
 }
 
@@ -35,7 +41,9 @@ std::shared_ptr<BaseActionElement> ActionElementParserWrapper::DeserializeFromSt
     return Deserialize(context, ParseUtil::GetJsonValueFromString(value));
 }
 
-ActionParserRegistration::ActionParserRegistration()
+std::atomic<size_t> ActionParserRegistration::s_nextGeneration{1};
+
+ActionParserRegistration::ActionParserRegistration() : m_generation(0)
 {
     m_knownElements.insert({
         ActionTypeToString(ActionType::Execute),
@@ -53,6 +61,12 @@ ActionParserRegistration::ActionParserRegistration()
          {ActionTypeToString(ActionType::Submit), std::make_shared<SubmitActionParser>()},
          {ActionTypeToString(ActionType::ToggleVisibility), std::make_shared<ToggleVisibilityActionParser>()},
          {ActionTypeToString(ActionType::UnknownAction), std::make_shared<UnknownActionParser>()}});
+
+    // Parsers are stored already wrapped (see GetParser) so that handing one out doesn't allocate
+    for (auto& parser : m_cardElementParsers)
+    {
+        parser.second = std::make_shared<ActionElementParserWrapper>(parser.second);
+    }
 }
 
 void ActionParserRegistration::AddParser(std::string const& elementType, std::shared_ptr<ActionElementParser> parser)
@@ -60,7 +74,8 @@ void ActionParserRegistration::AddParser(std::string const& elementType, std::sh
     // make sure caller isn't attempting to overwrite a known element's parser
     if (m_knownElements.find(elementType) == m_knownElements.end())
     {
-        ActionParserRegistration::m_cardElementParsers[elementType] = parser;
+        ActionParserRegistration::m_cardElementParsers[elementType] = std::make_shared<ActionElementParserWrapper>(parser);
+        m_generation = s_nextGeneration++;
     }
     else
     {
@@ -75,6 +90,7 @@ void ActionParserRegistration::RemoveParser(std::string const& elementType)
     if (m_knownElements.find(elementType) == m_knownElements.end())
     {
         ActionParserRegistration::m_cardElementParsers.erase(elementType);
+        m_generation = s_nextGeneration++;
     }
     else
     {
@@ -93,12 +109,18 @@ std::shared_ptr<ActionElementParser> ActionParserRegistration::GetParser(std::st
         // mean having to explain all of this to custom element parser implementors. Instead, we wrap every parser
         // we hand out with a helper class that performs the push/pop on behalf of the element parser. For more
         // details, refer to the giant comment on ID collision detection in ParseContext.cpp.
-        std::shared_ptr<ActionElementParser> wrappedParser = std::make_shared<ActionElementParserWrapper>(parser->second);
-        return wrappedParser;
+        //
+        // The wrappers are stateless, so each parser is wrapped once, when it's registered, and shared from then on.
+        return parser->second;
     }
     else
     {
         return std::shared_ptr<ActionElementParser>(nullptr);
     }
 }
+
+size_t ActionParserRegistration::GetFingerprint() const
+{
+    return m_generation;
+}
 } // namespace AdaptiveCards
@@ -64,5 +64,7 @@ std::shared_ptr<BaseCardElement> ActionSetParser::DeserializeFromString(ParseCon
 
 void ActionSet::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions));
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions)});
+    SetKnownProperties(knownProperties);
 }
@@ -104,9 +104,9 @@ Json::Value AuthCardButton::SerializeToJsonValue() const
     return root;
 }
 
-std::shared_ptr<AuthCardButton> AuthCardButton::Deserialize(ParseContext&, const Json::Value& json)
+std::shared_ptr<AuthCardButton> AuthCardButton::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<AuthCardButton> button = std::make_shared<AuthCardButton>();
+    std::shared_ptr<AuthCardButton> button = context.MakeShared<AuthCardButton>();
 
     button->SetType(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Type));
     button->SetTitle(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Title));
@@ -139,13 +139,14 @@ Json::Value BaseActionElement::SerializeToJsonValue() const
 
 void BaseActionElement::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IconUrl),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Mode),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Tooltip),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsEnabled)});
+    SetKnownProperties(knownProperties);
 }
 
 void BaseActionElement::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
@@ -171,7 +172,7 @@ std::shared_ptr<BaseActionElement> BaseActionElement::DeserializeBasePropertiesF
 
 std::shared_ptr<BaseActionElement> BaseActionElement::DeserializeBaseProperties(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<BaseActionElement> baseActionElement = std::make_shared<BaseActionElement>();
+    std::shared_ptr<BaseActionElement> baseActionElement = context.MakeShared<BaseActionElement>();
     DeserializeBaseProperties(context, json, baseActionElement);
     return baseActionElement;
 }
@@ -184,7 +185,7 @@ void BaseActionElement::DeserializeBaseProperties(ParseContext& context, const J
     element->SetTitle(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Title));
     element->SetIconUrl(ParseUtil::GetString(json, AdaptiveCardSchemaKey::IconUrl));
     element->SetStyle(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Style, defaultStyle, false));
-    element->SetMode(ParseUtil::GetEnumValue<Mode>(json, AdaptiveCardSchemaKey::Mode, Mode::Primary, ModeFromString));
+    element->SetMode(ParseUtil::GetEnumValue<Mode>(json, AdaptiveCardSchemaKey::Mode, Mode::Primary, ModeTryFromString));
     element->SetTooltip(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Tooltip));
     element->SetIsEnabled(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::IsEnabled, true));
 }
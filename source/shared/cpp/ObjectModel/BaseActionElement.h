@@ -82,12 +82,12 @@ private:
 template <typename T>
 std::shared_ptr<T> BaseActionElement::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<T> cardElement = std::make_shared<T>();
+    std::shared_ptr<T> cardElement = context.MakeShared<T>();
     std::shared_ptr<BaseActionElement> baseActionElement = std::static_pointer_cast<BaseActionElement>(cardElement);
     DeserializeBaseProperties(context, json, baseActionElement);
 
     // Walk all properties and put any unknown ones in the additional properties json
-    HandleUnknownProperties(json, baseActionElement->m_knownProperties, baseActionElement->m_additionalProperties);
+    HandleUnknownProperties(json, baseActionElement->GetKnownProperties(), baseActionElement->m_additionalProperties);
 
     return cardElement;
 }
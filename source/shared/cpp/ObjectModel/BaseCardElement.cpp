@@ -27,12 +27,13 @@ BaseCardElement::BaseCardElement(CardElementType type) :
 
 void BaseCardElement::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsVisible),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MinHeight),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Separator),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Spacing)});
+    SetKnownProperties(knownProperties);
 }
 
 bool BaseCardElement::GetSeparator() const
@@ -143,7 +144,7 @@ std::shared_ptr<BaseCardElement> BaseCardElement::DeserializeBasePropertiesFromS
 
 std::shared_ptr<BaseCardElement> BaseCardElement::DeserializeBaseProperties(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<BaseCardElement> baseCardElement = std::make_shared<BaseCardElement>();
+    std::shared_ptr<BaseCardElement> baseCardElement = context.MakeShared<BaseCardElement>();
     DeserializeBaseProperties(context, json, baseCardElement);
     return baseCardElement;
 }
@@ -154,8 +155,8 @@ void BaseCardElement::DeserializeBaseProperties(ParseContext& context, const Jso
 
     element->DeserializeBase<BaseCardElement>(context, json);
     element->SetCanFallbackToAncestor(context.GetCanFallbackToAncestor());
-    element->SetHeight(ParseUtil::GetEnumValue<HeightType>(json, AdaptiveCardSchemaKey::Height, HeightType::Auto, HeightTypeFromString));
+    element->SetHeight(ParseUtil::GetEnumValue<HeightType>(json, AdaptiveCardSchemaKey::Height, HeightType::Auto, HeightTypeTryFromString));
     element->SetIsVisible(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::IsVisible, true));
     element->SetSeparator(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::Separator, false));
-    element->SetSpacing(ParseUtil::GetEnumValue<Spacing>(json, AdaptiveCardSchemaKey::Spacing, Spacing::Default, SpacingFromString));
+    element->SetSpacing(ParseUtil::GetEnumValue<Spacing>(json, AdaptiveCardSchemaKey::Spacing, Spacing::Default, SpacingTryFromString));
 }
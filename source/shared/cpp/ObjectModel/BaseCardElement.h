@@ -67,12 +67,12 @@ private:
 template <typename T>
 std::shared_ptr<T> BaseCardElement::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<T> cardElement = std::make_shared<T>();
+    std::shared_ptr<T> cardElement = context.MakeShared<T>();
     std::shared_ptr<BaseCardElement> baseCardElement = std::static_pointer_cast<BaseCardElement>(cardElement);
     DeserializeBaseProperties(context, json, baseCardElement);
 
     // Walk all properties and put any unknown ones in the additional properties json
-    HandleUnknownProperties(json, baseCardElement->m_knownProperties, baseCardElement->m_additionalProperties);
+    HandleUnknownProperties(json, baseCardElement->GetKnownProperties(), baseCardElement->m_additionalProperties);
 
     return cardElement;
 }
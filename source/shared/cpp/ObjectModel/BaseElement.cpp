@@ -8,7 +8,8 @@
 
 namespace AdaptiveCards
 {
-unsigned int InternalId::s_currentInternalId = 1;
+std::atomic<unsigned int> InternalId::s_nextInternalId{2};
+thread_local unsigned int InternalId::s_currentInternalId = 1;
 
 InternalId InternalId::Current()
 {
@@ -18,14 +19,15 @@ InternalId InternalId::Current()
 
 InternalId InternalId::Next()
 {
-    s_currentInternalId++;
+    unsigned int nextInternalId = s_nextInternalId++;
 
     // handle overflow case
-    if (s_currentInternalId == InternalId::Invalid)
+    if (nextInternalId == InternalId::Invalid)
     {
-        s_currentInternalId++;
+        nextInternalId = s_nextInternalId++;
     }
 
+    s_currentInternalId = nextInternalId;
     return Current();
 }
 
@@ -42,6 +44,11 @@ std::string BaseElement::Serialize() const
     return ParseUtil::JsonToString(SerializeToJsonValue());
 }
 
+void BaseElement::Serialize(std::string& output) const
+{
+    ParseUtil::JsonToString(SerializeToJsonValue(), output);
+}
+
 const std::string& BaseElement::GetId() const
 {
     return m_id;
@@ -72,11 +79,19 @@ void BaseElement::SetElementTypeString(const std::string& value)
 
 void BaseElement::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
-        {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Id),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Requires),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)});
+    static const std::unordered_set<std::string> knownProperties{
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Id),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Requires),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)};
+    SetKnownProperties(knownProperties);
+}
+
+std::unordered_set<std::string> BaseElement::ExtendKnownProperties(std::initializer_list<std::string> properties) const
+{
+    std::unordered_set<std::string> knownProperties{*m_knownProperties};
+    knownProperties.insert(properties);
+    return knownProperties;
 }
 
 const Json::Value& BaseElement::GetAdditionalProperties() const
@@ -94,6 +109,11 @@ void BaseElement::SetAdditionalProperties(const Json::Value& value)
 }
 
 // Given a map of what our host provides, determine if this element's requirements are satisfied.
+const std::shared_ptr<BaseElement>& BaseElement::GetFallbackContent() const
+{
+    return m_deferredFallbackContent ? m_deferredFallbackContent->GetFallbackContent() : m_fallbackContent;
+}
+
 bool BaseElement::MeetsRequirements(const AdaptiveCards::FeatureRegistration& featureRegistration) const
 {
     for (const auto& requirement : m_requires)
@@ -153,7 +173,7 @@ Json::Value BaseElement::SerializeToJsonValue() const
     }
     else if (m_fallbackType == FallbackType::Content)
     {
-        root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback)] = m_fallbackContent->SerializeToJsonValue();
+        root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback)] = GetFallbackContent()->SerializeToJsonValue();
     }
 
     // Handle requires
@@ -179,7 +199,7 @@ void BaseElement::GetResourceInformation(std::vector<RemoteResourceInformation>&
 
 void BaseElement::ParseRequires(ParseContext& /*context*/, const Json::Value& json)
 {
-    const auto requiresValue = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Requires, false);
+    const Json::Value& requiresValue = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Requires, false);
     if (!requiresValue.isNull())
     {
         if (requiresValue.isObject())
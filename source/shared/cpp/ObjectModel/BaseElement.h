@@ -4,6 +4,7 @@
 
 #include "pch.h"
 #include "json/json.h"
+#include "DeferredParse.h"
 #include "InternalId.h"
 #include "ParseContext.h"
 #include "ParseUtil.h"
@@ -17,12 +18,14 @@ namespace AdaptiveCards
 class ParseContext;
 #endif
 class FeatureRegistration;
+class BaseActionElement;
+class CardSnapshotReader;
 
 class BaseElement
 {
 public:
     BaseElement() :
-        m_typeString{}, m_additionalProperties{}, m_requires{},
+        m_typeString{}, m_knownProperties(nullptr), m_additionalProperties{}, m_requires{},
         m_fallbackContent(nullptr), m_id{}, m_internalId{InternalId::Current()}, m_fallbackType(FallbackType::None),
         m_canFallbackToAncestor(false)
     {
@@ -53,20 +56,24 @@ public:
     void DeserializeBase(AdaptiveCards::ParseContext& context, const Json::Value& json);
 
     virtual std::string Serialize() const;
+    // Serializes into output (replacing its contents), so that a buffer can be reused across calls
+    void Serialize(std::string& output) const;
     virtual Json::Value SerializeToJsonValue() const;
     const Json::Value& GetAdditionalProperties() const;
     void SetAdditionalProperties(Json::Value&& additionalProperties);
     void SetAdditionalProperties(const Json::Value& additionalProperties);
+    const std::unordered_set<std::string>& GetKnownProperties() const
+    {
+        return *m_knownProperties;
+    }
 
     // Fallback and Requires support
     FallbackType GetFallbackType() const
     {
         return m_fallbackType;
     }
-    const std::shared_ptr<BaseElement>& GetFallbackContent() const
-    {
-        return m_fallbackContent;
-    }
+    // Parses the fallback content first if its parsing was deferred (see ParseContext::SetUseLazyParsing())
+    const std::shared_ptr<BaseElement>& GetFallbackContent() const;
     bool CanFallbackToAncestor() const
     {
         return m_canFallbackToAncestor;
@@ -78,6 +85,7 @@ public:
     void SetFallbackContent(std::shared_ptr<BaseElement> element)
     {
         m_fallbackContent = std::move(element);
+        m_deferredFallbackContent.reset();
     }
 
     bool MeetsRequirements(const AdaptiveCards::FeatureRegistration& hostProvides) const;
@@ -89,6 +97,8 @@ public:
     virtual void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceUris);
 
 protected:
+    friend class CardSnapshotReader;
+
     void SetTypeString(std::string&& type)
     {
         m_typeString = std::move(type);
@@ -102,8 +112,17 @@ protected:
         m_canFallbackToAncestor = value;
     }
 
+    // The set of json properties an element understands is the same for every instance of a type, so each type
+    // builds its set once (as a function-local static, from its base type's set) and every instance points at it.
+    // Derived constructors call SetKnownProperties after their base constructor has set the base type's set.
+    void SetKnownProperties(const std::unordered_set<std::string>& knownProperties)
+    {
+        m_knownProperties = &knownProperties;
+    }
+    std::unordered_set<std::string> ExtendKnownProperties(std::initializer_list<std::string> properties) const;
+
     std::string m_typeString;
-    std::unordered_set<std::string> m_knownProperties;
+    const std::unordered_set<std::string>* m_knownProperties;
     Json::Value m_additionalProperties;
 
 private:
@@ -114,6 +133,7 @@ private:
 
     std::unordered_map<std::string, AdaptiveCards::SemanticVersion> m_requires;
     std::shared_ptr<BaseElement> m_fallbackContent;
+    std::shared_ptr<DeferredParse> m_deferredFallbackContent;
     std::string m_id;
     InternalId m_internalId;
     FallbackType m_fallbackType;
@@ -135,15 +155,14 @@ void BaseElement::DeserializeBase(ParseContext& context, const Json::Value& json
 template <typename T>
 void BaseElement::ParseFallback(ParseContext& context, const Json::Value& json)
 {
-    const auto fallbackValue = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Fallback, false);
+    const Json::Value& fallbackValue = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Fallback, false);
     if (!fallbackValue.empty())
     {
         // Two possible valid json values for fallback -- either the string "drop", or a valid Adaptive Card
         // element.
         if (fallbackValue.isString())
         {
-            auto fallbackStringValue = ParseUtil::ToLowercase(fallbackValue.asString());
-            if (fallbackStringValue == "drop")
+            if (CaseInsensitive::Equals(ParseUtil::GetStringView(fallbackValue), "drop"))
             {
                 m_fallbackType = FallbackType::Drop;
                 return;
@@ -154,6 +173,19 @@ void BaseElement::ParseFallback(ParseContext& context, const Json::Value& json)
         }
         else if (fallbackValue.isObject())
         {
+            // Columns check their fallback content's type as soon as it's parsed (see ColumnParser), so theirs
+            // isn't deferred
+            if (m_typeString != CardElementTypeToString(CardElementType::Column))
+            {
+                m_deferredFallbackContent = DeferredParse::DeferFallback(
+                    context, fallbackValue, GetId(), GetInternalId(), std::is_same<T, BaseActionElement>::value);
+                if (m_deferredFallbackContent)
+                {
+                    m_fallbackType = FallbackType::Content;
+                    return;
+                }
+            }
+
             // fallback value is a JSON object. parse it and add it as fallback content. For more details, refer to
             // the giant comment on ID collision detection in ParseContext.cpp.
             context.PushElement(GetId(), GetInternalId(), true /*isFallback*/);
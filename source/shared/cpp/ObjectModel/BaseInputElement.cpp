@@ -76,10 +76,11 @@ Json::Value BaseInputElement::SerializeToJsonValue() const
 
 void BaseInputElement::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsRequired),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ErrorMessage),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Label)});
+    SetKnownProperties(knownProperties);
 }
 
 std::shared_ptr<BaseInputElement> BaseInputElement::DeserializeBasePropertiesFromString(ParseContext& context, const std::string& jsonString)
@@ -0,0 +1,600 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardPatch.h"
+#include "AdaptiveCardParseException.h"
+#include "ParseContext.h"
+#include "ParseResult.h"
+#include "ParseUtil.h"
+#include "SharedAdaptiveCard.h"
+
+namespace
+{
+using AdaptiveCards::CardPatch;
+using Operation = CardPatch::Operation;
+using OperationType = CardPatch::OperationType;
+
+constexpr auto c_opAdd = "add";
+constexpr auto c_opRemove = "remove";
+constexpr auto c_opReplace = "replace";
+constexpr auto c_opMove = "move";
+
+[[noreturn]] void ThrowInvalidPatch(const std::string& details)
+{
+    throw AdaptiveCards::AdaptiveCardParseException(AdaptiveCards::ErrorStatusCode::InvalidJson, "Invalid card patch: " + details);
+}
+
+std::string AppendToPointer(const std::string& pointer, const std::string& token)
+{
+    std::string result = pointer;
+    result.reserve(pointer.size() + token.size() + 1);
+    result.push_back('/');
+    for (const char c : token)
+    {
+        if (c == '~')
+        {
+            result += "~0";
+        }
+        else if (c == '/')
+        {
+            result += "~1";
+        }
+        else
+        {
+            result.push_back(c);
+        }
+    }
+    return result;
+}
+
+std::string AppendToPointer(const std::string& pointer, Json::ArrayIndex index)
+{
+    return pointer + "/" + std::to_string(index);
+}
+
+// The id elements and actions are matched on, or nullptr if the value doesn't have one
+const Json::Value* GetId(const Json::Value& value)
+{
+    const Json::Value* id = value.find("id", "id" + 2);
+    return (id != nullptr && id->isString() && !id->asString().empty()) ? id : nullptr;
+}
+
+bool IsSameType(const Json::Value& from, const Json::Value& to)
+{
+    const Json::Value* fromType = from.find("type", "type" + 4);
+    const Json::Value* toType = to.find("type", "type" + 4);
+    return (fromType == nullptr || toType == nullptr) ? (fromType == toType) : (*fromType == *toType);
+}
+
+bool ContainsOnlyObjects(const Json::Value& array)
+{
+    for (const auto& item : array)
+    {
+        if (!item.isObject())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DiffValues(const Json::Value& from, const Json::Value& to, const std::string& path, std::vector<Operation>& operations);
+
+void DiffObjects(const Json::Value& from, const Json::Value& to, const std::string& path, std::vector<Operation>& operations)
+{
+    // getMemberNames() is sorted, so both lists can be walked together
+    const auto fromNames = from.getMemberNames();
+    const auto toNames = to.getMemberNames();
+
+    auto fromName = fromNames.cbegin();
+    auto toName = toNames.cbegin();
+    while (fromName != fromNames.cend() || toName != toNames.cend())
+    {
+        if (toName == toNames.cend() || (fromName != fromNames.cend() && *fromName < *toName))
+        {
+            operations.push_back({OperationType::Remove, AppendToPointer(path, *fromName), std::string(), Json::Value()});
+            ++fromName;
+        }
+        else if (fromName == fromNames.cend() || *toName < *fromName)
+        {
+            operations.push_back({OperationType::Add, AppendToPointer(path, *toName), std::string(), to[*toName]});
+            ++toName;
+        }
+        else
+        {
+            DiffValues(from[*fromName], to[*toName], AppendToPointer(path, *toName), operations);
+            ++fromName;
+            ++toName;
+        }
+    }
+}
+
+// Arrays of objects (body elements, actions, columns, facts, ...) are diffed item by item: items are paired up by
+// id, then by position and type, and the items that didn't pair up are removed or added. Other arrays are replaced
+// as a whole.
+void DiffArrays(const Json::Value& from, const Json::Value& to, const std::string& path, std::vector<Operation>& operations)
+{
+    if (!ContainsOnlyObjects(from) || !ContainsOnlyObjects(to))
+    {
+        operations.push_back({OperationType::Replace, path, std::string(), to});
+        return;
+    }
+
+    constexpr auto c_unmatched = std::numeric_limits<Json::ArrayIndex>::max();
+    std::vector<Json::ArrayIndex> matches(to.size(), c_unmatched);
+    std::vector<bool> fromMatched(from.size(), false);
+
+    std::unordered_multimap<std::string, Json::ArrayIndex> fromIds;
+    for (Json::ArrayIndex i = 0; i < from.size(); ++i)
+    {
+        if (const Json::Value* id = GetId(from[i]))
+        {
+            fromIds.emplace(id->asString(), i);
+        }
+    }
+
+    for (Json::ArrayIndex i = 0; i < to.size(); ++i)
+    {
+        if (const Json::Value* id = GetId(to[i]))
+        {
+            const auto candidates = fromIds.equal_range(id->asString());
+            for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+            {
+                if (!fromMatched[candidate->second])
+                {
+                    matches[i] = candidate->second;
+                    fromMatched[candidate->second] = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (Json::ArrayIndex i = 0; i < to.size() && i < from.size(); ++i)
+    {
+        if (matches[i] == c_unmatched && !fromMatched[i] && IsSameType(from[i], to[i]))
+        {
+            matches[i] = i;
+            fromMatched[i] = true;
+        }
+    }
+
+    // Remove from the back so that the indices of the items still to be removed don't change
+    for (Json::ArrayIndex i = from.size(); i-- > 0;)
+    {
+        if (!fromMatched[i])
+        {
+            operations.push_back({OperationType::Remove, AppendToPointer(path, i), std::string(), Json::Value()});
+        }
+    }
+
+    // Then put the array in its new order. current tracks which item of from (or c_unmatched, for added items) is at
+    // each position as the operations are applied; everything before position i is already in its final place.
+    std::vector<Json::ArrayIndex> current;
+    for (Json::ArrayIndex i = 0; i < from.size(); ++i)
+    {
+        if (fromMatched[i])
+        {
+            current.push_back(i);
+        }
+    }
+
+    for (Json::ArrayIndex i = 0; i < to.size(); ++i)
+    {
+        if (matches[i] == c_unmatched)
+        {
+            operations.push_back({OperationType::Add, AppendToPointer(path, i), std::string(), to[i]});
+            current.insert(current.begin() + i, c_unmatched);
+        }
+        else
+        {
+            const auto position = static_cast<Json::ArrayIndex>(std::find(current.begin() + i, current.end(), matches[i]) - current.begin());
+            if (position != i)
+            {
+                operations.push_back({OperationType::Move, AppendToPointer(path, i), AppendToPointer(path, position), Json::Value()});
+                current.erase(current.begin() + position);
+                current.insert(current.begin() + i, matches[i]);
+            }
+        }
+    }
+
+    for (Json::ArrayIndex i = 0; i < to.size(); ++i)
+    {
+        if (matches[i] != c_unmatched)
+        {
+            DiffValues(from[matches[i]], to[i], AppendToPointer(path, i), operations);
+        }
+    }
+}
+
+void DiffValues(const Json::Value& from, const Json::Value& to, const std::string& path, std::vector<Operation>& operations)
+{
+    if (from == to)
+    {
+        return;
+    }
+
+    if (from.isObject() && to.isObject())
+    {
+        DiffObjects(from, to, path, operations);
+    }
+    else if (from.isArray() && to.isArray())
+    {
+        DiffArrays(from, to, path, operations);
+    }
+    else
+    {
+        operations.push_back({OperationType::Replace, path, std::string(), to});
+    }
+}
+
+std::vector<std::string> ParsePointer(const std::string& pointer)
+{
+    std::vector<std::string> tokens;
+    if (pointer.empty())
+    {
+        return tokens;
+    }
+
+    if (pointer.front() != '/')
+    {
+        ThrowInvalidPatch("'" + pointer + "' is not a JSON Pointer");
+    }
+
+    for (size_t start = 1;;)
+    {
+        const size_t end = std::min(pointer.find('/', start), pointer.size());
+        std::string token;
+        for (size_t i = start; i < end; ++i)
+        {
+            if (pointer[i] == '~')
+            {
+                if (i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1'))
+                {
+                    token.push_back(pointer[++i] == '0' ? '~' : '/');
+                }
+                else
+                {
+                    ThrowInvalidPatch("'" + pointer + "' is not a JSON Pointer");
+                }
+            }
+            else
+            {
+                token.push_back(pointer[i]);
+            }
+        }
+        tokens.push_back(std::move(token));
+
+        if (end == pointer.size())
+        {
+            return tokens;
+        }
+        start = end + 1;
+    }
+}
+
+bool IsDigit(const char c)
+{
+    return ::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+// Parses an array index no greater than limit. "-" (one past the end) isn't an index here; callers that accept it
+// check for it themselves.
+Json::ArrayIndex ParseArrayIndex(const std::string& token, Json::ArrayIndex limit, const std::string& pointer)
+{
+    // RFC 6901: no sign, no leading zeros
+    if (token.empty() || token.size() > 9 || !std::all_of(token.begin(), token.end(), IsDigit) || (token.size() > 1 && token.front() == '0'))
+    {
+        ThrowInvalidPatch("'" + pointer + "' does not exist");
+    }
+
+    const auto index = static_cast<Json::ArrayIndex>(std::stoul(token));
+    if (index > limit)
+    {
+        ThrowInvalidPatch("'" + pointer + "' does not exist");
+    }
+    return index;
+}
+
+// Parses the index of an element array already has
+Json::ArrayIndex ParseExistingArrayIndex(const std::string& token, const Json::Value& array, const std::string& pointer)
+{
+    if (array.empty())
+    {
+        ThrowInvalidPatch("'" + pointer + "' does not exist");
+    }
+    return ParseArrayIndex(token, array.size() - 1, pointer);
+}
+
+// Finds the value that contains the one pointer refers to
+Json::Value& ResolveParent(Json::Value& json, const std::vector<std::string>& tokens, const std::string& pointer)
+{
+    Json::Value* value = &json;
+    for (size_t i = 0; i + 1 < tokens.size(); ++i)
+    {
+        if (value->isObject())
+        {
+            const char* begin = tokens[i].data();
+            const char* end = begin + tokens[i].size();
+            if (value->find(begin, end) == nullptr)
+            {
+                ThrowInvalidPatch("'" + pointer + "' does not exist");
+            }
+            value = &(*value)[tokens[i]];
+        }
+        else if (value->isArray())
+        {
+            // the index exists, so this doesn't grow the array
+            value = &(*value)[ParseExistingArrayIndex(tokens[i], *value, pointer)];
+        }
+        else
+        {
+            ThrowInvalidPatch("'" + pointer + "' does not exist");
+        }
+    }
+    return *value;
+}
+
+void AddValue(Json::Value& json, const std::string& pointer, Json::Value value)
+{
+    const auto tokens = ParsePointer(pointer);
+    if (tokens.empty())
+    {
+        json = std::move(value);
+        return;
+    }
+
+    Json::Value& parent = ResolveParent(json, tokens, pointer);
+    const std::string& last = tokens.back();
+    if (parent.isObject())
+    {
+        parent[last] = std::move(value);
+    }
+    else if (parent.isArray())
+    {
+        const Json::ArrayIndex index = (last == "-") ? parent.size() : ParseArrayIndex(last, parent.size(), pointer);
+
+        // Json::Value has no insert; append and shift the tail down
+        parent.append(std::move(value));
+        for (Json::ArrayIndex i = parent.size() - 1; i > index; --i)
+        {
+            parent[i].swap(parent[i - 1]);
+        }
+    }
+    else
+    {
+        ThrowInvalidPatch("'" + pointer + "' does not exist");
+    }
+}
+
+Json::Value RemoveValue(Json::Value& json, const std::string& pointer)
+{
+    const auto tokens = ParsePointer(pointer);
+    if (tokens.empty())
+    {
+        ThrowInvalidPatch("the whole card can't be removed");
+    }
+
+    Json::Value& parent = ResolveParent(json, tokens, pointer);
+    const std::string& last = tokens.back();
+    Json::Value removed;
+    if (parent.isObject())
+    {
+        if (!parent.removeMember(last.data(), last.data() + last.size(), &removed))
+        {
+            ThrowInvalidPatch("'" + pointer + "' does not exist");
+        }
+    }
+    else if (parent.isArray())
+    {
+        parent.removeIndex(ParseExistingArrayIndex(last, parent, pointer), &removed);
+    }
+    else
+    {
+        ThrowInvalidPatch("'" + pointer + "' does not exist");
+    }
+    return removed;
+}
+
+void ReplaceValue(Json::Value& json, const std::string& pointer, Json::Value value)
+{
+    const auto tokens = ParsePointer(pointer);
+    if (tokens.empty())
+    {
+        json = std::move(value);
+        return;
+    }
+
+    Json::Value& parent = ResolveParent(json, tokens, pointer);
+    const std::string& last = tokens.back();
+    if (parent.isObject())
+    {
+        if (parent.find(last.data(), last.data() + last.size()) == nullptr)
+        {
+            ThrowInvalidPatch("'" + pointer + "' does not exist");
+        }
+        parent[last] = std::move(value);
+    }
+    else if (parent.isArray())
+    {
+        parent[ParseExistingArrayIndex(last, parent, pointer)] = std::move(value);
+    }
+    else
+    {
+        ThrowInvalidPatch("'" + pointer + "' does not exist");
+    }
+}
+
+const char* OperationTypeToString(OperationType type)
+{
+    switch (type)
+    {
+    case OperationType::Add:
+        return c_opAdd;
+    case OperationType::Remove:
+        return c_opRemove;
+    case OperationType::Replace:
+        return c_opReplace;
+    case OperationType::Move:
+    default:
+        return c_opMove;
+    }
+}
+} // namespace
+
+namespace AdaptiveCards
+{
+CardPatch::CardPatch(std::vector<Operation> operations) : m_operations(std::move(operations))
+{
+}
+
+CardPatch CardPatch::Diff(const AdaptiveCard& from, const AdaptiveCard& to)
+{
+    return Diff(from.SerializeToJsonValue(), to.SerializeToJsonValue());
+}
+
+CardPatch CardPatch::Diff(const Json::Value& from, const Json::Value& to)
+{
+    std::vector<Operation> operations;
+    DiffValues(from, to, std::string(), operations);
+    return CardPatch(std::move(operations));
+}
+
+CardPatch CardPatch::FromJsonPatch(const Json::Value& patch)
+{
+    if (!patch.isArray())
+    {
+        ThrowInvalidPatch("a JSON Patch must be an array");
+    }
+
+    std::vector<Operation> operations;
+    operations.reserve(patch.size());
+    for (const auto& item : patch)
+    {
+        // operator[] asserts on anything other than an object or null
+        if (!item.isObject())
+        {
+            ThrowInvalidPatch("every operation needs an op and a path");
+        }
+
+        const Json::Value& op = item["op"];
+        const Json::Value& path = item["path"];
+        if (!op.isString() || !path.isString())
+        {
+            ThrowInvalidPatch("every operation needs an op and a path");
+        }
+
+        Operation operation{OperationType::Add, path.asString(), std::string(), Json::Value()};
+        const std::string opName = op.asString();
+        if (opName == c_opAdd || opName == c_opReplace)
+        {
+            if (!item.isMember("value"))
+            {
+                ThrowInvalidPatch(opName + " needs a value");
+            }
+            operation.type = (opName == c_opAdd) ? OperationType::Add : OperationType::Replace;
+            operation.value = item["value"];
+        }
+        else if (opName == c_opRemove)
+        {
+            operation.type = OperationType::Remove;
+        }
+        else if (opName == c_opMove)
+        {
+            if (!item["from"].isString())
+            {
+                ThrowInvalidPatch("move needs a from");
+            }
+            operation.type = OperationType::Move;
+            operation.from = item["from"].asString();
+        }
+        else
+        {
+            ThrowInvalidPatch("unsupported op '" + opName + "'");
+        }
+        operations.push_back(std::move(operation));
+    }
+    return CardPatch(std::move(operations));
+}
+
+CardPatch CardPatch::FromJsonPatchString(const std::string& patch)
+{
+    return FromJsonPatch(ParseUtil::GetJsonValueFromString(patch));
+}
+
+Json::Value CardPatch::ToJsonPatch() const
+{
+    Json::Value patch(Json::arrayValue);
+    for (const auto& operation : m_operations)
+    {
+        Json::Value item(Json::objectValue);
+        item["op"] = OperationTypeToString(operation.type);
+        if (operation.type == OperationType::Move)
+        {
+            item["from"] = operation.from;
+        }
+        item["path"] = operation.path;
+        if (operation.type == OperationType::Add || operation.type == OperationType::Replace)
+        {
+            item["value"] = operation.value;
+        }
+        patch.append(std::move(item));
+    }
+    return patch;
+}
+
+std::string CardPatch::Serialize() const
+{
+    return ParseUtil::JsonToString(ToJsonPatch());
+}
+
+const std::vector<CardPatch::Operation>& CardPatch::GetOperations() const
+{
+    return m_operations;
+}
+
+bool CardPatch::IsEmpty() const
+{
+    return m_operations.empty();
+}
+
+void CardPatch::Apply(Json::Value& json) const
+{
+    for (const auto& operation : m_operations)
+    {
+        switch (operation.type)
+        {
+        case OperationType::Add:
+            AddValue(json, operation.path, operation.value);
+            break;
+        case OperationType::Remove:
+            RemoveValue(json, operation.path);
+            break;
+        case OperationType::Replace:
+            ReplaceValue(json, operation.path, operation.value);
+            break;
+        case OperationType::Move:
+            // a value can't be moved into itself
+            if (operation.path.compare(0, operation.from.size() + 1, operation.from + "/") == 0)
+            {
+                ThrowInvalidPatch("'" + operation.from + "' can't be moved into itself");
+            }
+            AddValue(json, operation.path, RemoveValue(json, operation.from));
+            break;
+        }
+    }
+}
+
+std::shared_ptr<ParseResult> CardPatch::Apply(const AdaptiveCard& card, const std::string& rendererVersion) const
+{
+    ParseContext context;
+    return Apply(card, rendererVersion, context);
+}
+
+std::shared_ptr<ParseResult> CardPatch::Apply(const AdaptiveCard& card, const std::string& rendererVersion, ParseContext& context) const
+{
+    Json::Value json = card.SerializeToJsonValue();
+    Apply(json);
+    return AdaptiveCard::Deserialize(json, rendererVersion, context);
+}
+} // namespace AdaptiveCards
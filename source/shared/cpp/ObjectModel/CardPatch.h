@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveCards
+{
+class AdaptiveCard;
+class ParseContext;
+class ParseResult;
+
+// The differences between two versions of a card (e.g. the card a host is showing and the one a Refresh or
+// Action.Execute returned), as a list of JSON Patch (RFC 6902) operations against the card's serialized form.
+//
+// Elements and actions are matched by id first, then by position and type, so an element that moved or had a
+// property change shows up as a move or as changes to that property rather than as a new element. Renderers can use
+// the operations' paths to update only what changed, and services can send the patch instead of the whole card.
+class CardPatch
+{
+public:
+    enum class OperationType
+    {
+        Add,
+        Remove,
+        Replace,
+        Move
+    };
+
+    struct Operation
+    {
+        OperationType type;
+        // JSON Pointer (RFC 6901) to the value added, removed, replaced, or moved to
+        std::string path;
+        // for Move, where the value is moved from
+        std::string from;
+        // for Add and Replace
+        Json::Value value;
+    };
+
+    CardPatch() = default;
+    explicit CardPatch(std::vector<Operation> operations);
+
+    static CardPatch Diff(const AdaptiveCard& from, const AdaptiveCard& to);
+    static CardPatch Diff(const Json::Value& from, const Json::Value& to);
+
+    // Reads a JSON Patch document. Only the operations Diff() produces (add, remove, replace, and move) are
+    // supported; anything else throws AdaptiveCardParseException.
+    static CardPatch FromJsonPatch(const Json::Value& patch);
+    static CardPatch FromJsonPatchString(const std::string& patch);
+
+    Json::Value ToJsonPatch() const;
+    std::string Serialize() const;
+
+    const std::vector<Operation>& GetOperations() const;
+    bool IsEmpty() const;
+
+    // Applies the operations in order. Throws AdaptiveCardParseException if an operation's path doesn't exist, in
+    // which case json is left partially patched.
+    void Apply(Json::Value& json) const;
+
+    // Patches the card's serialized form and parses the result
+    std::shared_ptr<ParseResult> Apply(const AdaptiveCard& card, const std::string& rendererVersion) const;
+    std::shared_ptr<ParseResult> Apply(const AdaptiveCard& card, const std::string& rendererVersion, ParseContext& context) const;
+
+private:
+    std::vector<Operation> m_operations;
+};
+} // namespace AdaptiveCards
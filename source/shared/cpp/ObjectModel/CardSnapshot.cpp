@@ -0,0 +1,1842 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardSnapshot.h"
+#include "ActionSet.h"
+#include "AdaptiveCardParseException.h"
+#include "Authentication.h"
+#include "AuthCardButton.h"
+#include "BackgroundImage.h"
+#include "ChoiceInput.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "ExecuteAction.h"
+#include "Fact.h"
+#include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "MediaSource.h"
+#include "NumberInput.h"
+#include "OpenUrlAction.h"
+#include "ParseContext.h"
+#include "ParseResult.h"
+#include "Refresh.h"
+#include "RichTextBlock.h"
+#include "SemanticVersion.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+#include "SubmitAction.h"
+#include "Table.h"
+#include "TableCell.h"
+#include "TableColumnDefinition.h"
+#include "TableRow.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+#include "ToggleVisibilityAction.h"
+#include "ToggleVisibilityTarget.h"
+#include "TokenExchangeResource.h"
+#include "UnknownAction.h"
+#include "UnknownElement.h"
+#include <cstring>
+#include <typeindex>
+
+using namespace AdaptiveCards;
+
+namespace
+{
+constexpr char c_magic[] = {'A', 'C', 'S', 'N'};
+
+// magic, version, reserved, string count, string table offset, card offset, total size
+constexpr uint32_t c_headerSize = 24;
+constexpr uint32_t c_versionOffset = 4;
+constexpr uint32_t c_stringCountOffset = 8;
+constexpr uint32_t c_stringTableOffsetOffset = 12;
+constexpr uint32_t c_cardOffsetOffset = 16;
+constexpr uint32_t c_totalSizeOffset = 20;
+
+// Written in place of a type or an optional value that isn't there
+constexpr uint8_t c_absent = 0xff;
+// Written in place of InlineElementType for an inline that isn't a TextRun
+constexpr uint8_t c_customInline = 0xfe;
+
+// same limit jsoncpp applies when parsing
+constexpr unsigned int c_maxDepth = 1000;
+
+// Json::Values (additional properties, action data, custom elements) are a tag followed by
+//     int/uint/real:  8 bytes
+//     string:         string index
+//     array:          count, then each item
+//     object:         count, then (name string index, value) per member
+enum JsonTag : uint8_t
+{
+    Null = 0,
+    False,
+    True,
+    Int,
+    UInt,
+    Real,
+    String,
+    Array,
+    Object
+};
+
+[[noreturn]] void ThrowInvalidSnapshot(const std::string& details)
+{
+    throw AdaptiveCardParseException(ErrorStatusCode::InvalidJson, "Invalid card snapshot: " + details);
+}
+
+// The record type of an element. Anything that isn't exactly one of the types below (a host's own element, or a
+// subclass of one of ours) is stored as JSON.
+CardElementType GetRecordType(const BaseCardElement& element)
+{
+    static const std::unordered_map<std::type_index, CardElementType> c_recordTypes{
+        {typeid(ActionSet), CardElementType::ActionSet},
+        {typeid(ChoiceSetInput), CardElementType::ChoiceSetInput},
+        {typeid(Column), CardElementType::Column},
+        {typeid(ColumnSet), CardElementType::ColumnSet},
+        {typeid(Container), CardElementType::Container},
+        {typeid(DateInput), CardElementType::DateInput},
+        {typeid(FactSet), CardElementType::FactSet},
+        {typeid(Image), CardElementType::Image},
+        {typeid(ImageSet), CardElementType::ImageSet},
+        {typeid(Media), CardElementType::Media},
+        {typeid(NumberInput), CardElementType::NumberInput},
+        {typeid(RichTextBlock), CardElementType::RichTextBlock},
+        {typeid(Table), CardElementType::Table},
+        {typeid(TableCell), CardElementType::TableCell},
+        {typeid(TableRow), CardElementType::TableRow},
+        {typeid(TextBlock), CardElementType::TextBlock},
+        {typeid(TextInput), CardElementType::TextInput},
+        {typeid(TimeInput), CardElementType::TimeInput},
+        {typeid(ToggleInput), CardElementType::ToggleInput},
+        {typeid(UnknownElement), CardElementType::Unknown}};
+
+    const auto recordType = c_recordTypes.find(typeid(element));
+    return recordType != c_recordTypes.end() ? recordType->second : CardElementType::Custom;
+}
+
+ActionType GetRecordType(const BaseActionElement& action)
+{
+    static const std::unordered_map<std::type_index, ActionType> c_recordTypes{
+        {typeid(ExecuteAction), ActionType::Execute},
+        {typeid(OpenUrlAction), ActionType::OpenUrl},
+        {typeid(ShowCardAction), ActionType::ShowCard},
+        {typeid(SubmitAction), ActionType::Submit},
+        {typeid(ToggleVisibilityAction), ActionType::ToggleVisibility},
+        {typeid(UnknownAction), ActionType::UnknownAction}};
+
+    const auto recordType = c_recordTypes.find(typeid(action));
+    return recordType != c_recordTypes.end() ? recordType->second : ActionType::Custom;
+}
+
+class SnapshotWriter
+{
+public:
+    std::vector<uint8_t> Write(const AdaptiveCard& card)
+    {
+        WriteCard(card);
+
+        std::vector<uint8_t> snapshot(c_headerSize, 0);
+        std::copy(std::begin(c_magic), std::end(c_magic), snapshot.begin());
+        PatchUInt16(snapshot, c_versionOffset, CardSnapshot::FormatVersion);
+        PatchUInt32(snapshot, c_stringCountOffset, static_cast<uint32_t>(m_strings.size()));
+        PatchUInt32(snapshot, c_stringTableOffsetOffset, c_headerSize);
+
+        uint64_t stringOffset = uint64_t{c_headerSize} + 8 * m_strings.size();
+        for (const std::string* string : m_strings)
+        {
+            AppendUInt32(snapshot, CheckedSize(stringOffset));
+            AppendUInt32(snapshot, CheckedSize(string->size()));
+            stringOffset += string->size();
+        }
+        for (const std::string* string : m_strings)
+        {
+            snapshot.insert(snapshot.end(), string->begin(), string->end());
+        }
+
+        PatchUInt32(snapshot, c_cardOffsetOffset, CheckedSize(snapshot.size()));
+        snapshot.insert(snapshot.end(), m_records.begin(), m_records.end());
+        PatchUInt32(snapshot, c_totalSizeOffset, CheckedSize(snapshot.size()));
+
+        return snapshot;
+    }
+
+private:
+    void WriteCard(const AdaptiveCard& card)
+    {
+        WriteString(card.GetVersion());
+        WriteString(card.GetFallbackText());
+        WriteString(card.GetSpeak());
+        WriteString(card.GetLanguage());
+        WriteBackgroundImage(card.GetBackgroundImage().get());
+        WriteRefresh(card.GetRefresh().get());
+        WriteAuthentication(card.GetAuthentication().get());
+        WriteEnum(card.GetStyle());
+        WriteEnum(card.GetVerticalContentAlignment());
+        WriteEnum(card.GetHeight());
+        WriteUInt32(card.GetMinHeight());
+        WriteOptional(card.GetRtl());
+        WriteElements(card.GetBody());
+        WriteActions(card.GetActions());
+        WriteAction(card.GetSelectAction().get());
+        WriteJson(card.GetAdditionalProperties());
+    }
+
+    void WriteBackgroundImage(const BackgroundImage* backgroundImage)
+    {
+        WriteBool(backgroundImage != nullptr);
+        if (backgroundImage)
+        {
+            WriteString(backgroundImage->GetUrl());
+            WriteEnum(backgroundImage->GetFillMode());
+            WriteEnum(backgroundImage->GetHorizontalAlignment());
+            WriteEnum(backgroundImage->GetVerticalAlignment());
+        }
+    }
+
+    void WriteRefresh(Refresh* refresh)
+    {
+        WriteBool(refresh != nullptr);
+        if (refresh)
+        {
+            WriteAction(refresh->GetAction().get());
+            WriteCount(refresh->GetUserIds().size());
+            for (const auto& userId : refresh->GetUserIds())
+            {
+                WriteString(userId);
+            }
+        }
+    }
+
+    void WriteAuthentication(Authentication* authentication)
+    {
+        WriteBool(authentication != nullptr);
+        if (authentication)
+        {
+            WriteString(authentication->GetText());
+            WriteString(authentication->GetConnectionName());
+
+            const auto tokenExchangeResource = authentication->GetTokenExchangeResource();
+            WriteBool(tokenExchangeResource != nullptr);
+            if (tokenExchangeResource)
+            {
+                WriteString(tokenExchangeResource->GetId());
+                WriteString(tokenExchangeResource->GetUri());
+                WriteString(tokenExchangeResource->GetProviderId());
+            }
+
+            WriteCount(authentication->GetButtons().size());
+            for (const auto& button : authentication->GetButtons())
+            {
+                WriteString(button->GetType());
+                WriteString(button->GetTitle());
+                WriteString(button->GetImage());
+                WriteString(button->GetValue());
+            }
+        }
+    }
+
+    template <typename T>
+    void WriteElements(const std::vector<std::shared_ptr<T>>& elements)
+    {
+        WriteCount(elements.size());
+        for (const auto& element : elements)
+        {
+            WriteElement(element.get());
+        }
+    }
+
+    void WriteActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions)
+    {
+        WriteCount(actions.size());
+        for (const auto& action : actions)
+        {
+            WriteAction(action.get());
+        }
+    }
+
+    void WriteBase(const BaseElement& element, bool isAction)
+    {
+        WriteString(element.GetElementTypeString());
+        WriteString(element.GetId());
+        WriteJson(element.GetAdditionalProperties());
+
+        const auto& requirements = element.GetRequirements();
+        WriteCount(requirements.size());
+        for (const auto& requirement : requirements)
+        {
+            WriteString(requirement.first);
+            WriteString(static_cast<std::string>(requirement.second));
+        }
+
+        WriteEnum(element.GetFallbackType());
+        if (element.GetFallbackType() == FallbackType::Content)
+        {
+            const auto& fallbackContent = element.GetFallbackContent();
+            if (isAction)
+            {
+                WriteAction(dynamic_cast<BaseActionElement*>(fallbackContent.get()));
+            }
+            else
+            {
+                WriteElement(dynamic_cast<BaseCardElement*>(fallbackContent.get()));
+            }
+        }
+    }
+
+    void WriteElement(BaseCardElement* element)
+    {
+        if (element == nullptr)
+        {
+            WriteByte(c_absent);
+            return;
+        }
+
+        const CardElementType recordType = GetRecordType(*element);
+        WriteEnum(recordType);
+        if (recordType == CardElementType::Custom)
+        {
+            WriteJson(element->SerializeToJsonValue());
+            return;
+        }
+
+        WriteBase(*element, false);
+        WriteEnum(element->GetSpacing());
+        WriteEnum(element->GetHeight());
+        WriteBool(element->GetSeparator());
+        WriteBool(element->GetIsVisible());
+
+        switch (recordType)
+        {
+        case CardElementType::ActionSet:
+            WriteActions(static_cast<ActionSet&>(*element).GetActions());
+            break;
+        case CardElementType::ChoiceSetInput:
+            WriteChoiceSetInput(static_cast<ChoiceSetInput&>(*element));
+            break;
+        case CardElementType::Column:
+        {
+            auto& column = static_cast<Column&>(*element);
+            WriteString(column.GetWidth());
+            WriteOptional(column.GetRtl());
+            WriteStyledCollection(column);
+            WriteElements(column.GetItems());
+            WriteAction(column.GetSelectAction().get());
+            break;
+        }
+        case CardElementType::ColumnSet:
+        {
+            auto& columnSet = static_cast<ColumnSet&>(*element);
+            WriteStyledCollection(columnSet);
+            WriteElements(columnSet.GetColumns());
+            WriteAction(columnSet.GetSelectAction().get());
+            break;
+        }
+        case CardElementType::Container:
+        case CardElementType::TableCell:
+        {
+            auto& container = static_cast<Container&>(*element);
+            WriteOptional(container.GetRtl());
+            WriteStyledCollection(container);
+            WriteElements(container.GetItems());
+            WriteAction(container.GetSelectAction().get());
+            break;
+        }
+        case CardElementType::DateInput:
+        {
+            auto& dateInput = static_cast<DateInput&>(*element);
+            WriteInput(dateInput);
+            WriteString(dateInput.GetMax());
+            WriteString(dateInput.GetMin());
+            WriteString(dateInput.GetPlaceholder());
+            WriteString(dateInput.GetValue());
+            break;
+        }
+        case CardElementType::FactSet:
+            WriteFactSet(static_cast<FactSet&>(*element));
+            break;
+        case CardElementType::Image:
+            WriteImage(static_cast<Image&>(*element));
+            break;
+        case CardElementType::ImageSet:
+        {
+            auto& imageSet = static_cast<ImageSet&>(*element);
+            WriteEnum(imageSet.GetImageSize());
+            WriteElements(imageSet.GetImages());
+            break;
+        }
+        case CardElementType::Media:
+            WriteMedia(static_cast<Media&>(*element));
+            break;
+        case CardElementType::NumberInput:
+        {
+            auto& numberInput = static_cast<NumberInput&>(*element);
+            WriteInput(numberInput);
+            WriteString(numberInput.GetPlaceholder());
+            WriteOptional(numberInput.GetValue());
+            WriteOptional(numberInput.GetMax());
+            WriteOptional(numberInput.GetMin());
+            break;
+        }
+        case CardElementType::RichTextBlock:
+            WriteRichTextBlock(static_cast<RichTextBlock&>(*element));
+            break;
+        case CardElementType::Table:
+            WriteTable(static_cast<Table&>(*element));
+            break;
+        case CardElementType::TableRow:
+        {
+            auto& tableRow = static_cast<TableRow&>(*element);
+            WriteOptionalEnum(tableRow.GetHorizontalCellContentAlignment());
+            WriteOptionalEnum(tableRow.GetVerticalCellContentAlignment());
+            WriteEnum(tableRow.GetStyle());
+            WriteElements(tableRow.GetCells());
+            break;
+        }
+        case CardElementType::TextBlock:
+        {
+            auto& textBlock = static_cast<TextBlock&>(*element);
+            WriteString(textBlock.GetText());
+            WriteOptionalEnum(textBlock.GetTextSize());
+            WriteOptionalEnum(textBlock.GetTextWeight());
+            WriteOptionalEnum(textBlock.GetFontType());
+            WriteOptionalEnum(textBlock.GetTextColor());
+            WriteOptional(textBlock.GetIsSubtle());
+            WriteString(textBlock.GetLanguage());
+            WriteOptionalEnum(textBlock.GetStyle());
+            WriteBool(textBlock.GetWrap());
+            WriteUInt32(textBlock.GetMaxLines());
+            WriteOptionalEnum(textBlock.GetHorizontalAlignment());
+            break;
+        }
+        case CardElementType::TextInput:
+            WriteTextInput(static_cast<TextInput&>(*element));
+            break;
+        case CardElementType::TimeInput:
+        {
+            auto& timeInput = static_cast<TimeInput&>(*element);
+            WriteInput(timeInput);
+            WriteString(timeInput.GetMax());
+            WriteString(timeInput.GetMin());
+            WriteString(timeInput.GetPlaceholder());
+            WriteString(timeInput.GetValue());
+            break;
+        }
+        case CardElementType::ToggleInput:
+        {
+            auto& toggleInput = static_cast<ToggleInput&>(*element);
+            WriteInput(toggleInput);
+            WriteString(toggleInput.GetTitle());
+            WriteString(toggleInput.GetValue());
+            WriteString(toggleInput.GetValueOff());
+            WriteString(toggleInput.GetValueOn());
+            WriteBool(toggleInput.GetWrap());
+            break;
+        }
+        default:
+            // CardElementType::Unknown -- everything is in the additional properties
+            break;
+        }
+    }
+
+    // The properties of a StyledCollectionElement that come before its children
+    void WriteStyledCollection(const StyledCollectionElement& collection)
+    {
+        WriteBackgroundImage(collection.GetBackgroundImage().get());
+        WriteEnum(collection.GetStyle());
+        WriteOptionalEnum(collection.GetVerticalContentAlignment());
+        WriteBool(collection.GetBleed());
+        WriteUInt32(collection.GetMinHeight());
+    }
+
+    void WriteInput(const BaseInputElement& input)
+    {
+        WriteString(input.GetLabel());
+        WriteBool(input.GetIsRequired());
+        WriteString(input.GetErrorMessage());
+    }
+
+    void WriteChoiceSetInput(ChoiceSetInput& choiceSet)
+    {
+        WriteInput(choiceSet);
+        WriteEnum(choiceSet.GetChoiceSetStyle());
+        WriteBool(choiceSet.GetIsMultiSelect());
+        WriteString(choiceSet.GetValue());
+        WriteBool(choiceSet.GetWrap());
+        WriteString(choiceSet.GetPlaceholder());
+        WriteCount(choiceSet.GetChoices().size());
+        for (const auto& choice : choiceSet.GetChoices())
+        {
+            WriteString(choice->GetTitle());
+            WriteString(choice->GetValue());
+        }
+    }
+
+    void WriteFactSet(FactSet& factSet)
+    {
+        WriteCount(factSet.GetFacts().size());
+        for (const auto& fact : factSet.GetFacts())
+        {
+            WriteString(fact->GetTitle());
+            WriteString(fact->GetValue());
+            WriteString(fact->GetLanguage());
+        }
+    }
+
+    void WriteImage(const Image& image)
+    {
+        WriteString(image.GetUrl());
+        WriteString(image.GetBackgroundColor());
+        WriteEnum(image.GetImageStyle());
+        WriteEnum(image.GetImageSize());
+        WriteString(image.GetAltText());
+        WriteOptionalEnum(image.GetHorizontalAlignment());
+        WriteUInt32(image.GetPixelWidth());
+        WriteUInt32(image.GetPixelHeight());
+        WriteAction(image.GetSelectAction().get());
+    }
+
+    void WriteMedia(Media& media)
+    {
+        WriteString(media.GetPoster());
+        WriteString(media.GetAltText());
+        WriteCount(media.GetSources().size());
+        for (const auto& source : media.GetSources())
+        {
+            WriteString(source->GetMimeType());
+            WriteString(source->GetUrl());
+        }
+    }
+
+    void WriteRichTextBlock(const RichTextBlock& richTextBlock)
+    {
+        WriteOptionalEnum(richTextBlock.GetHorizontalAlignment());
+        WriteCount(richTextBlock.GetInlines().size());
+        for (const auto& inlineElement : richTextBlock.GetInlines())
+        {
+            if (typeid(*inlineElement) != typeid(TextRun))
+            {
+                WriteByte(c_customInline);
+                WriteJson(inlineElement->SerializeToJsonValue());
+                continue;
+            }
+
+            const auto& textRun = static_cast<const TextRun&>(*inlineElement);
+            WriteEnum(InlineElementType::TextRun);
+            WriteString(textRun.GetText());
+            WriteOptionalEnum(textRun.GetTextSize());
+            WriteOptionalEnum(textRun.GetTextWeight());
+            WriteOptionalEnum(textRun.GetFontType());
+            WriteOptionalEnum(textRun.GetTextColor());
+            WriteOptional(textRun.GetIsSubtle());
+            WriteString(textRun.GetLanguage());
+            WriteBool(textRun.GetItalic());
+            WriteBool(textRun.GetStrikethrough());
+            WriteBool(textRun.GetUnderline());
+            WriteBool(textRun.GetHighlight());
+            WriteAction(textRun.GetSelectAction().get());
+            WriteJson(textRun.GetAdditionalProperties());
+        }
+    }
+
+    void WriteTable(const Table& table)
+    {
+        WriteCount(table.GetColumns().size());
+        for (const auto& column : table.GetColumns())
+        {
+            WriteOptionalEnum(column->GetHorizontalCellContentAlignment());
+            WriteOptionalEnum(column->GetVerticalCellContentAlignment());
+            WriteOptional(column->GetWidth());
+            WriteOptional(column->GetPixelWidth());
+        }
+        WriteBool(table.GetShowGridLines());
+        WriteEnum(table.GetGridStyle());
+        WriteBool(table.GetFirstRowAsHeaders());
+        WriteOptionalEnum(table.GetHorizontalCellContentAlignment());
+        WriteOptionalEnum(table.GetVerticalCellContentAlignment());
+        WriteElements(table.GetRows());
+    }
+
+    void WriteTextInput(const TextInput& textInput)
+    {
+        WriteInput(textInput);
+        WriteString(textInput.GetPlaceholder());
+        WriteString(textInput.GetValue());
+        WriteBool(textInput.GetIsMultiline());
+        WriteUInt32(textInput.GetMaxLength());
+        WriteEnum(textInput.GetTextInputStyle());
+        WriteString(textInput.GetRegex());
+        WriteAction(textInput.GetInlineAction().get());
+    }
+
+    void WriteAction(BaseActionElement* action)
+    {
+        if (action == nullptr)
+        {
+            WriteByte(c_absent);
+            return;
+        }
+
+        const ActionType recordType = GetRecordType(*action);
+        WriteEnum(recordType);
+        if (recordType == ActionType::Custom)
+        {
+            WriteJson(action->SerializeToJsonValue());
+            return;
+        }
+
+        WriteBase(*action, true);
+        WriteString(action->GetTitle());
+        WriteString(action->GetIconUrl());
+        WriteString(action->GetStyle());
+        WriteString(action->GetTooltip());
+        WriteBool(action->GetIsEnabled());
+        WriteEnum(action->GetMode());
+
+        switch (recordType)
+        {
+        case ActionType::Execute:
+        {
+            const auto& executeAction = static_cast<const ExecuteAction&>(*action);
+            WriteJson(executeAction.GetDataJsonAsValue());
+            WriteString(executeAction.GetVerb());
+            WriteEnum(executeAction.GetAssociatedInputs());
+            break;
+        }
+        case ActionType::OpenUrl:
+            WriteString(static_cast<const OpenUrlAction&>(*action).GetUrl());
+            break;
+        case ActionType::ShowCard:
+        {
+            const auto card = static_cast<const ShowCardAction&>(*action).GetCard();
+            WriteBool(card != nullptr);
+            if (card)
+            {
+                WriteCard(*card);
+            }
+            break;
+        }
+        case ActionType::Submit:
+        {
+            const auto& submitAction = static_cast<const SubmitAction&>(*action);
+            WriteJson(submitAction.GetDataJsonAsValue());
+            WriteEnum(submitAction.GetAssociatedInputs());
+            break;
+        }
+        case ActionType::ToggleVisibility:
+        {
+            const auto& targets = static_cast<const ToggleVisibilityAction&>(*action).GetTargetElements();
+            WriteCount(targets.size());
+            for (const auto& target : targets)
+            {
+                WriteString(target->GetElementId());
+                WriteEnum(target->GetIsVisible());
+            }
+            break;
+        }
+        default:
+            // ActionType::UnknownAction -- everything is in the additional properties
+            break;
+        }
+    }
+
+    void WriteJson(const Json::Value& json)
+    {
+        switch (json.type())
+        {
+        case Json::nullValue:
+            WriteByte(JsonTag::Null);
+            break;
+        case Json::booleanValue:
+            WriteByte(json.asBool() ? JsonTag::True : JsonTag::False);
+            break;
+        case Json::intValue:
+            WriteByte(JsonTag::Int);
+            WriteUInt64(static_cast<uint64_t>(json.asLargestInt()));
+            break;
+        case Json::uintValue:
+            WriteByte(JsonTag::UInt);
+            WriteUInt64(json.asLargestUInt());
+            break;
+        case Json::realValue:
+        {
+            WriteByte(JsonTag::Real);
+            WriteDouble(json.asDouble());
+            break;
+        }
+        case Json::stringValue:
+        {
+            const char* begin = "";
+            const char* end = begin;
+            json.getString(&begin, &end);
+            WriteByte(JsonTag::String);
+            WriteString(std::string(begin, end));
+            break;
+        }
+        case Json::arrayValue:
+            WriteByte(JsonTag::Array);
+            WriteCount(json.size());
+            for (const auto& item : json)
+            {
+                WriteJson(item);
+            }
+            break;
+        case Json::objectValue:
+            WriteByte(JsonTag::Object);
+            WriteCount(json.size());
+            for (auto member = json.begin(); member != json.end(); ++member)
+            {
+                const char* nameEnd;
+                const char* name = member.memberName(&nameEnd);
+                WriteString(std::string(name, nameEnd));
+                WriteJson(*member);
+            }
+            break;
+        }
+    }
+
+    void WriteString(const std::string& string)
+    {
+        const auto added = m_stringIndices.emplace(string, static_cast<uint32_t>(m_strings.size()));
+        if (added.second)
+        {
+            // map nodes don't move, so the key stays put for the string table
+            m_strings.push_back(&added.first->first);
+        }
+        WriteUInt32(added.first->second);
+    }
+
+    template <typename T>
+    void WriteEnum(T value)
+    {
+        WriteByte(static_cast<uint8_t>(value));
+    }
+
+    template <typename T>
+    void WriteOptionalEnum(const std::optional<T>& value)
+    {
+        WriteByte(value.has_value() ? static_cast<uint8_t>(*value) : c_absent);
+    }
+
+    void WriteOptional(const std::optional<bool>& value)
+    {
+        WriteByte(value.has_value() ? static_cast<uint8_t>(*value) : c_absent);
+    }
+
+    void WriteOptional(const std::optional<unsigned int>& value)
+    {
+        WriteBool(value.has_value());
+        if (value.has_value())
+        {
+            WriteUInt32(*value);
+        }
+    }
+
+    void WriteOptional(const std::optional<double>& value)
+    {
+        WriteBool(value.has_value());
+        if (value.has_value())
+        {
+            WriteDouble(*value);
+        }
+    }
+
+    void WriteBool(bool value)
+    {
+        WriteByte(value ? 1 : 0);
+    }
+
+    void WriteCount(size_t count)
+    {
+        WriteUInt32(CheckedSize(count));
+    }
+
+    void WriteDouble(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        WriteUInt64(bits);
+    }
+
+    void WriteByte(uint8_t value)
+    {
+        m_records.push_back(value);
+    }
+
+    void WriteUInt32(uint32_t value)
+    {
+        AppendUInt32(m_records, value);
+    }
+
+    void WriteUInt64(uint64_t value)
+    {
+        for (unsigned int shift = 0; shift < 64; shift += 8)
+        {
+            m_records.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    static uint32_t CheckedSize(uint64_t value)
+    {
+        if (value > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::length_error("Card is too large for a snapshot");
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    static void AppendUInt32(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        for (unsigned int shift = 0; shift < 32; shift += 8)
+        {
+            buffer.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    static void PatchUInt16(std::vector<uint8_t>& buffer, uint32_t offset, uint16_t value)
+    {
+        buffer[offset] = static_cast<uint8_t>(value);
+        buffer[offset + 1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    static void PatchUInt32(std::vector<uint8_t>& buffer, uint32_t offset, uint32_t value)
+    {
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            buffer[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    std::vector<uint8_t> m_records;
+    std::vector<const std::string*> m_strings;
+    std::unordered_map<std::string, uint32_t> m_stringIndices;
+};
+} // namespace
+
+namespace AdaptiveCards
+{
+// Builds a card from a snapshot's records, doing to the context what parsing the card does to it: each element gets
+// the next InternalId, and container styles, bleed, and fallback to ancestors are worked out as the parsers work them
+// out. It's a friend of the few classes whose parse-time state can't be set through their public setters (e.g.
+// TextBlock, whose SetText() would decode HTML entities a second time).
+class CardSnapshotReader
+{
+public:
+    CardSnapshotReader(const void* data, size_t size) :
+        m_data(static_cast<const uint8_t*>(data)), m_size(0), m_position(0), m_stringCount(0), m_stringTableOffset(0), m_depth(0)
+    {
+        if (data == nullptr || size < c_headerSize || !std::equal(std::begin(c_magic), std::end(c_magic), m_data))
+        {
+            ThrowInvalidSnapshot("missing header");
+        }
+
+        // read the size first so that the reads below are checked against it
+        m_size = c_headerSize;
+        m_position = c_versionOffset;
+        if (ReadUInt16() != CardSnapshot::FormatVersion)
+        {
+            ThrowInvalidSnapshot("unsupported format version");
+        }
+
+        m_position = c_totalSizeOffset;
+        const uint32_t totalSize = ReadUInt32();
+        if (totalSize < c_headerSize || totalSize > size)
+        {
+            ThrowInvalidSnapshot("truncated");
+        }
+        m_size = totalSize;
+
+        m_position = c_stringCountOffset;
+        m_stringCount = ReadUInt32();
+        m_stringTableOffset = ReadUInt32();
+        if (m_stringTableOffset < c_headerSize || uint64_t{m_stringTableOffset} + 8 * uint64_t{m_stringCount} > m_size)
+        {
+            ThrowInvalidSnapshot("string table out of bounds");
+        }
+
+        m_position = c_cardOffsetOffset;
+        const uint32_t cardOffset = ReadUInt32();
+        if (cardOffset < c_headerSize || cardOffset >= m_size)
+        {
+            ThrowInvalidSnapshot("card out of bounds");
+        }
+        m_position = cardOffset;
+    }
+
+    std::shared_ptr<ParseResult> Load(const std::string& rendererVersion, ParseContext& context)
+    {
+        const ParseContext::DeserializeScope deserializeScope(context);
+
+        auto card = ReadCard(context, rendererVersion);
+        return std::make_shared<ParseResult>(card, context.warnings, context.GetArena(), context.m_statistics);
+    }
+
+private:
+    std::shared_ptr<AdaptiveCard> ReadCard(ParseContext& context, const std::string& rendererVersion)
+    {
+        std::string version = ReadString();
+        std::string fallbackText = ReadString();
+        std::string speak = ReadString();
+        std::string language = ReadString();
+
+        if (language.size())
+        {
+            context.SetLanguage(language);
+        }
+        else
+        {
+            language = context.GetLanguage();
+        }
+
+        // the same check AdaptiveCard::Deserialize() makes
+        if (!rendererVersion.empty())
+        {
+            if (version.empty())
+            {
+                throw AdaptiveCardParseException(
+                    ErrorStatusCode::RequiredPropertyMissing,
+                    "Property is required but was found empty: " + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Version));
+            }
+
+            if (SemanticVersion(rendererVersion) < SemanticVersion(version))
+            {
+                if (fallbackText.empty())
+                {
+                    fallbackText = "We're sorry, this card couldn't be displayed";
+                }
+
+                if (speak.empty())
+                {
+                    speak = fallbackText;
+                }
+
+                context.warnings.push_back(std::make_shared<AdaptiveCardParseWarning>(
+                    AdaptiveCards::WarningStatusCode::UnsupportedSchemaVersion, "Schema version not supported"));
+                return AdaptiveCard::MakeFallbackTextCard(fallbackText, language, speak);
+            }
+        }
+
+        auto backgroundImage = ReadBackgroundImage();
+        auto refresh = ReadRefresh(context);
+        auto authentication = ReadAuthentication(context);
+
+        const ContainerStyle style = ReadEnum(ContainerStyle::Accent);
+        context.SetParentalContainerStyle(style);
+
+        const VerticalContentAlignment verticalContentAlignment = ReadEnum(VerticalContentAlignment::Bottom);
+        const HeightType height = ReadEnum(HeightType::Stretch);
+        const unsigned int minHeight = ReadUInt32();
+        const std::optional<bool> rtl = ReadOptionalBool();
+
+        auto body = ReadElementCollection<BaseCardElement>(context, true);
+        auto actions = ReadActions(context);
+
+        auto card = context.MakeShared<AdaptiveCard>(
+            version, fallbackText, backgroundImage, refresh, authentication, style, speak, language, verticalContentAlignment, height, minHeight, body, actions);
+        card->SetRtl(rtl);
+        card->SetSelectAction(ReadAction(context));
+        card->SetAdditionalProperties(ReadJson());
+
+        return card;
+    }
+
+    std::shared_ptr<BackgroundImage> ReadBackgroundImage()
+    {
+        if (!ReadBool())
+        {
+            return nullptr;
+        }
+
+        auto backgroundImage = std::make_shared<BackgroundImage>();
+        backgroundImage->SetUrl(ReadString());
+        backgroundImage->SetFillMode(ReadEnum(ImageFillMode::Repeat));
+        backgroundImage->SetHorizontalAlignment(ReadEnum(HorizontalAlignment::Right));
+        backgroundImage->SetVerticalAlignment(ReadEnum(VerticalAlignment::Bottom));
+        return backgroundImage;
+    }
+
+    std::shared_ptr<Refresh> ReadRefresh(ParseContext& context)
+    {
+        if (!ReadBool())
+        {
+            return nullptr;
+        }
+
+        auto refresh = context.MakeShared<Refresh>();
+        refresh->SetAction(ReadAction(context));
+
+        const uint32_t userIdCount = ReadCount();
+        auto& userIds = refresh->GetUserIds();
+        userIds.reserve(userIdCount);
+        for (uint32_t index = 0; index < userIdCount; ++index)
+        {
+            userIds.push_back(ReadString());
+        }
+        return refresh;
+    }
+
+    std::shared_ptr<Authentication> ReadAuthentication(ParseContext& context)
+    {
+        if (!ReadBool())
+        {
+            return nullptr;
+        }
+
+        auto authentication = context.MakeShared<Authentication>();
+        authentication->SetText(ReadString());
+        authentication->SetConnectionName(ReadString());
+
+        if (ReadBool())
+        {
+            auto tokenExchangeResource = context.MakeShared<TokenExchangeResource>();
+            tokenExchangeResource->SetId(ReadString());
+            tokenExchangeResource->SetUri(ReadString());
+            tokenExchangeResource->SetProviderId(ReadString());
+            authentication->SetTokenExchangeResource(tokenExchangeResource);
+        }
+
+        const uint32_t buttonCount = ReadCount();
+        auto& buttons = authentication->GetButtons();
+        buttons.reserve(buttonCount);
+        for (uint32_t index = 0; index < buttonCount; ++index)
+        {
+            auto button = context.MakeShared<AuthCardButton>();
+            button->SetType(ReadString());
+            button->SetTitle(ReadString());
+            button->SetImage(ReadString());
+            button->SetValue(ReadString());
+            buttons.push_back(std::move(button));
+        }
+        return authentication;
+    }
+
+    // A collection whose members can bleed (see ParseUtil::GetElementCollection())
+    template <typename T>
+    std::vector<std::shared_ptr<T>> ReadElementCollection(ParseContext& context, bool isTopToBottomContainer)
+    {
+        const uint32_t count = ReadCount();
+        std::vector<std::shared_ptr<T>> elements;
+        elements.reserve(count);
+
+        const ContainerBleedDirection previousBleedState = context.GetBleedDirection();
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            ContainerBleedDirection currentBleedState = previousBleedState;
+            if (index != 0)
+            {
+                currentBleedState &= isTopToBottomContainer ? ~ContainerBleedDirection::BleedUp : ~ContainerBleedDirection::BleedLeft;
+            }
+            if (index != (count - 1))
+            {
+                currentBleedState &= isTopToBottomContainer ? ~ContainerBleedDirection::BleedDown : ~ContainerBleedDirection::BleedRight;
+            }
+
+            context.PushBleedDirection(currentBleedState);
+            elements.push_back(ReadElementOfType<T>(context));
+            context.PopBleedDirection();
+        }
+        return elements;
+    }
+
+    // A collection whose members can't bleed, e.g. a Table's rows
+    template <typename T>
+    std::vector<std::shared_ptr<T>> ReadElementList(ParseContext& context)
+    {
+        const uint32_t count = ReadCount();
+        std::vector<std::shared_ptr<T>> elements;
+        elements.reserve(count);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            elements.push_back(ReadElementOfType<T>(context));
+        }
+        return elements;
+    }
+
+    template <typename T>
+    std::shared_ptr<T> ReadElementOfType(ParseContext& context)
+    {
+        auto element = ReadElement(context);
+        auto typedElement = std::dynamic_pointer_cast<T>(element);
+        if (element && !typedElement)
+        {
+            ThrowInvalidSnapshot("unexpected element type");
+        }
+        return typedElement;
+    }
+
+    std::vector<std::shared_ptr<BaseActionElement>> ReadActions(ParseContext& context)
+    {
+        const uint32_t count = ReadCount();
+        std::vector<std::shared_ptr<BaseActionElement>> actions;
+        actions.reserve(count);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            actions.push_back(ReadAction(context));
+        }
+        return actions;
+    }
+
+    void ReadBase(ParseContext& context, BaseElement& element, bool isAction)
+    {
+        element.SetElementTypeString(ReadString());
+        element.SetId(ReadString());
+        element.SetAdditionalProperties(ReadJson());
+
+        const uint32_t requirementCount = ReadCount();
+        auto& requirements = element.GetRequirements();
+        for (uint32_t index = 0; index < requirementCount; ++index)
+        {
+            std::string name = ReadString();
+            requirements.emplace(std::move(name), SemanticVersion(ReadString()));
+        }
+
+        const FallbackType fallbackType = ReadEnum(FallbackType::Content);
+        element.SetFallbackType(fallbackType);
+        if (fallbackType == FallbackType::Content)
+        {
+            if (isAction)
+            {
+                element.SetFallbackContent(ReadAction(context));
+            }
+            else
+            {
+                element.SetFallbackContent(ReadElement(context));
+            }
+        }
+    }
+
+    // Every element is created the way its parser wrapper creates it (see BaseCardElementParserWrapper), with the
+    // properties every element has
+    template <typename T>
+    std::shared_ptr<T> MakeElement(ParseContext& context)
+    {
+        InternalId::Next();
+        auto element = context.MakeShared<T>();
+
+        ReadBase(context, *element, false);
+        element->SetCanFallbackToAncestor(context.GetCanFallbackToAncestor());
+        element->SetSpacing(ReadEnum(Spacing::Padding));
+        element->SetHeight(ReadEnum(HeightType::Stretch));
+        element->SetSeparator(ReadBool());
+        element->SetIsVisible(ReadBool());
+        return element;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadElement(ParseContext& context)
+    {
+        const uint8_t recordType = ReadByte();
+        if (recordType == c_absent)
+        {
+            return nullptr;
+        }
+
+        if (++m_depth > c_maxDepth)
+        {
+            ThrowInvalidSnapshot("elements are nested too deeply");
+        }
+
+        std::shared_ptr<BaseCardElement> element;
+        switch (static_cast<CardElementType>(recordType))
+        {
+        case CardElementType::ActionSet:
+        {
+            auto actionSet = MakeElement<ActionSet>(context);
+            actionSet->GetActions() = ReadActions(context);
+            element = std::move(actionSet);
+            break;
+        }
+        case CardElementType::ChoiceSetInput:
+            element = ReadChoiceSetInput(context);
+            break;
+        case CardElementType::Column:
+        {
+            auto column = MakeElement<Column>(context);
+            column->SetWidth(ReadString());
+            column->SetRtl(ReadOptionalBool());
+            ReadStyledCollection(context, *column, [&]() {
+                column->GetItems() = ReadElementCollection<BaseCardElement>(context, true);
+            });
+            element = std::move(column);
+            break;
+        }
+        case CardElementType::ColumnSet:
+        {
+            auto columnSet = MakeElement<ColumnSet>(context);
+            ReadStyledCollection(context, *columnSet, [&]() {
+                columnSet->GetColumns() = ReadElementCollection<Column>(context, false);
+            });
+            element = std::move(columnSet);
+            break;
+        }
+        case CardElementType::Container:
+            element = ReadContainer<Container>(context);
+            break;
+        case CardElementType::Custom:
+        {
+            std::shared_ptr<BaseElement> customElement;
+            BaseCardElement::ParseJsonObject(context, ReadJson(), customElement);
+            element = std::static_pointer_cast<BaseCardElement>(customElement);
+            break;
+        }
+        case CardElementType::DateInput:
+        {
+            auto dateInput = MakeInput<DateInput>(context);
+            dateInput->SetMax(ReadString());
+            dateInput->SetMin(ReadString());
+            dateInput->SetPlaceholder(ReadString());
+            dateInput->SetValue(ReadString());
+            element = std::move(dateInput);
+            break;
+        }
+        case CardElementType::FactSet:
+            element = ReadFactSet(context);
+            break;
+        case CardElementType::Image:
+            element = ReadImage(context);
+            break;
+        case CardElementType::ImageSet:
+        {
+            auto imageSet = MakeElement<ImageSet>(context);
+            imageSet->SetImageSize(ReadEnum(ImageSize::Large));
+            imageSet->GetImages() = ReadElementCollection<Image>(context, true);
+            element = std::move(imageSet);
+            break;
+        }
+        case CardElementType::Media:
+            element = ReadMedia(context);
+            break;
+        case CardElementType::NumberInput:
+        {
+            auto numberInput = MakeInput<NumberInput>(context);
+            numberInput->SetPlaceholder(ReadString());
+            numberInput->SetValue(ReadOptionalDouble());
+            numberInput->SetMax(ReadOptionalDouble());
+            numberInput->SetMin(ReadOptionalDouble());
+            element = std::move(numberInput);
+            break;
+        }
+        case CardElementType::RichTextBlock:
+            element = ReadRichTextBlock(context);
+            break;
+        case CardElementType::Table:
+            element = ReadTable(context);
+            break;
+        case CardElementType::TableCell:
+            element = ReadContainer<TableCell>(context);
+            break;
+        case CardElementType::TableRow:
+        {
+            auto tableRow = MakeElement<TableRow>(context);
+            tableRow->SetHorizontalCellContentAlignment(ReadOptionalEnum(HorizontalAlignment::Right));
+            tableRow->SetVerticalCellContentAlignment(ReadOptionalEnum(VerticalContentAlignment::Bottom));
+            tableRow->SetStyle(ReadEnum(ContainerStyle::Accent));
+            tableRow->GetCells() = ReadElementList<TableCell>(context);
+            element = std::move(tableRow);
+            break;
+        }
+        case CardElementType::TextBlock:
+        {
+            auto textBlock = MakeElement<TextBlock>(context);
+            ReadTextElementProperties(*textBlock->m_textElementProperties);
+            textBlock->SetStyle(ReadOptionalEnum(TextStyle::Heading));
+            textBlock->SetWrap(ReadBool());
+            textBlock->SetMaxLines(ReadUInt32());
+            textBlock->SetHorizontalAlignment(ReadOptionalEnum(HorizontalAlignment::Right));
+            element = std::move(textBlock);
+            break;
+        }
+        case CardElementType::TextInput:
+            element = ReadTextInput(context);
+            break;
+        case CardElementType::TimeInput:
+        {
+            auto timeInput = MakeInput<TimeInput>(context);
+            timeInput->SetMax(ReadString());
+            timeInput->SetMin(ReadString());
+            timeInput->SetPlaceholder(ReadString());
+            timeInput->SetValue(ReadString());
+            element = std::move(timeInput);
+            break;
+        }
+        case CardElementType::ToggleInput:
+        {
+            auto toggleInput = MakeInput<ToggleInput>(context);
+            toggleInput->SetTitle(ReadString());
+            toggleInput->SetValue(ReadString());
+            toggleInput->SetValueOff(ReadString());
+            toggleInput->SetValueOn(ReadString());
+            toggleInput->SetWrap(ReadBool());
+            element = std::move(toggleInput);
+            break;
+        }
+        case CardElementType::Unknown:
+            element = MakeElement<UnknownElement>(context);
+            break;
+        default:
+            ThrowInvalidSnapshot("unknown element type");
+        }
+
+        --m_depth;
+        return element;
+    }
+
+    // The rest of a StyledCollectionElement, as StyledCollectionElement::Deserialize() handles it
+    template <typename T, typename ReadChildren>
+    void ReadStyledCollection(ParseContext& context, T& collection, ReadChildren readChildren)
+    {
+        collection.SetBackgroundImage(ReadBackgroundImage());
+
+        const bool canFallbackToAncestor = context.GetCanFallbackToAncestor();
+        context.SetCanFallbackToAncestor(canFallbackToAncestor || (collection.GetFallbackType() != FallbackType::None));
+
+        collection.SetStyle(ReadEnum(ContainerStyle::Accent));
+        collection.SetVerticalContentAlignment(ReadOptionalEnum(VerticalContentAlignment::Bottom));
+        collection.SetBleed(ReadBool());
+        collection.SetMinHeight(ReadUInt32());
+
+        collection.ConfigForContainerStyle(context);
+        context.SaveContextForStyledCollectionElement(collection);
+        readChildren();
+        context.RestoreContextForStyledCollectionElement(collection);
+
+        context.SetCanFallbackToAncestor(canFallbackToAncestor);
+
+        collection.SetSelectAction(ReadAction(context));
+    }
+
+    template <typename T>
+    std::shared_ptr<T> ReadContainer(ParseContext& context)
+    {
+        auto container = MakeElement<T>(context);
+        container->SetRtl(ReadOptionalBool());
+        ReadStyledCollection(context, *container, [&]() {
+            container->GetItems() = ReadElementCollection<BaseCardElement>(context, true);
+        });
+        return container;
+    }
+
+    template <typename T>
+    std::shared_ptr<T> MakeInput(ParseContext& context)
+    {
+        auto input = MakeElement<T>(context);
+        input->SetLabel(ReadString());
+        input->SetIsRequired(ReadBool());
+        input->SetErrorMessage(ReadString());
+        return input;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadChoiceSetInput(ParseContext& context)
+    {
+        auto choiceSet = MakeInput<ChoiceSetInput>(context);
+        choiceSet->SetChoiceSetStyle(ReadEnum(ChoiceSetStyle::Filtered));
+        choiceSet->SetIsMultiSelect(ReadBool());
+        choiceSet->SetValue(ReadString());
+        choiceSet->SetWrap(ReadBool());
+        choiceSet->SetPlaceholder(ReadString());
+
+        const uint32_t choiceCount = ReadCount();
+        auto& choices = choiceSet->GetChoices();
+        choices.reserve(choiceCount);
+        for (uint32_t index = 0; index < choiceCount; ++index)
+        {
+            auto choice = context.MakeShared<ChoiceInput>();
+            choice->SetTitle(ReadString());
+            choice->SetValue(ReadString());
+            choices.push_back(std::move(choice));
+        }
+        return choiceSet;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadFactSet(ParseContext& context)
+    {
+        auto factSet = MakeElement<FactSet>(context);
+
+        const uint32_t factCount = ReadCount();
+        auto& facts = factSet->GetFacts();
+        facts.reserve(factCount);
+        for (uint32_t index = 0; index < factCount; ++index)
+        {
+            std::string title = ReadString();
+            std::string value = ReadString();
+            auto fact = context.MakeShared<Fact>(title, value);
+            fact->SetLanguage(ReadString());
+            facts.push_back(std::move(fact));
+        }
+        return factSet;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadImage(ParseContext& context)
+    {
+        auto image = MakeElement<Image>(context);
+        image->SetUrl(ReadString());
+        image->SetBackgroundColor(ReadString());
+        image->SetImageStyle(ReadEnum(ImageStyle::Person));
+        image->SetImageSize(ReadEnum(ImageSize::Large));
+        image->SetAltText(ReadString());
+        image->SetHorizontalAlignment(ReadOptionalEnum(HorizontalAlignment::Right));
+        image->SetPixelWidth(ReadUInt32());
+        image->SetPixelHeight(ReadUInt32());
+        image->SetSelectAction(ReadAction(context));
+        return image;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadMedia(ParseContext& context)
+    {
+        auto media = MakeElement<Media>(context);
+        media->SetPoster(ReadString());
+        media->SetAltText(ReadString());
+
+        const uint32_t sourceCount = ReadCount();
+        auto& sources = media->GetSources();
+        sources.reserve(sourceCount);
+        for (uint32_t index = 0; index < sourceCount; ++index)
+        {
+            auto source = context.MakeShared<MediaSource>();
+            source->SetMimeType(ReadString());
+            source->SetUrl(ReadString());
+            sources.push_back(std::move(source));
+        }
+        return media;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadRichTextBlock(ParseContext& context)
+    {
+        auto richTextBlock = MakeElement<RichTextBlock>(context);
+        richTextBlock->SetHorizontalAlignment(ReadOptionalEnum(HorizontalAlignment::Right));
+
+        const uint32_t inlineCount = ReadCount();
+        auto& inlines = richTextBlock->GetInlines();
+        inlines.reserve(inlineCount);
+        for (uint32_t index = 0; index < inlineCount; ++index)
+        {
+            const uint8_t inlineType = ReadByte();
+            if (inlineType == c_customInline)
+            {
+                inlines.push_back(Inline::Deserialize(context, ReadJson()));
+                continue;
+            }
+            if (inlineType != static_cast<uint8_t>(InlineElementType::TextRun))
+            {
+                ThrowInvalidSnapshot("unknown inline type");
+            }
+
+            auto textRun = context.MakeShared<TextRun>();
+            ReadTextElementProperties(*textRun->m_textElementProperties);
+            textRun->SetItalic(ReadBool());
+            textRun->SetStrikethrough(ReadBool());
+            textRun->SetUnderline(ReadBool());
+            textRun->SetHighlight(ReadBool());
+            textRun->SetSelectAction(ReadAction(context));
+            textRun->SetAdditionalProperties(ReadJson());
+            inlines.push_back(std::move(textRun));
+        }
+        return richTextBlock;
+    }
+
+    // The text is stored as it was after parsing, so it's set as is rather than through SetText()
+    void ReadTextElementProperties(TextElementProperties& properties)
+    {
+        properties.m_text = ReadString();
+        properties.SetTextSize(ReadOptionalEnum(TextSize::ExtraLarge));
+        properties.SetTextWeight(ReadOptionalEnum(TextWeight::Bolder));
+        properties.SetFontType(ReadOptionalEnum(FontType::Monospace));
+        properties.SetTextColor(ReadOptionalEnum(ForegroundColor::Attention));
+        properties.SetIsSubtle(ReadOptionalBool());
+        properties.SetLanguage(ReadString());
+    }
+
+    // As CollectionCoreElement::Deserialize() and TableParser handle it
+    std::shared_ptr<BaseCardElement> ReadTable(ParseContext& context)
+    {
+        auto table = MakeElement<Table>(context);
+
+        const uint32_t columnCount = ReadCount();
+        auto& columns = table->GetColumns();
+        columns.reserve(columnCount);
+        for (uint32_t index = 0; index < columnCount; ++index)
+        {
+            auto column = context.MakeShared<TableColumnDefinition>();
+            column->SetHorizontalCellContentAlignment(ReadOptionalEnum(HorizontalAlignment::Right));
+            column->SetVerticalCellContentAlignment(ReadOptionalEnum(VerticalContentAlignment::Bottom));
+            // SetWidth() and SetPixelWidth() each clear the other, so only set the one that's there
+            const std::optional<unsigned int> width = ReadOptionalUInt32();
+            const std::optional<unsigned int> pixelWidth = ReadOptionalUInt32();
+            if (width.has_value())
+            {
+                column->SetWidth(width);
+            }
+            if (pixelWidth.has_value())
+            {
+                column->SetPixelWidth(pixelWidth);
+            }
+            columns.push_back(std::move(column));
+        }
+
+        table->SetShowGridLines(ReadBool());
+        table->SetGridStyle(ReadEnum(ContainerStyle::Accent));
+        table->SetFirstRowAsHeaders(ReadBool());
+        table->SetHorizontalCellContentAlignment(ReadOptionalEnum(HorizontalAlignment::Right));
+        table->SetVerticalCellContentAlignment(ReadOptionalEnum(VerticalContentAlignment::Bottom));
+
+        const bool canFallbackToAncestor = context.GetCanFallbackToAncestor();
+        context.SetCanFallbackToAncestor(canFallbackToAncestor || (table->GetFallbackType() != FallbackType::None));
+        table->GetRows() = ReadElementList<TableRow>(context);
+        context.SetCanFallbackToAncestor(canFallbackToAncestor);
+
+        return table;
+    }
+
+    std::shared_ptr<BaseCardElement> ReadTextInput(ParseContext& context)
+    {
+        auto textInput = MakeInput<TextInput>(context);
+        textInput->SetPlaceholder(ReadString());
+        textInput->SetValue(ReadString());
+        textInput->SetIsMultiline(ReadBool());
+        textInput->SetMaxLength(ReadUInt32());
+        textInput->SetTextInputStyle(ReadEnum(TextInputStyle::Password));
+        textInput->SetRegex(ReadString());
+        textInput->SetInlineAction(ReadAction(context));
+        return textInput;
+    }
+
+    template <typename T>
+    std::shared_ptr<T> MakeAction(ParseContext& context)
+    {
+        InternalId::Next();
+        auto action = context.MakeShared<T>();
+
+        ReadBase(context, *action, true);
+        action->SetTitle(ReadString());
+        action->SetIconUrl(ReadString());
+        action->SetStyle(ReadString());
+        action->SetTooltip(ReadString());
+        action->SetIsEnabled(ReadBool());
+        action->SetMode(ReadEnum(Mode::Secondary));
+        return action;
+    }
+
+    std::shared_ptr<BaseActionElement> ReadAction(ParseContext& context)
+    {
+        const uint8_t recordType = ReadByte();
+        if (recordType == c_absent)
+        {
+            return nullptr;
+        }
+
+        if (++m_depth > c_maxDepth)
+        {
+            ThrowInvalidSnapshot("elements are nested too deeply");
+        }
+
+        std::shared_ptr<BaseActionElement> action;
+        switch (static_cast<ActionType>(recordType))
+        {
+        case ActionType::Custom:
+            action = ParseUtil::GetActionFromJsonValue(context, ReadJson());
+            break;
+        case ActionType::Execute:
+        {
+            auto executeAction = MakeAction<ExecuteAction>(context);
+            executeAction->SetDataJson(ReadJson());
+            executeAction->SetVerb(ReadString());
+            executeAction->SetAssociatedInputs(ReadEnum(AssociatedInputs::None));
+            action = std::move(executeAction);
+            break;
+        }
+        case ActionType::OpenUrl:
+        {
+            auto openUrlAction = MakeAction<OpenUrlAction>(context);
+            openUrlAction->SetUrl(ReadString());
+            action = std::move(openUrlAction);
+            break;
+        }
+        case ActionType::ShowCard:
+        {
+            auto showCardAction = MakeAction<ShowCardAction>(context);
+            if (ReadBool())
+            {
+                showCardAction->SetCard(ReadCard(context, ""));
+            }
+            action = std::move(showCardAction);
+            break;
+        }
+        case ActionType::Submit:
+        {
+            auto submitAction = MakeAction<SubmitAction>(context);
+            submitAction->SetDataJson(ReadJson());
+            submitAction->SetAssociatedInputs(ReadEnum(AssociatedInputs::None));
+            action = std::move(submitAction);
+            break;
+        }
+        case ActionType::ToggleVisibility:
+        {
+            auto toggleVisibilityAction = MakeAction<ToggleVisibilityAction>(context);
+            const uint32_t targetCount = ReadCount();
+            auto& targets = toggleVisibilityAction->GetTargetElements();
+            targets.reserve(targetCount);
+            for (uint32_t index = 0; index < targetCount; ++index)
+            {
+                auto target = context.MakeShared<ToggleVisibilityTarget>();
+                target->SetElementId(ReadString());
+                target->SetIsVisible(ReadEnum(IsVisibleFalse));
+                targets.push_back(std::move(target));
+            }
+            action = std::move(toggleVisibilityAction);
+            break;
+        }
+        case ActionType::UnknownAction:
+            action = MakeAction<UnknownAction>(context);
+            break;
+        default:
+            ThrowInvalidSnapshot("unknown action type");
+        }
+
+        --m_depth;
+        return action;
+    }
+
+    Json::Value ReadJson()
+    {
+        if (++m_depth > c_maxDepth)
+        {
+            ThrowInvalidSnapshot("values are nested too deeply");
+        }
+
+        Json::Value json;
+        switch (ReadByte())
+        {
+        case JsonTag::Null:
+            break;
+        case JsonTag::False:
+            json = false;
+            break;
+        case JsonTag::True:
+            json = true;
+            break;
+        case JsonTag::Int:
+            json = static_cast<Json::Int64>(ReadUInt64());
+            break;
+        case JsonTag::UInt:
+            json = static_cast<Json::UInt64>(ReadUInt64());
+            break;
+        case JsonTag::Real:
+            json = ReadDouble();
+            break;
+        case JsonTag::String:
+        {
+            const std::string_view string = ReadStringView();
+            json = Json::Value(string.data(), string.data() + string.size());
+            break;
+        }
+        case JsonTag::Array:
+        {
+            json = Json::Value(Json::arrayValue);
+            const uint32_t count = ReadCount();
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                json.append(ReadJson());
+            }
+            break;
+        }
+        case JsonTag::Object:
+        {
+            json = Json::Value(Json::objectValue);
+            const uint32_t count = ReadCount();
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const std::string_view name = ReadStringView();
+                json[std::string(name)] = ReadJson();
+            }
+            break;
+        }
+        default:
+            ThrowInvalidSnapshot("unknown value type");
+        }
+
+        --m_depth;
+        return json;
+    }
+
+    template <typename T>
+    T ReadEnum(T last)
+    {
+        const uint8_t value = ReadByte();
+        if (value > static_cast<uint8_t>(last))
+        {
+            ThrowInvalidSnapshot("enum value out of range");
+        }
+        return static_cast<T>(value);
+    }
+
+    template <typename T>
+    std::optional<T> ReadOptionalEnum(T last)
+    {
+        if (PeekByte() == c_absent)
+        {
+            ++m_position;
+            return std::nullopt;
+        }
+        return ReadEnum(last);
+    }
+
+    std::optional<bool> ReadOptionalBool()
+    {
+        if (PeekByte() == c_absent)
+        {
+            ++m_position;
+            return std::nullopt;
+        }
+        return ReadBool();
+    }
+
+    std::optional<unsigned int> ReadOptionalUInt32()
+    {
+        if (!ReadBool())
+        {
+            return std::nullopt;
+        }
+        return ReadUInt32();
+    }
+
+    std::optional<double> ReadOptionalDouble()
+    {
+        if (!ReadBool())
+        {
+            return std::nullopt;
+        }
+        return ReadDouble();
+    }
+
+    bool ReadBool()
+    {
+        const uint8_t value = ReadByte();
+        if (value > 1)
+        {
+            ThrowInvalidSnapshot("bool value out of range");
+        }
+        return value != 0;
+    }
+
+    // Every item takes at least a byte, which bounds any valid count by what's left to read
+    uint32_t ReadCount()
+    {
+        const uint32_t count = ReadUInt32();
+        if (count > m_size - m_position)
+        {
+            ThrowInvalidSnapshot("count out of bounds");
+        }
+        return count;
+    }
+
+    std::string ReadString()
+    {
+        return std::string(ReadStringView());
+    }
+
+    std::string_view ReadStringView()
+    {
+        const uint32_t index = ReadUInt32();
+        if (index >= m_stringCount)
+        {
+            ThrowInvalidSnapshot("string index out of bounds");
+        }
+
+        const uint32_t entry = m_stringTableOffset + 8 * index;
+        const uint32_t offset = ReadUInt32At(entry);
+        const uint32_t length = ReadUInt32At(entry + 4);
+        if (uint64_t{offset} + length > m_size)
+        {
+            ThrowInvalidSnapshot("string out of bounds");
+        }
+        return {reinterpret_cast<const char*>(m_data + offset), length};
+    }
+
+    double ReadDouble()
+    {
+        const uint64_t bits = ReadUInt64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint8_t PeekByte() const
+    {
+        if (m_position >= m_size)
+        {
+            ThrowInvalidSnapshot("truncated");
+        }
+        return m_data[m_position];
+    }
+
+    uint8_t ReadByte()
+    {
+        const uint8_t value = PeekByte();
+        ++m_position;
+        return value;
+    }
+
+    uint16_t ReadUInt16()
+    {
+        const uint16_t low = ReadByte();
+        return static_cast<uint16_t>(low | (ReadByte() << 8));
+    }
+
+    uint32_t ReadUInt32()
+    {
+        const uint32_t value = ReadUInt32At(m_position);
+        m_position += 4;
+        return value;
+    }
+
+    uint32_t ReadUInt32At(uint32_t offset) const
+    {
+        if (uint64_t{offset} + 4 > m_size)
+        {
+            ThrowInvalidSnapshot("truncated");
+        }
+
+        uint32_t value = 0;
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            value |= static_cast<uint32_t>(m_data[offset + i]) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t ReadUInt64()
+    {
+        const uint64_t low = ReadUInt32();
+        return low | (static_cast<uint64_t>(ReadUInt32()) << 32);
+    }
+
+    const uint8_t* m_data;
+    uint32_t m_size;
+    uint32_t m_position;
+    uint32_t m_stringCount;
+    uint32_t m_stringTableOffset;
+    unsigned int m_depth;
+};
+
+std::vector<uint8_t> CardSnapshot::Save(const AdaptiveCard& card)
+{
+    return SnapshotWriter().Write(card);
+}
+
+std::shared_ptr<ParseResult> CardSnapshot::Load(const void* data, size_t size, const std::string& rendererVersion)
+{
+    ParseContext context;
+    return Load(data, size, rendererVersion, context);
+}
+
+std::shared_ptr<ParseResult> CardSnapshot::Load(const void* data, size_t size, const std::string& rendererVersion, ParseContext& context)
+{
+    return CardSnapshotReader(data, size).Load(rendererVersion, context);
+}
+} // namespace AdaptiveCards
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveCards
+{
+class AdaptiveCard;
+class ParseContext;
+class ParseResult;
+
+// A CardSnapshot is a compact binary encoding of a parsed card's object model, meant for caching cards across process
+// restarts. Loading one builds the card's elements directly from their records -- there's no JSON to parse and no
+// property lookups -- and gives the same card as parsing its Serialize() output would.
+//
+// The layout is:
+//
+//     header        magic "ACSN", format version (uint16), reserved (uint16), string count, string table offset,
+//                   card offset, total size (uint32 each)
+//     string table  (offset, length) per string, then the string bytes. Every distinct string -- ids, text, urls --
+//                   is stored once, and everything else refers to it by index.
+//     card          the card's own properties, then its body and actions as a sequence of records
+//
+// Each element or action record starts with its type (a CardElementType or ActionType byte) followed by the fields of
+// that type in a fixed order: enums are a byte, optional values are a presence byte followed by the value, strings are
+// string indices, and collections are a count followed by their items. Additional properties, Action.Submit and
+// Action.Execute data, and elements and actions of types a host has registered (CardElementType::Custom and
+// ActionType::Custom) are stored as encoded Json::Values; the latter are parsed with the loading context's
+// registrations when the snapshot is loaded.
+//
+// All integers are little-endian and nothing refers to an absolute address, so snapshots can be loaded from any
+// address (e.g. straight out of a memory-mapped file) and on any platform. Snapshots are checked as they're read, and
+// one that turns out to be malformed throws AdaptiveCardParseException. A snapshot only holds the card: the warnings
+// reported when the card was parsed aren't kept.
+class CardSnapshot
+{
+public:
+    static constexpr uint16_t FormatVersion = 2;
+
+    static std::vector<uint8_t> Save(const AdaptiveCard& card);
+
+    // rendererVersion is enforced the way AdaptiveCard::Deserialize() enforces it. The context's language and
+    // container style are updated just as parsing the card would update them.
+    static std::shared_ptr<ParseResult> Load(const void* data, size_t size, const std::string& rendererVersion);
+    static std::shared_ptr<ParseResult> Load(const void* data, size_t size, const std::string& rendererVersion, ParseContext& context);
+};
+} // namespace AdaptiveCards
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CaseInsensitive.h"
+#include <cstring>
+
+namespace
+{
+constexpr uint64_t c_ones = 0x0101010101010101u;
+constexpr uint64_t c_highBits = 0x8080808080808080u;
+
+// Up to eight bytes of value, starting at offset, zero-padded
+uint64_t LoadWord(std::string_view value, size_t offset) noexcept
+{
+    uint64_t word = 0;
+    std::memcpy(&word, value.data() + offset, std::min<size_t>(sizeof(word), value.size() - offset));
+    return word;
+}
+
+// Lowercases the ASCII letters in each byte of the word. Adding to the low seven bits of a byte can't carry into
+// the next byte, so each byte's high bit ends up telling whether the byte is >= 'A' and whether it's > 'Z'.
+uint64_t FoldWord(uint64_t word) noexcept
+{
+    const uint64_t lowBits = word & ~c_highBits;
+    const uint64_t atLeastA = lowBits + (0x80 - 'A') * c_ones;
+    const uint64_t pastZ = lowBits + (0x80 - 'Z' - 1) * c_ones;
+    const uint64_t isUpper = (atLeastA ^ pastZ) & ~word & c_highBits;
+    return word | (isUpper >> 2);
+}
+
+uint64_t MixWord(uint64_t hash, uint64_t word) noexcept
+{
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15u;
+    return hash ^ (hash >> 29);
+}
+} // namespace
+
+namespace AdaptiveCards
+{
+namespace CaseInsensitive
+{
+    bool Equals(std::string_view lhs, std::string_view rhs) noexcept
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+
+        for (size_t offset = 0; offset < lhs.size(); offset += sizeof(uint64_t))
+        {
+            const uint64_t left = LoadWord(lhs, offset);
+            const uint64_t right = LoadWord(rhs, offset);
+            if (left != right && FoldWord(left) != FoldWord(right))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int Compare(std::string_view lhs, std::string_view rhs) noexcept
+    {
+        const size_t length = std::min(lhs.size(), rhs.size());
+        size_t offset = 0;
+
+        // skip the words that are identical as they are
+        while (offset + sizeof(uint64_t) <= length && LoadWord(lhs, offset) == LoadWord(rhs, offset))
+        {
+            offset += sizeof(uint64_t);
+        }
+
+        for (; offset < length; ++offset)
+        {
+            const auto left = ToLower(static_cast<unsigned char>(lhs[offset]));
+            const auto right = ToLower(static_cast<unsigned char>(rhs[offset]));
+            if (left != right)
+            {
+                return (left < right) ? -1 : 1;
+            }
+        }
+        return (lhs.size() == rhs.size()) ? 0 : ((lhs.size() < rhs.size()) ? -1 : 1);
+    }
+
+    size_t Hash(std::string_view value) noexcept
+    {
+        uint64_t hash = MixWord(0xCBF29CE484222325u, value.size());
+        for (size_t offset = 0; offset < value.size(); offset += sizeof(uint64_t))
+        {
+            hash = MixWord(hash, FoldWord(LoadWord(value, offset)));
+        }
+
+        // murmur3's finalizer, so that every bit of the result depends on every byte (for tables that bucket on the
+        // low bits)
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDu;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    void ToLowerInPlace(std::string& value) noexcept
+    {
+        for (auto& c : value)
+        {
+            c = ToLower(c);
+        }
+    }
+} // namespace CaseInsensitive
+} // namespace AdaptiveCards
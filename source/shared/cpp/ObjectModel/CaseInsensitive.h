@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace AdaptiveCards
+{
+// Case-insensitive comparison for type names, enum values, feature names and other keywords. Only the ASCII letters
+// are folded; every other character, including each byte of a UTF-8 multi-byte sequence, compares as-is. Results
+// don't depend on the current locale, and nothing allocates.
+namespace CaseInsensitive
+{
+    template <typename Char>
+    constexpr Char ToLower(Char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<Char>(c + ('a' - 'A')) : c;
+    }
+
+    // These work on eight bytes at a time, folding only the words that differ
+    bool Equals(std::string_view lhs, std::string_view rhs) noexcept;
+    // <0, 0, or >0 as for std::string::compare(), on the folded bytes taken as unsigned
+    int Compare(std::string_view lhs, std::string_view rhs) noexcept;
+    size_t Hash(std::string_view value) noexcept;
+
+    void ToLowerInPlace(std::string& value) noexcept;
+
+    // For other string types (e.g. the UWP projection's hstring)
+    template <typename T>
+    bool EqualsRange(const T& lhs, const T& rhs) noexcept
+    {
+        auto left = std::begin(lhs);
+        auto right = std::begin(rhs);
+        for (; left != std::end(lhs) && right != std::end(rhs); ++left, ++right)
+        {
+            if (ToLower(*left) != ToLower(*right))
+            {
+                return false;
+            }
+        }
+        return left == std::end(lhs) && right == std::end(rhs);
+    }
+
+    // FNV-1a over the folded characters
+    template <typename T>
+    size_t HashRange(const T& value) noexcept
+    {
+        size_t hash = 2166136261u;
+        for (const auto c : value)
+        {
+            hash = (hash ^ static_cast<size_t>(ToLower(c))) * size_t{16777619u};
+        }
+        return hash;
+    }
+
+    template <typename T>
+    using IfNotStringView = std::enable_if_t<!std::is_convertible_v<const T&, std::string_view>, int>;
+} // namespace CaseInsensitive
+
+struct CaseInsensitiveEqualTo
+{
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept
+    {
+        return CaseInsensitive::Equals(lhs, rhs);
+    }
+
+    template <typename T, CaseInsensitive::IfNotStringView<T> = 0>
+    bool operator()(const T& lhs, const T& rhs) const noexcept
+    {
+        return CaseInsensitive::EqualsRange(lhs, rhs);
+    }
+};
+
+struct CaseInsensitiveHash
+{
+    size_t operator()(std::string_view value) const noexcept
+    {
+        return CaseInsensitive::Hash(value);
+    }
+
+    template <typename T, CaseInsensitive::IfNotStringView<T> = 0>
+    size_t operator()(const T& value) const noexcept
+    {
+        return CaseInsensitive::HashRange(value);
+    }
+};
+
+struct CaseInsensitiveLess
+{
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept
+    {
+        return CaseInsensitive::Compare(lhs, rhs) < 0;
+    }
+};
+} // namespace AdaptiveCards
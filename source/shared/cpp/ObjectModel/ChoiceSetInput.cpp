@@ -116,7 +116,7 @@ std::shared_ptr<BaseCardElement> ChoiceSetInputParser::Deserialize(ParseContext&
     auto choiceSet = BaseInputElement::Deserialize<ChoiceSetInput>(context, json);
 
     choiceSet->SetChoiceSetStyle(ParseUtil::GetEnumValue<ChoiceSetStyle>(
-        json, AdaptiveCardSchemaKey::Style, ChoiceSetStyle::Compact, ChoiceSetStyleFromString));
+        json, AdaptiveCardSchemaKey::Style, ChoiceSetStyle::Compact, ChoiceSetStyleTryFromString));
     choiceSet->SetIsMultiSelect(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::IsMultiSelect, false));
     choiceSet->SetValue(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Value, false));
     choiceSet->SetWrap(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::Wrap, false, false));
@@ -143,11 +143,12 @@ std::shared_ptr<BaseCardElement> ChoiceSetInputParser::DeserializeFromString(Par
 
 void ChoiceSetInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Choices),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsMultiSelect),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap)});
+    SetKnownProperties(knownProperties);
 }
@@ -95,13 +95,14 @@ Json::Value Column::SerializeToJsonValue() const
 
 void Column::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Items),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Rtl),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Width),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::VerticalContentAlignment)});
+    SetKnownProperties(knownProperties);
 }
 
 void Column::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
@@ -137,6 +138,10 @@ std::shared_ptr<BaseCardElement> ColumnParser::Deserialize(ParseContext& context
         }
         catch (const std::out_of_range&)
         {
+            if (ParseStatistics* statistics = context.GetStatistics())
+            {
+                ++statistics->exceptionsCaught;
+            }
             isFallbackColumn = false;
         }
 
@@ -157,7 +162,7 @@ std::shared_ptr<BaseCardElement> ColumnParser::Deserialize(ParseContext& context
         columnWidth = ParseUtil::GetValueAsString(value, AdaptiveCardSchemaKey::Size);
     }
 
-    column->SetWidth(ParseUtil::ToLowercase(columnWidth), &context.warnings);
+    column->SetWidth(columnWidth, &context.warnings);
 
     column->SetRtl(ParseUtil::GetOptionalBool(value, AdaptiveCardSchemaKey::Rtl));
 
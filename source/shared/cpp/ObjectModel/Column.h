@@ -18,6 +18,7 @@ public:
     Column();
 
     std::string Serialize() const override;
+    using BaseElement::Serialize;
     Json::Value SerializeToJsonValue() const override;
 
     void DeserializeChildren(ParseContext& context, const Json::Value& value) override;
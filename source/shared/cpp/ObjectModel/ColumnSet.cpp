@@ -52,11 +52,12 @@ void ColumnSet::DeserializeChildren(ParseContext& context, const Json::Value& va
 
 void ColumnSet::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Bleed),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Columns),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style)});
+    SetKnownProperties(knownProperties);
 }
 
 void ColumnSet::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
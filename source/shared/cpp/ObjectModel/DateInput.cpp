@@ -100,9 +100,10 @@ std::shared_ptr<BaseCardElement> DateInputParser::DeserializeFromString(ParseCon
 
 void DateInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder)});
+    SetKnownProperties(knownProperties);
 }
@@ -0,0 +1,461 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "DeferredParse.h"
+#include "ActionSet.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "ExecuteAction.h"
+#include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "NumberInput.h"
+#include "OpenUrlAction.h"
+#include "ParseContext.h"
+#include "ParseUtil.h"
+#include "RichTextBlock.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+#include "SubmitAction.h"
+#include "Table.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+#include "ToggleVisibilityAction.h"
+#include "UnknownAction.h"
+#include "UnknownElement.h"
+#include <typeinfo>
+
+namespace
+{
+using namespace AdaptiveCards;
+
+// Thrown while walking a subtree that has to be parsed right away
+struct NotDeferrable
+{
+};
+
+// Walks a subtree's JSON, recording the pushes and pops of the id stack that parsing it would make (see the comment
+// on id collision detection in ParseContext.cpp). Only the built-in parsers are understood, since a custom parser can
+// parse children of its own. Anything the parsers would reject throws, so that the subtree gets parsed right away
+// and the error is reported where it would have been.
+class IdEventRecorder
+{
+public:
+    explicit IdEventRecorder(const ParseContext& context) : m_context(context)
+    {
+    }
+
+    void RecordCard(const Json::Value& json)
+    {
+        ParseUtil::ThrowIfNotJsonObject(json);
+        ParseUtil::ExpectTypeString(json, CardElementType::AdaptiveCard);
+
+        // same order as AdaptiveCard::_Deserialize
+        RecordAction(ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Refresh), AdaptiveCardSchemaKey::Action);
+        RecordElements(json, AdaptiveCardSchemaKey::Body);
+        RecordActions(json, AdaptiveCardSchemaKey::Actions);
+        RecordAction(json, AdaptiveCardSchemaKey::SelectAction);
+    }
+
+    // The fallback content of the element with the given id, as BaseElement::ParseFallback parses it
+    void RecordFallback(const Json::Value& json, const std::string& parentId, const InternalId& parentInternalId, bool isAction)
+    {
+        Push(parentId, parentInternalId, true);
+        if (isAction)
+        {
+            RecordAction(json);
+        }
+        else
+        {
+            RecordElement(json, ParseUtil::GetTypeAsString(json));
+        }
+        Pop();
+    }
+
+    void Replay(ParseContext& context) const
+    {
+        for (const auto& idEvent : m_idEvents)
+        {
+            if (idEvent.isPush)
+            {
+                context.PushElement(idEvent.id, idEvent.internalId, idEvent.isFallback);
+            }
+            else
+            {
+                context.PopElement();
+            }
+        }
+    }
+
+private:
+    struct IdEvent
+    {
+        bool isPush;
+        std::string id;
+        InternalId internalId;
+        bool isFallback;
+    };
+
+    void Push(const std::string& id, const InternalId& internalId, bool isFallback)
+    {
+        m_idEvents.push_back({true, id, internalId, isFallback});
+    }
+
+    void Pop()
+    {
+        m_idEvents.push_back({false, std::string(), InternalId(), false});
+    }
+
+    // What the parser wrappers and BaseElement::DeserializeBase do before the element's own parser runs. The caller
+    // pops once it has recorded the element's children.
+    void PushElement(const Json::Value& json, bool isAction)
+    {
+        const std::string id = ParseUtil::GetString(json, AdaptiveCardSchemaKey::Id);
+        const InternalId internalId = InternalId::Next();
+        Push(id, internalId, false);
+
+        ParseUtil::ThrowIfNotJsonObject(json);
+        const Json::Value& fallback = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Fallback, false);
+        if (fallback.empty())
+        {
+            return;
+        }
+
+        if (fallback.isString())
+        {
+            if (!CaseInsensitive::Equals(ParseUtil::GetStringView(fallback), "drop"))
+            {
+                throw NotDeferrable();
+            }
+        }
+        else if (fallback.isObject())
+        {
+            RecordFallback(fallback, id, internalId, isAction);
+        }
+        else
+        {
+            throw NotDeferrable();
+        }
+    }
+
+    void RecordElements(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false, const std::string& impliedType = std::string())
+    {
+        for (const auto& element : ParseUtil::GetArray(json, key, isRequired))
+        {
+            if (impliedType.empty())
+            {
+                RecordElement(element, ParseUtil::GetTypeAsString(element));
+            }
+            else if (ParseUtil::GetString(element, AdaptiveCardSchemaKey::Type, impliedType, false) == impliedType)
+            {
+                RecordElement(element, impliedType);
+            }
+            else
+            {
+                throw NotDeferrable();
+            }
+        }
+    }
+
+    void RecordActions(const Json::Value& json, AdaptiveCardSchemaKey key)
+    {
+        for (const auto& action : ParseUtil::GetArray(json, key, false))
+        {
+            RecordAction(action);
+        }
+    }
+
+    // An optional action such as a selectAction, as ParseUtil::GetAction parses it
+    void RecordAction(const Json::Value& json, AdaptiveCardSchemaKey key)
+    {
+        const Json::Value& action = ParseUtil::ExtractJsonValue(json, key, false);
+        if (!action.empty())
+        {
+            RecordAction(action);
+        }
+    }
+
+    void RecordElement(const Json::Value& json, const std::string& type)
+    {
+        auto parser = m_context.elementParserRegistration->GetParser(type);
+        if (!parser)
+        {
+            parser = m_context.elementParserRegistration->GetParser(CardElementTypeToString(CardElementType::Unknown));
+        }
+
+        // every registered parser is wrapped (see ElementParserRegistration::GetParser())
+        const auto actualParser = static_cast<const BaseCardElementParserWrapper&>(*parser).GetActualParser();
+        const std::type_info& parserType = typeid(*actualParser);
+
+        PushElement(json, false);
+
+        if (parserType == typeid(ContainerParser) || parserType == typeid(ColumnParser))
+        {
+            RecordElements(json, AdaptiveCardSchemaKey::Items);
+            RecordAction(json, AdaptiveCardSchemaKey::SelectAction);
+        }
+        else if (parserType == typeid(ColumnSetParser))
+        {
+            RecordElements(json, AdaptiveCardSchemaKey::Columns, false, CardElementTypeToString(CardElementType::Column));
+            RecordAction(json, AdaptiveCardSchemaKey::SelectAction);
+        }
+        else if (parserType == typeid(TableParser))
+        {
+            RecordTableRows(json);
+        }
+        else if (parserType == typeid(ActionSetParser))
+        {
+            RecordActions(json, AdaptiveCardSchemaKey::Actions);
+        }
+        else if (parserType == typeid(ImageParser))
+        {
+            RecordAction(json, AdaptiveCardSchemaKey::SelectAction);
+        }
+        else if (parserType == typeid(ImageSetParser))
+        {
+            RecordElements(json, AdaptiveCardSchemaKey::Images, true, CardElementTypeToString(CardElementType::Image));
+        }
+        else if (parserType == typeid(RichTextBlockParser))
+        {
+            for (const auto& inlineJson : ParseUtil::GetArray(json, AdaptiveCardSchemaKey::Inlines, false))
+            {
+                if (!inlineJson.isString())
+                {
+                    RecordAction(inlineJson, AdaptiveCardSchemaKey::SelectAction);
+                }
+            }
+        }
+        else if (parserType == typeid(TextInputParser))
+        {
+            RecordAction(json, AdaptiveCardSchemaKey::InlineAction);
+        }
+        else if (parserType != typeid(ChoiceSetInputParser) && parserType != typeid(DateInputParser) &&
+                 parserType != typeid(FactSetParser) && parserType != typeid(MediaParser) &&
+                 parserType != typeid(NumberInputParser) && parserType != typeid(TextBlockParser) &&
+                 parserType != typeid(TimeInputParser) && parserType != typeid(ToggleInputParser) &&
+                 parserType != typeid(UnknownElementParser))
+        {
+            throw NotDeferrable();
+        }
+
+        Pop();
+    }
+
+    // Rows and cells aren't parsed through the registration (see TableRow::DeserializeTableRow())
+    void RecordTableRows(const Json::Value& json)
+    {
+        for (const auto& row : ParseUtil::GetArray(json, AdaptiveCardSchemaKey::Rows, false))
+        {
+            PushElement(row, false);
+            for (const auto& cell : ParseUtil::GetArray(row, AdaptiveCardSchemaKey::Cells, false))
+            {
+                PushElement(cell, false);
+                RecordElements(cell, AdaptiveCardSchemaKey::Items);
+                RecordAction(cell, AdaptiveCardSchemaKey::SelectAction);
+                Pop();
+            }
+            Pop();
+        }
+    }
+
+    void RecordAction(const Json::Value& json)
+    {
+        if (json.empty() || !json.isObject())
+        {
+            throw NotDeferrable();
+        }
+
+        auto parser = m_context.actionParserRegistration->GetParser(ParseUtil::GetTypeAsString(json));
+        if (!parser)
+        {
+            parser = m_context.actionParserRegistration->GetParser(ActionTypeToString(ActionType::UnknownAction));
+        }
+
+        const auto actualParser = static_cast<const ActionElementParserWrapper&>(*parser).GetActualParser();
+        const std::type_info& parserType = typeid(*actualParser);
+
+        PushElement(json, true);
+
+        if (parserType == typeid(ShowCardActionParser))
+        {
+            RecordCard(ParseUtil::GetJsonValue(json, AdaptiveCardSchemaKey::Card));
+        }
+        else if (parserType != typeid(ExecuteActionParser) && parserType != typeid(OpenUrlActionParser) &&
+                 parserType != typeid(SubmitActionParser) && parserType != typeid(ToggleVisibilityActionParser) &&
+                 parserType != typeid(UnknownActionParser))
+        {
+            throw NotDeferrable();
+        }
+
+        Pop();
+    }
+
+    const ParseContext& m_context;
+    std::vector<IdEvent> m_idEvents;
+};
+} // namespace
+
+namespace AdaptiveCards
+{
+std::shared_ptr<DeferredParse> DeferredParse::DeferShowCard(ParseContext& context, const Json::Value& cardJson)
+{
+    if (!context.GetUseLazyParsing())
+    {
+        return nullptr;
+    }
+
+    IdEventRecorder recorder(context);
+    try
+    {
+        recorder.RecordCard(cardJson);
+    }
+    catch (const NotDeferrable&)
+    {
+        return nullptr;
+    }
+    catch (const AdaptiveCardParseException&)
+    {
+        // parsed right away, so that the error is reported where it would have been
+        return nullptr;
+    }
+
+    auto deferred = std::make_shared<DeferredParse>(context.ForkForDeferredParse(), cardJson);
+    deferred->m_kind = Kind::ShowCard;
+
+    recorder.Replay(context);
+
+    // Parsing the card leaves its language and style on the context for the rest of the parse (see
+    // AdaptiveCard::_Deserialize()), so the elements after it need to see them either way
+    const std::string language = ParseUtil::GetString(cardJson, AdaptiveCardSchemaKey::Language);
+    if (!language.empty())
+    {
+        context.SetLanguage(language);
+    }
+    context.SetParentalContainerStyle(ParseUtil::GetEnumValue<ContainerStyle>(
+        cardJson, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleTryFromString));
+
+    return deferred;
+}
+
+std::shared_ptr<DeferredParse> DeferredParse::DeferFallback(
+    ParseContext& context, const Json::Value& fallbackJson, const std::string& parentId, const InternalId& parentInternalId, bool isAction)
+{
+    if (!context.GetUseLazyParsing())
+    {
+        return nullptr;
+    }
+
+    IdEventRecorder recorder(context);
+    try
+    {
+        recorder.RecordFallback(fallbackJson, parentId, parentInternalId, isAction);
+    }
+    catch (const NotDeferrable&)
+    {
+        return nullptr;
+    }
+    catch (const AdaptiveCardParseException&)
+    {
+        // parsed right away, so that the error is reported where it would have been
+        return nullptr;
+    }
+
+    auto deferred = std::make_shared<DeferredParse>(context.ForkForDeferredParse(), fallbackJson);
+    deferred->m_kind = isAction ? Kind::FallbackAction : Kind::FallbackElement;
+    deferred->m_parentId = parentId;
+    deferred->m_parentInternalId = parentInternalId;
+
+    recorder.Replay(context);
+
+    return deferred;
+}
+
+DeferredParse::DeferredParse(std::unique_ptr<ParseContext> context, const Json::Value& json) :
+    m_kind(Kind::ShowCard), m_context(std::move(context))
+{
+    // kept as text, which is far smaller than the parsed tree
+    ParseUtil::JsonToString(json, m_source);
+}
+
+DeferredParse::~DeferredParse() = default;
+
+std::shared_ptr<AdaptiveCard> DeferredParse::GetCard()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_context)
+    {
+        Parse();
+    }
+    return m_card;
+}
+
+const std::shared_ptr<BaseElement>& DeferredParse::GetFallbackContent()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_context)
+    {
+        Parse();
+    }
+    return m_fallbackContent;
+}
+
+void DeferredParse::SetDefaultCardVersion(const std::string& version)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_card)
+    {
+        m_defaultCardVersion = version;
+    }
+    else if (m_card->GetVersion().empty())
+    {
+        m_card->SetVersion(version);
+    }
+}
+
+void DeferredParse::Parse()
+{
+    // Parse on a copy, so that a failed parse can be retried from the same state
+    ParseContext context(*m_context);
+    const Json::Value json = ParseUtil::GetJsonValueFromString(m_source);
+
+    if (m_kind == Kind::ShowCard)
+    {
+        m_card = AdaptiveCard::Deserialize(json, "", context)->GetAdaptiveCard();
+        if (m_card->GetVersion().empty())
+        {
+            m_card->SetVersion(m_defaultCardVersion);
+        }
+    }
+    else
+    {
+        // as BaseElement::ParseFallback() does
+        context.PushElement(m_parentId, m_parentInternalId, true);
+        std::shared_ptr<BaseElement> fallbackContent;
+        if (m_kind == Kind::FallbackAction)
+        {
+            BaseActionElement::ParseJsonObject(context, json, fallbackContent);
+        }
+        else
+        {
+            BaseCardElement::ParseJsonObject(context, json, fallbackContent);
+        }
+        context.PopElement();
+
+        if (!fallbackContent)
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Fallback content did not parse correctly.");
+        }
+        m_fallbackContent = std::move(fallbackContent);
+    }
+
+    // the source isn't needed any more
+    m_context.reset();
+    std::string().swap(m_source);
+}
+} // namespace AdaptiveCards
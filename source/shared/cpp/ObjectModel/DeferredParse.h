@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "InternalId.h"
+#include <mutex>
+
+namespace AdaptiveCards
+{
+class AdaptiveCard;
+class BaseElement;
+class ParseContext;
+
+// The card of an Action.ShowCard, or an element's fallback content, kept as JSON until it's first asked for (see
+// ParseContext::SetUseLazyParsing()). Parsing it is thread safe; copies of the element that owns it share it.
+class DeferredParse
+{
+public:
+    // Each returns nullptr if lazy parsing is off or the subtree can't be deferred, in which case the caller parses
+    // it as usual. Otherwise the subtree's ids are pushed onto context as if it had been parsed, which throws on an id
+    // collision just like parsing it would.
+    static std::shared_ptr<DeferredParse> DeferShowCard(ParseContext& context, const Json::Value& cardJson);
+    static std::shared_ptr<DeferredParse> DeferFallback(
+        ParseContext& context, const Json::Value& fallbackJson, const std::string& parentId, const InternalId& parentInternalId, bool isAction);
+
+    DeferredParse(std::unique_ptr<ParseContext> context, const Json::Value& json);
+    ~DeferredParse();
+
+    // Parse the subtree on first use. Throw AdaptiveCardParseException if it doesn't parse.
+    std::shared_ptr<AdaptiveCard> GetCard();
+    const std::shared_ptr<BaseElement>& GetFallbackContent();
+
+    // Gives the card the version, if it doesn't have one, once it's parsed (see EnsureShowCardVersions)
+    void SetDefaultCardVersion(const std::string& version);
+
+private:
+    enum class Kind
+    {
+        ShowCard,
+        FallbackElement,
+        FallbackAction
+    };
+
+    void Parse();
+
+    std::mutex m_mutex;
+    Kind m_kind;
+    std::unique_ptr<ParseContext> m_context;
+    std::string m_source;
+    std::string m_parentId;
+    InternalId m_parentInternalId;
+    std::string m_defaultCardVersion;
+
+    std::shared_ptr<AdaptiveCard> m_card;
+    std::shared_ptr<BaseElement> m_fallbackContent;
+};
+} // namespace AdaptiveCards
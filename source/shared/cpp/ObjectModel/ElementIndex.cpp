@@ -0,0 +1,249 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ElementIndex.h"
+#include "ActionSet.h"
+#include "BaseInputElement.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "RichTextBlock.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+#include "Table.h"
+#include "TableRow.h"
+#include "TextRun.h"
+
+namespace AdaptiveCards
+{
+class ElementIndexBuilder
+{
+public:
+    explicit ElementIndexBuilder(ElementIndex& index) : m_index(index)
+    {
+    }
+
+    void AddCard(const AdaptiveCard& card, const std::shared_ptr<AdaptiveCard>& showCard, const std::string& path, bool isFallback)
+    {
+        AddElements(card.GetBody(), nullptr, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body), isFallback);
+        AddActions(card.GetActions(), nullptr, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions), isFallback);
+        AddSelectAction(card.GetSelectAction(), nullptr, showCard, path, isFallback);
+    }
+
+private:
+    template <typename T>
+    void AddElements(const std::vector<std::shared_ptr<T>>& elements,
+                     const std::shared_ptr<BaseElement>& parent,
+                     const std::shared_ptr<AdaptiveCard>& showCard,
+                     const std::string& path,
+                     bool isFallback)
+    {
+        for (size_t i = 0; i < elements.size(); ++i)
+        {
+            AddElement(elements[i], parent, showCard, path + '/' + std::to_string(i), isFallback);
+        }
+    }
+
+    void AddActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions,
+                    const std::shared_ptr<BaseElement>& parent,
+                    const std::shared_ptr<AdaptiveCard>& showCard,
+                    const std::string& path,
+                    bool isFallback)
+    {
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            AddAction(actions[i], parent, showCard, path + '/' + std::to_string(i), isFallback);
+        }
+    }
+
+    void AddSelectAction(const std::shared_ptr<BaseActionElement>& action,
+                         const std::shared_ptr<BaseElement>& parent,
+                         const std::shared_ptr<AdaptiveCard>& showCard,
+                         const std::string& path,
+                         bool isFallback)
+    {
+        if (action)
+        {
+            AddAction(action, parent, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction), isFallback);
+        }
+    }
+
+    // Records the element itself and its fallback content (the element's contents are added by the caller)
+    void AddLocation(const std::shared_ptr<BaseElement>& element,
+                     const std::shared_ptr<BaseElement>& parent,
+                     const std::shared_ptr<AdaptiveCard>& showCard,
+                     const std::string& path,
+                     bool isFallback)
+    {
+        const std::string& id = element->GetId();
+        if (!id.empty())
+        {
+            m_index.m_locations[id].push_back({element, parent, showCard, path, isFallback});
+        }
+
+        if (!isFallback && std::dynamic_pointer_cast<BaseInputElement>(element))
+        {
+            m_index.m_inputs.push_back({element, parent, showCard, path, isFallback});
+        }
+
+        const auto& fallback = element->GetFallbackContent();
+        if (element->GetFallbackType() == FallbackType::Content && fallback)
+        {
+            const std::string fallbackPath = path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback);
+            if (const auto fallbackElement = std::dynamic_pointer_cast<BaseCardElement>(fallback))
+            {
+                AddElement(fallbackElement, parent, showCard, fallbackPath, true);
+            }
+            else if (const auto fallbackAction = std::dynamic_pointer_cast<BaseActionElement>(fallback))
+            {
+                AddAction(fallbackAction, parent, showCard, fallbackPath, true);
+            }
+        }
+    }
+
+    void AddElement(const std::shared_ptr<BaseCardElement>& element,
+                    const std::shared_ptr<BaseElement>& parent,
+                    const std::shared_ptr<AdaptiveCard>& showCard,
+                    const std::string& path,
+                    bool isFallback)
+    {
+        if (!element)
+        {
+            return;
+        }
+
+        AddLocation(element, parent, showCard, path, isFallback);
+
+        switch (element->GetElementType())
+        {
+        case CardElementType::Container:
+        case CardElementType::TableCell:
+            if (const auto container = std::dynamic_pointer_cast<Container>(element))
+            {
+                AddElements(container->GetItems(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Items), isFallback);
+                AddSelectAction(container->GetSelectAction(), element, showCard, path, isFallback);
+            }
+            break;
+        case CardElementType::Column:
+            if (const auto column = std::dynamic_pointer_cast<Column>(element))
+            {
+                AddElements(column->GetItems(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Items), isFallback);
+                AddSelectAction(column->GetSelectAction(), element, showCard, path, isFallback);
+            }
+            break;
+        case CardElementType::ColumnSet:
+            if (const auto columnSet = std::dynamic_pointer_cast<ColumnSet>(element))
+            {
+                AddElements(columnSet->GetColumns(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Columns), isFallback);
+                AddSelectAction(columnSet->GetSelectAction(), element, showCard, path, isFallback);
+            }
+            break;
+        case CardElementType::Table:
+            if (const auto table = std::dynamic_pointer_cast<Table>(element))
+            {
+                AddElements(table->GetRows(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Rows), isFallback);
+            }
+            break;
+        case CardElementType::TableRow:
+            if (const auto row = std::dynamic_pointer_cast<TableRow>(element))
+            {
+                AddElements(row->GetCells(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Cells), isFallback);
+            }
+            break;
+        case CardElementType::ActionSet:
+            if (const auto actionSet = std::dynamic_pointer_cast<ActionSet>(element))
+            {
+                AddActions(actionSet->GetActions(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions), isFallback);
+            }
+            break;
+        case CardElementType::Image:
+            if (const auto image = std::dynamic_pointer_cast<Image>(element))
+            {
+                AddSelectAction(image->GetSelectAction(), element, showCard, path, isFallback);
+            }
+            break;
+        case CardElementType::ImageSet:
+            if (const auto imageSet = std::dynamic_pointer_cast<ImageSet>(element))
+            {
+                AddElements(imageSet->GetImages(), element, showCard, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Images), isFallback);
+            }
+            break;
+        case CardElementType::RichTextBlock:
+            if (const auto richTextBlock = std::dynamic_pointer_cast<RichTextBlock>(element))
+            {
+                const auto& inlines = richTextBlock->GetInlines();
+                for (size_t i = 0; i < inlines.size(); ++i)
+                {
+                    if (const auto textRun = std::dynamic_pointer_cast<TextRun>(inlines[i]))
+                    {
+                        AddSelectAction(textRun->GetSelectAction(),
+                                        element,
+                                        showCard,
+                                        path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Inlines) + '/' + std::to_string(i),
+                                        isFallback);
+                    }
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void AddAction(const std::shared_ptr<BaseActionElement>& action,
+                   const std::shared_ptr<BaseElement>& parent,
+                   const std::shared_ptr<AdaptiveCard>& showCard,
+                   const std::string& path,
+                   bool isFallback)
+    {
+        if (!action)
+        {
+            return;
+        }
+
+        AddLocation(action, parent, showCard, path, isFallback);
+
+        if (const auto showCardAction = std::dynamic_pointer_cast<ShowCardAction>(action))
+        {
+            if (const auto card = showCardAction->GetCard())
+            {
+                AddCard(*card, card, path + '/' + AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card), isFallback);
+            }
+        }
+    }
+
+    ElementIndex& m_index;
+};
+
+ElementIndex::ElementIndex(const AdaptiveCard& card)
+{
+    ElementIndexBuilder(*this).AddCard(card, nullptr, std::string(), false);
+}
+
+const std::vector<ElementIndex::Location>& ElementIndex::Find(const std::string& id) const
+{
+    static const std::vector<Location> c_noLocations;
+
+    const auto locations = m_locations.find(id);
+    return (locations != m_locations.end()) ? locations->second : c_noLocations;
+}
+
+std::shared_ptr<BaseElement> ElementIndex::GetElement(const std::string& id) const
+{
+    for (const auto& location : Find(id))
+    {
+        if (!location.isFallback)
+        {
+            return location.element;
+        }
+    }
+    return nullptr;
+}
+
+const std::vector<ElementIndex::Location>& ElementIndex::GetInputs() const
+{
+    return m_inputs;
+}
+} // namespace AdaptiveCards
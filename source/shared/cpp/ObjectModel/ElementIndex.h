@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveCards
+{
+class AdaptiveCard;
+class BaseElement;
+
+// Every element and action in a card that has an id, for finding toggle targets, inputs, etc. without walking the
+// card. Covers the card's body and actions, selectActions, the cards of Action.ShowCard actions, and fallback
+// content.
+//
+// The index is a snapshot of the card when it was built, and keeps the elements it found alive. It doesn't follow
+// later changes to the card (or to the cards of its ShowCard actions); build a new one after adding, removing, or
+// re-id'ing elements.
+//
+// Building the index parses any ShowCard cards and fallback content whose parsing was deferred (see
+// ParseContext::SetUseLazyParsing()), so it throws AdaptiveCardParseException if one of them doesn't parse.
+class ElementIndex
+{
+public:
+    struct Location
+    {
+        std::shared_ptr<BaseElement> element;
+        // The element or action the element is in, or nullptr at the top level of a card. Fallback content has the
+        // same parent as the element it stands in for.
+        std::shared_ptr<BaseElement> parent;
+        // The card of the Action.ShowCard the element is in, or nullptr if it's in the indexed card itself
+        std::shared_ptr<AdaptiveCard> showCard;
+        // JSON Pointer to the element in the indexed card's serialized form, e.g. "/body/2/items/0" (see CardPatch)
+        std::string path;
+        // Whether the element is fallback content, or inside fallback content
+        bool isFallback;
+    };
+
+    explicit ElementIndex(const AdaptiveCard& card);
+
+    // Every element and action with the id, in document order. Ids are unique except for fallback content, which
+    // may share its parent's id.
+    const std::vector<Location>& Find(const std::string& id) const;
+
+    // The first element or action with the id that isn't fallback content, or nullptr
+    std::shared_ptr<BaseElement> GetElement(const std::string& id) const;
+
+    // Every input in the card, including those in ShowCard cards, in document order. Fallback content isn't
+    // included.
+    const std::vector<Location>& GetInputs() const;
+
+private:
+    friend class ElementIndexBuilder;
+
+    std::unordered_map<std::string, std::vector<Location>> m_locations;
+    std::vector<Location> m_inputs;
+};
+} // namespace AdaptiveCards
@@ -37,6 +37,12 @@ std::shared_ptr<BaseCardElement> BaseCardElementParserWrapper::Deserialize(Parse
     std::shared_ptr<BaseCardElement> element = m_parser->Deserialize(context, value);
     context.PopElement();
 
+    ParseStatistics* statistics = context.GetStatistics();
+    if (statistics && element)
+    {
+        statistics->CountElement(element->GetElementTypeString());
+    }
+
     return element;
 }
 
@@ -45,7 +51,9 @@ std::shared_ptr<BaseCardElement> BaseCardElementParserWrapper::DeserializeFromSt
     return Deserialize(context, ParseUtil::GetJsonValueFromString(value));
 }
 
-ElementParserRegistration::ElementParserRegistration()
+std::atomic<size_t> ElementParserRegistration::s_nextGeneration{1};
+
+ElementParserRegistration::ElementParserRegistration() : m_generation(0)
 {
     m_knownElements.insert(
         {CardElementTypeToString(CardElementType::ActionSet),
@@ -86,13 +94,20 @@ ElementParserRegistration::ElementParserRegistration()
          {CardElementTypeToString(CardElementType::TimeInput), std::make_shared<TimeInputParser>()},
          {CardElementTypeToString(CardElementType::ToggleInput), std::make_shared<ToggleInputParser>()},
          {CardElementTypeToString(CardElementType::Unknown), std::make_shared<UnknownElementParser>()}});
+
+    // Parsers are stored already wrapped (see GetParser) so that handing one out doesn't allocate
+    for (auto& parser : m_cardElementParsers)
+    {
+        parser.second = std::make_shared<BaseCardElementParserWrapper>(parser.second);
+    }
 }
 
 void ElementParserRegistration::AddParser(std::string const& elementType, std::shared_ptr<BaseCardElementParser> parser)
 {
     if (m_knownElements.find(elementType) == m_knownElements.end())
     {
-        ElementParserRegistration::m_cardElementParsers[elementType] = parser;
+        ElementParserRegistration::m_cardElementParsers[elementType] = std::make_shared<BaseCardElementParserWrapper>(parser);
+        m_generation = s_nextGeneration++;
     }
     else
     {
@@ -106,6 +121,7 @@ void ElementParserRegistration::RemoveParser(std::string const& elementType)
     if (m_knownElements.find(elementType) == m_knownElements.end())
     {
         ElementParserRegistration::m_cardElementParsers.erase(elementType);
+        m_generation = s_nextGeneration++;
     }
     else
     {
@@ -124,12 +140,18 @@ std::shared_ptr<BaseCardElementParser> ElementParserRegistration::GetParser(std:
         // mean having to explain all of this to custom element parser implementors. Instead, we wrap every parser
         // we hand out with a helper class that performs the push/pop on behalf of the element parser. For more
         // details, refer to the giant comment on ID collision detection in ParseContext.cpp.
-        std::shared_ptr<BaseCardElementParser> wrappedParser = std::make_shared<BaseCardElementParserWrapper>(parser->second);
-        return wrappedParser;
+        //
+        // The wrappers are stateless, so each parser is wrapped once, when it's registered, and shared from then on.
+        return parser->second;
     }
     else
     {
         return std::shared_ptr<BaseCardElementParser>(nullptr);
     }
 }
+
+size_t ElementParserRegistration::GetFingerprint() const
+{
+    return m_generation;
+}
 } // namespace AdaptiveCards
@@ -48,8 +48,17 @@ public:
     void RemoveParser(std::string const& elementType);
     std::shared_ptr<AdaptiveCards::BaseCardElementParser> GetParser(std::string const& elementType) const;
 
+    // Identifies the set of custom parsers registered: 0 until the first AddParser() or RemoveParser(), and after
+    // that a value that changes with every call to either and that no other registration has had. Parsers aren't
+    // compared, so a parser freed and another allocated at the same address can't be mistaken for it.
+    size_t GetFingerprint() const;
+
 private:
+    // hands out generations, so that they're unique across registrations
+    static std::atomic<size_t> s_nextGeneration;
+    size_t m_generation;
     std::unordered_set<std::string> m_knownElements;
+    // type -> wrapped parser
     std::unordered_map<std::string, std::shared_ptr<AdaptiveCards::BaseCardElementParser>, CaseInsensitiveHash, CaseInsensitiveEqualTo> m_cardElementParsers;
 };
 } // namespace AdaptiveCards
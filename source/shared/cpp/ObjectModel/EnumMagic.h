@@ -2,30 +2,10 @@
 // Licensed under the MIT License.
 #pragma once
 #include "pch.h"
+#include "CaseInsensitive.h"
 
 namespace AdaptiveCards
 {
-struct CaseInsensitiveEqualTo
-{
-    template <typename T>
-    bool operator()(T const& lhs, T const& rhs) const noexcept
-    {
-        return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), [](auto a, auto b) {
-            return std::toupper(a) == std::toupper(b);
-        });
-    }
-};
-
-struct CaseInsensitiveHash
-{
-    template <typename T>
-    size_t operator()(T const& keyval) const noexcept
-    {
-        return std::accumulate(
-            std::cbegin(keyval), std::cend(keyval), size_t{0}, [](size_t acc, auto c) { return acc + std::toupper(c); });
-    }
-};
-
 struct EnumHash
 {
     template <typename T>
@@ -37,7 +17,9 @@ struct EnumHash
 
 namespace EnumHelpers
 {
-    // Manage mapping T<->std::string using two internal unordered_maps.
+    // Manage mapping T<->std::string using two internal unordered_maps. Enums whose values are small and
+    // non-negative (i.e. all of ours) also get a table indexed by value, so that the very hot T->std::string
+    // direction (AdaptiveCardSchemaKeyToString in particular) is an array index rather than a hash map probe.
     template <typename T>
     class EnumMapping
     {
@@ -47,6 +29,7 @@ namespace EnumHelpers
             _enumToString{t.begin(), t.end()}, _stringToEnum(t.size())
         {
             _GenerateStringToEnumMap();
+            _GenerateEnumToStringTable();
         }
 
         // Initialize with two lists -> t1 is our forward list and t2 contains additional terms to use in addition
@@ -55,16 +38,32 @@ namespace EnumHelpers
             _enumToString{t1.begin(), t1.end()}, _stringToEnum(t2.begin(), t2.end())
         {
             _GenerateStringToEnumMap();
+            _GenerateEnumToStringTable();
         }
 
         const std::string& toString(T t) const
         {
+            const auto index = static_cast<size_t>(t);
+            if (index < _enumToStringTable.size() && _enumToStringTable[index] != nullptr)
+            {
+                return *_enumToStringTable[index];
+            }
+            // unmapped (or out of table) values still throw std::out_of_range
             return _enumToString.at(t);
         }
         T fromString(const std::string& str) const
         {
             return _stringToEnum.at(str);
         }
+        std::optional<T> tryFromString(const std::string& str) const
+        {
+            const auto found = _stringToEnum.find(str);
+            if (found == _stringToEnum.end())
+            {
+                return std::nullopt;
+            }
+            return found->second;
+        }
 
     private:
         inline void _GenerateStringToEnumMap()
@@ -75,8 +74,32 @@ namespace EnumHelpers
             }
         }
 
+        inline void _GenerateEnumToStringTable()
+        {
+            // Only build the table when it would be dense enough to be worth it; strings live in the nodes of
+            // _enumToString, so pointers to them stay valid for the lifetime of the mapping.
+            const size_t maxTableSize = 2 * _enumToString.size() + 16;
+            size_t tableSize = 0;
+            for (const auto& kv : _enumToString)
+            {
+                const auto value = static_cast<long long>(kv.first);
+                if (value < 0 || static_cast<size_t>(value) >= maxTableSize)
+                {
+                    return;
+                }
+                tableSize = std::max(tableSize, static_cast<size_t>(value) + 1);
+            }
+
+            _enumToStringTable.resize(tableSize, nullptr);
+            for (const auto& kv : _enumToString)
+            {
+                _enumToStringTable[static_cast<size_t>(kv.first)] = &kv.second;
+            }
+        }
+
         const std::unordered_map<T, std::string, EnumHash> _enumToString;
         std::unordered_map<std::string, T, CaseInsensitiveHash, CaseInsensitiveEqualTo> _stringToEnum;
+        std::vector<const std::string*> _enumToStringTable;
     };
 } // namespace EnumHelpers
 
@@ -87,7 +110,8 @@ namespace EnumHelpers
         const EnumMapping<ENUMTYPE>& get##ENUMTYPE##Enum(); \
     } \
     const std::string& ENUMTYPE##ToString(const ENUMTYPE t); \
-    ENUMTYPE ENUMTYPE##FromString(const std::string& t);
+    ENUMTYPE ENUMTYPE##FromString(const std::string& t); \
+    std::optional<ENUMTYPE> ENUMTYPE##TryFromString(const std::string& t);
 
 #define _DEFINE_ADAPTIVECARD_ENUM_INVARIANT(ENUMTYPE, ...) \
     namespace EnumHelpers \
@@ -101,6 +125,10 @@ namespace EnumHelpers
     const std::string& ENUMTYPE##ToString(const ENUMTYPE t) \
     { \
         return EnumHelpers::get##ENUMTYPE##Enum().toString(t); \
+    } \
+    std::optional<ENUMTYPE> ENUMTYPE##TryFromString(const std::string& t) \
+    { \
+        return EnumHelpers::get##ENUMTYPE##Enum().tryFromString(t); \
     }
 
 // Define mapping functions for ENUMTYPE. Throw an exception if caller passes in a string that doesn't map
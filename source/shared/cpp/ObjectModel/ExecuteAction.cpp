@@ -77,10 +77,16 @@ std::shared_ptr<BaseActionElement> ExecuteActionParser::Deserialize(ParseContext
 {
     std::shared_ptr<ExecuteAction> executeAction = BaseActionElement::Deserialize<ExecuteAction>(context, json);
 
-    executeAction->SetDataJson(ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Data));
+    const Json::Value& data = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Data);
+    executeAction->SetDataJson(data);
+    ParseStatistics* statistics = context.GetStatistics();
+    if (statistics && !data.isNull())
+    {
+        ++statistics->jsonValueCopies;
+    }
     executeAction->SetVerb(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Verb));
     executeAction->SetAssociatedInputs(ParseUtil::GetEnumValue<AssociatedInputs>(
-        json, AdaptiveCardSchemaKey::AssociatedInputs, AssociatedInputs::Auto, AssociatedInputsFromString));
+        json, AdaptiveCardSchemaKey::AssociatedInputs, AssociatedInputs::Auto, AssociatedInputsTryFromString));
 
     return executeAction;
 }
@@ -92,8 +98,9 @@ std::shared_ptr<BaseActionElement> ExecuteActionParser::DeserializeFromString(Pa
 
 void ExecuteAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Data),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Verb),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AssociatedInputs)});
+    SetKnownProperties(knownProperties);
 }
@@ -26,7 +26,7 @@ std::shared_ptr<Fact> Fact::Deserialize(ParseContext& context, const Json::Value
             WarningStatusCode::RequiredPropertyMissing,
             "non-empty string has to be given for either title or value, none given"));
     }
-    auto fact = std::make_shared<Fact>(title, value);
+    auto fact = context.MakeShared<Fact>(title, value);
     fact->SetLanguage(context.GetLanguage());
 
     return fact;
@@ -81,6 +81,16 @@ DateTimePreparser Fact::GetValueForDateParsing() const
     return DateTimePreparser(m_value);
 }
 
+std::shared_ptr<const MarkDownResult> Fact::GetTitleMarkDownResult(const std::string& title, MarkDownCache* cache) const
+{
+    return m_titleMarkDownResult.Transform(title, cache);
+}
+
+std::shared_ptr<const MarkDownResult> Fact::GetValueMarkDownResult(const std::string& value, MarkDownCache* cache) const
+{
+    return m_valueMarkDownResult.Transform(value, cache);
+}
+
 const std::string& Fact::GetLanguage() const
 {
     return m_language;
@@ -5,6 +5,7 @@
 #include "pch.h"
 #include "ElementParserRegistration.h"
 #include "DateTimePreparser.h"
+#include "MarkDownCache.h"
 
 namespace AdaptiveCards
 {
@@ -25,6 +26,11 @@ public:
     DateTimePreparser GetTitleForDateParsing() const;
     DateTimePreparser GetValueForDateParsing() const;
 
+    // markdown of the title and value as the host renders them, kept on the fact for later renders, see
+    // MarkDownResultHolder
+    std::shared_ptr<const MarkDownResult> GetTitleMarkDownResult(const std::string& title, MarkDownCache* cache = nullptr) const;
+    std::shared_ptr<const MarkDownResult> GetValueMarkDownResult(const std::string& value, MarkDownCache* cache = nullptr) const;
+
     void SetLanguage(const std::string& value);
     const std::string& GetLanguage() const;
 
@@ -35,5 +41,7 @@ private:
     std::string m_title;
     std::string m_value;
     std::string m_language;
+    MarkDownResultHolder m_titleMarkDownResult;
+    MarkDownResultHolder m_valueMarkDownResult;
 };
 } // namespace AdaptiveCards
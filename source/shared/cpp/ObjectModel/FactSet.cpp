@@ -65,5 +65,7 @@ std::shared_ptr<BaseCardElement> FactSetParser::DeserializeFromString(ParseConte
 
 void FactSet::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Facts)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Facts)});
+    SetKnownProperties(knownProperties);
 }
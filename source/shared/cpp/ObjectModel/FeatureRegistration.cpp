@@ -56,13 +56,7 @@ SemanticVersion FeatureRegistration::GetAdaptiveCardsVersion() const
 
 std::string FeatureRegistration::GetFeatureVersion(const std::string& featureName) const
 {
-    if (m_supportedFeatures.find(featureName) != m_supportedFeatures.end())
-    {
-        return m_supportedFeatures.at(featureName);
-    }
-    else
-    {
-        return "";
-    }
+    const auto feature = m_supportedFeatures.find(featureName);
+    return (feature != m_supportedFeatures.end()) ? feature->second : std::string();
 }
 } // namespace AdaptiveCards
@@ -9,27 +9,6 @@ namespace AdaptiveCards
 {
 constexpr const char* const c_adaptiveCardsFeature = "adaptiveCards";
 
-namespace ParseUtil
-{
-    std::string ToLowercase(const std::string& value);
-}
-
-struct CaseInsensitiveKeyHash
-{
-    size_t operator()(const std::string& keyVal) const
-    {
-        return std::hash<std::string>{}(ParseUtil::ToLowercase(keyVal));
-    }
-};
-
-struct CaseInsensitiveKeyEquals
-{
-    bool operator()(const std::string& leftVal, const std::string& rightVal) const
-    {
-        return (ParseUtil::ToLowercase(leftVal) == ParseUtil::ToLowercase(rightVal));
-    }
-};
-
 class SemanticVersion;
 class FeatureRegistration
 {
@@ -42,6 +21,8 @@ public:
     std::string GetFeatureVersion(const std::string& featureName) const;
 
 private:
-    std::unordered_map<std::string, std::string, CaseInsensitiveKeyHash, CaseInsensitiveKeyEquals> m_supportedFeatures;
+    friend class HostFeatures;
+
+    std::unordered_map<std::string, std::string, CaseInsensitiveHash, CaseInsensitiveEqualTo> m_supportedFeatures;
 };
 } // namespace AdaptiveCards
@@ -0,0 +1,477 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "HostFeatures.h"
+#include "ActionSet.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "FeatureRegistration.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "ParseResult.h"
+#include "RichTextBlock.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+#include "Table.h"
+#include "TableCell.h"
+#include "TableRow.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "Util.h"
+#include <typeinfo>
+
+namespace
+{
+using namespace AdaptiveCards;
+
+// Thrown when an element the host can't render has no fallback of its own, so that the nearest ancestor with
+// fallback falls back instead (see XamlHelpers::RenderFallback)
+struct FallbackToAncestor
+{
+};
+
+// Hosts' subclasses of built-in elements are treated like any other custom element: left as they are
+template <typename T>
+bool IsExactly(const BaseElement& element)
+{
+    return typeid(element) == typeid(T);
+}
+
+class HostResolver
+{
+public:
+    explicit HostResolver(const HostFeatures& hostFeatures) : m_hostFeatures(hostFeatures)
+    {
+    }
+
+    // Returns a resolved copy of the card, or nullptr if the host supports all of it
+    std::shared_ptr<AdaptiveCard> ResolveCard(const AdaptiveCard& card)
+    {
+        auto body = ResolveElements(card.GetBody(), false);
+        auto actions = ResolveActions(card.GetActions());
+        const auto selectAction = ResolveAction(card.GetSelectAction());
+        if (!body && !actions && selectAction == card.GetSelectAction())
+        {
+            return nullptr;
+        }
+
+        auto copy = std::make_shared<AdaptiveCard>(card);
+        if (body)
+        {
+            copy->GetBody() = std::move(*body);
+        }
+        if (actions)
+        {
+            copy->GetActions() = std::move(*actions);
+        }
+        copy->SetSelectAction(selectAction);
+        return copy;
+    }
+
+    std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& GetWarnings()
+    {
+        return m_warnings;
+    }
+
+private:
+    // Returns what to render in the element's place: the element itself, a copy of it with its contents resolved,
+    // its resolved fallback content, or nullptr to drop it
+    std::shared_ptr<BaseCardElement> ResolveElement(const std::shared_ptr<BaseCardElement>& element, bool ancestorHasFallback)
+    {
+        if (!element)
+        {
+            return element;
+        }
+
+        if (!m_hostFeatures.IsSupported(*element))
+        {
+            return PerformFallback(*element, ancestorHasFallback);
+        }
+
+        const bool hasFallback = element->GetFallbackType() != FallbackType::None;
+        const size_t warningCount = m_warnings.size();
+        try
+        {
+            return ResolveContents(element, ancestorHasFallback || hasFallback);
+        }
+        catch (const FallbackToAncestor&)
+        {
+            if (!hasFallback)
+            {
+                throw;
+            }
+
+            // none of the contents will be rendered
+            m_warnings.resize(warningCount);
+            return PerformFallback(*element, ancestorHasFallback);
+        }
+    }
+
+    std::shared_ptr<BaseCardElement> PerformFallback(const BaseCardElement& element, bool ancestorHasFallback)
+    {
+        switch (element.GetFallbackType())
+        {
+        case FallbackType::Content:
+            if (const auto fallbackContent = std::dynamic_pointer_cast<BaseCardElement>(element.GetFallbackContent()))
+            {
+                AddWarning(WarningStatusCode::UnknownElementType,
+                           "Performing fallback for '" + element.GetElementTypeString() + "' (fallback element type: '" +
+                               fallbackContent->GetElementTypeString() + "')");
+                return ResolveElement(fallbackContent, ancestorHasFallback);
+            }
+            break;
+        case FallbackType::Drop:
+            break;
+        default:
+            if (ancestorHasFallback)
+            {
+                throw FallbackToAncestor();
+            }
+            AddWarning(WarningStatusCode::UnknownElementType, "Dropping unsupported element '" + element.GetElementTypeString() + "'");
+            return nullptr;
+        }
+
+        AddWarning(WarningStatusCode::UnknownElementType, "Dropping element '" + element.GetElementTypeString() + "' for fallback");
+        return nullptr;
+    }
+
+    // The element is supported; resolve what's in it
+    std::shared_ptr<BaseCardElement> ResolveContents(const std::shared_ptr<BaseCardElement>& element, bool ancestorHasFallback)
+    {
+        if (IsExactly<Container>(*element) || IsExactly<TableCell>(*element))
+        {
+            const auto container = std::static_pointer_cast<Container>(element);
+            auto items = ResolveElements(container->GetItems(), ancestorHasFallback);
+            const auto selectAction = ResolveAction(container->GetSelectAction());
+            if (items || selectAction != container->GetSelectAction())
+            {
+                auto copy = std::static_pointer_cast<Container>(CopyCardElement(*container));
+                if (items)
+                {
+                    copy->GetItems() = std::move(*items);
+                }
+                copy->SetSelectAction(selectAction);
+                return copy;
+            }
+        }
+        else if (IsExactly<Column>(*element))
+        {
+            const auto column = std::static_pointer_cast<Column>(element);
+            auto items = ResolveElements(column->GetItems(), ancestorHasFallback);
+            const auto selectAction = ResolveAction(column->GetSelectAction());
+            if (items || selectAction != column->GetSelectAction())
+            {
+                auto copy = std::static_pointer_cast<Column>(CopyCardElement(*column));
+                if (items)
+                {
+                    copy->GetItems() = std::move(*items);
+                }
+                copy->SetSelectAction(selectAction);
+                return copy;
+            }
+        }
+        else if (IsExactly<ColumnSet>(*element))
+        {
+            const auto columnSet = std::static_pointer_cast<ColumnSet>(element);
+            auto columns = ResolveElements(columnSet->GetColumns(), ancestorHasFallback);
+            const auto selectAction = ResolveAction(columnSet->GetSelectAction());
+            if (columns || selectAction != columnSet->GetSelectAction())
+            {
+                auto copy = std::static_pointer_cast<ColumnSet>(CopyCardElement(*columnSet));
+                if (columns)
+                {
+                    copy->GetColumns() = std::move(*columns);
+                }
+                copy->SetSelectAction(selectAction);
+                return copy;
+            }
+        }
+        else if (IsExactly<Table>(*element))
+        {
+            const auto table = std::static_pointer_cast<Table>(element);
+            if (auto rows = ResolveElements(table->GetRows(), ancestorHasFallback))
+            {
+                auto copy = std::static_pointer_cast<Table>(CopyCardElement(*table));
+                copy->GetRows() = std::move(*rows);
+                return copy;
+            }
+        }
+        else if (IsExactly<TableRow>(*element))
+        {
+            const auto row = std::static_pointer_cast<TableRow>(element);
+            if (auto cells = ResolveElements(row->GetCells(), ancestorHasFallback))
+            {
+                auto copy = std::static_pointer_cast<TableRow>(CopyCardElement(*row));
+                copy->GetCells() = std::move(*cells);
+                return copy;
+            }
+        }
+        else if (IsExactly<ActionSet>(*element))
+        {
+            const auto actionSet = std::static_pointer_cast<ActionSet>(element);
+            if (auto actions = ResolveActions(actionSet->GetActions()))
+            {
+                auto copy = std::static_pointer_cast<ActionSet>(CopyCardElement(*actionSet));
+                copy->GetActions() = std::move(*actions);
+                return copy;
+            }
+        }
+        else if (IsExactly<Image>(*element))
+        {
+            const auto image = std::static_pointer_cast<Image>(element);
+            const auto selectAction = ResolveAction(image->GetSelectAction());
+            if (selectAction != image->GetSelectAction())
+            {
+                auto copy = std::static_pointer_cast<Image>(CopyCardElement(*image));
+                copy->SetSelectAction(selectAction);
+                return copy;
+            }
+        }
+        else if (IsExactly<ImageSet>(*element))
+        {
+            const auto imageSet = std::static_pointer_cast<ImageSet>(element);
+            if (auto images = ResolveElements(imageSet->GetImages(), ancestorHasFallback))
+            {
+                auto copy = std::static_pointer_cast<ImageSet>(CopyCardElement(*imageSet));
+                copy->GetImages() = std::move(*images);
+                return copy;
+            }
+        }
+        else if (IsExactly<RichTextBlock>(*element))
+        {
+            const auto richTextBlock = std::static_pointer_cast<RichTextBlock>(element);
+            if (auto inlines = ResolveInlines(richTextBlock->GetInlines()))
+            {
+                auto copy = std::static_pointer_cast<RichTextBlock>(CopyCardElement(*richTextBlock));
+                copy->GetInlines() = std::move(*inlines);
+                return copy;
+            }
+        }
+        else if (IsExactly<TextInput>(*element))
+        {
+            const auto textInput = std::static_pointer_cast<TextInput>(element);
+            const auto inlineAction = ResolveAction(textInput->GetInlineAction());
+            if (inlineAction != textInput->GetInlineAction())
+            {
+                auto copy = std::static_pointer_cast<TextInput>(CopyCardElement(*textInput));
+                copy->SetInlineAction(inlineAction);
+                return copy;
+            }
+        }
+
+        return element;
+    }
+
+    // If any of the elements changed, returns the resolved list
+    template <typename T>
+    std::optional<std::vector<std::shared_ptr<T>>> ResolveElements(const std::vector<std::shared_ptr<T>>& elements, bool ancestorHasFallback)
+    {
+        std::optional<std::vector<std::shared_ptr<T>>> resolved;
+        for (size_t i = 0; i < elements.size(); ++i)
+        {
+            const auto element = ResolveElement(elements[i], ancestorHasFallback);
+            if (!resolved)
+            {
+                if (element == elements[i])
+                {
+                    continue;
+                }
+                resolved.emplace(elements.begin(), elements.begin() + i);
+            }
+
+            // fallback content of the wrong type for its parent (e.g. an Image in an ImageSet that falls back to a
+            // TextBlock) can't be rendered
+            if (auto typedElement = std::dynamic_pointer_cast<T>(element))
+            {
+                resolved->push_back(std::move(typedElement));
+            }
+            else if (element)
+            {
+                AddWarning(WarningStatusCode::UnknownElementType,
+                           "Dropping fallback content '" + element->GetElementTypeString() + "', which can't stand in for '" +
+                               elements[i]->GetElementTypeString() + "'");
+            }
+        }
+        return resolved;
+    }
+
+    std::optional<std::vector<std::shared_ptr<BaseActionElement>>> ResolveActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions)
+    {
+        std::optional<std::vector<std::shared_ptr<BaseActionElement>>> resolved;
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            auto action = ResolveAction(actions[i]);
+            if (!resolved)
+            {
+                if (action == actions[i])
+                {
+                    continue;
+                }
+                resolved.emplace(actions.begin(), actions.begin() + i);
+            }
+
+            if (action)
+            {
+                resolved->push_back(std::move(action));
+            }
+        }
+        return resolved;
+    }
+
+    // Actions fall back like elements, except that an action without fallback is dropped rather than handing it up
+    // to its parent (see ActionHelpers::BuildAction)
+    std::shared_ptr<BaseActionElement> ResolveAction(const std::shared_ptr<BaseActionElement>& action)
+    {
+        std::shared_ptr<BaseActionElement> resolved = action;
+        while (resolved && !m_hostFeatures.IsSupported(*resolved))
+        {
+            const std::string& type = resolved->GetElementTypeString();
+            if (resolved->GetFallbackType() == FallbackType::Content)
+            {
+                resolved = std::dynamic_pointer_cast<BaseActionElement>(resolved->GetFallbackContent());
+                if (resolved)
+                {
+                    AddWarning(WarningStatusCode::UnknownActionElementType,
+                               "Performing fallback for '" + type + "' (fallback action type: '" + resolved->GetElementTypeString() + "')");
+                }
+            }
+            else
+            {
+                AddWarning(WarningStatusCode::UnknownActionElementType,
+                           (resolved->GetFallbackType() == FallbackType::Drop) ? "Dropping action '" + type + "' for fallback" :
+                                                                                 "Dropping unsupported action '" + type + "'");
+                resolved = nullptr;
+            }
+        }
+
+        if (resolved && IsExactly<ShowCardAction>(*resolved))
+        {
+            const auto showCardAction = std::static_pointer_cast<ShowCardAction>(resolved);
+            if (const auto card = showCardAction->GetCard())
+            {
+                if (auto resolvedCard = ResolveCard(*card))
+                {
+                    auto copy = std::make_shared<ShowCardAction>(*showCardAction);
+                    copy->SetCard(resolvedCard);
+                    return copy;
+                }
+            }
+        }
+        return resolved;
+    }
+
+    std::optional<std::vector<std::shared_ptr<Inline>>> ResolveInlines(const std::vector<std::shared_ptr<Inline>>& inlines)
+    {
+        std::optional<std::vector<std::shared_ptr<Inline>>> resolved;
+        for (size_t i = 0; i < inlines.size(); ++i)
+        {
+            const auto textRun = std::dynamic_pointer_cast<TextRun>(inlines[i]);
+            if (!textRun || typeid(*textRun) != typeid(TextRun))
+            {
+                continue;
+            }
+
+            const auto selectAction = ResolveAction(textRun->GetSelectAction());
+            if (selectAction != textRun->GetSelectAction())
+            {
+                if (!resolved)
+                {
+                    resolved = inlines;
+                }
+                auto copy = std::make_shared<TextRun>(*textRun);
+                copy->SetSelectAction(selectAction);
+                (*resolved)[i] = std::move(copy);
+            }
+        }
+        return resolved;
+    }
+
+    void AddWarning(WarningStatusCode statusCode, const std::string& message)
+    {
+        m_warnings.push_back(std::make_shared<AdaptiveCardParseWarning>(statusCode, message));
+    }
+
+    const HostFeatures& m_hostFeatures;
+    std::vector<std::shared_ptr<AdaptiveCardParseWarning>> m_warnings;
+};
+} // namespace
+
+namespace AdaptiveCards
+{
+HostFeatures::HostFeatures(const FeatureRegistration& featureRegistration, std::unordered_set<std::string> unsupportedTypes) :
+    m_unsupportedTypes(std::move(unsupportedTypes))
+{
+    m_features.reserve(featureRegistration.m_supportedFeatures.size());
+    for (const auto& feature : featureRegistration.m_supportedFeatures)
+    {
+        std::optional<SemanticVersion> version;
+        if (feature.second != "*")
+        {
+            version.emplace(feature.second);
+        }
+        m_features.push_back({feature.first, std::move(version)});
+    }
+}
+
+const HostFeatures::Feature* HostFeatures::FindFeature(const std::string& name) const
+{
+    for (const auto& feature : m_features)
+    {
+        if (CaseInsensitive::Equals(feature.name, name))
+        {
+            return &feature;
+        }
+    }
+    return nullptr;
+}
+
+bool HostFeatures::MeetsRequirements(const BaseElement& element) const
+{
+    for (const auto& requirement : element.GetRequirements())
+    {
+        const Feature* feature = FindFeature(requirement.first);
+        if (!feature || (feature->version && *feature->version < requirement.second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HostFeatures::IsSupported(const BaseElement& element) const
+{
+    if (const auto cardElement = dynamic_cast<const BaseCardElement*>(&element))
+    {
+        if (cardElement->GetElementType() == CardElementType::Unknown)
+        {
+            return false;
+        }
+    }
+    else if (const auto actionElement = dynamic_cast<const BaseActionElement*>(&element))
+    {
+        if (actionElement->GetElementType() == ActionType::UnknownAction)
+        {
+            return false;
+        }
+    }
+
+    if (!m_unsupportedTypes.empty() && m_unsupportedTypes.count(element.GetElementTypeString()))
+    {
+        return false;
+    }
+
+    return MeetsRequirements(element);
+}
+
+std::shared_ptr<ParseResult> HostFeatures::Resolve(const AdaptiveCard& card) const
+{
+    HostResolver resolver(*this);
+    auto resolved = resolver.ResolveCard(card);
+    if (!resolved)
+    {
+        resolved = std::make_shared<AdaptiveCard>(card);
+    }
+    return std::make_shared<ParseResult>(std::move(resolved), std::move(resolver.GetWarnings()));
+}
+} // namespace AdaptiveCards
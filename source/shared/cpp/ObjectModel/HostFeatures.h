@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "SemanticVersion.h"
+
+namespace AdaptiveCards
+{
+class AdaptiveCard;
+class BaseElement;
+class FeatureRegistration;
+class ParseResult;
+
+// What a host can render: the features it registered, with their versions parsed up front, and the element and
+// action types it has no renderer for. Built once per host (or whenever its registration changes) and then used to
+// resolve any number of cards.
+class HostFeatures
+{
+public:
+    // unsupportedTypes are element and action type names (e.g. "Media" or "Action.Execute") that the host can't
+    // render. Elements and actions whose type the parser didn't know are never supported.
+    explicit HostFeatures(const FeatureRegistration& featureRegistration, std::unordered_set<std::string> unsupportedTypes = {});
+
+    // Same as BaseElement::MeetsRequirements(), without parsing any versions. A feature registered with version "*"
+    // meets any requirement on it.
+    bool MeetsRequirements(const BaseElement& element) const;
+
+    // Whether the host can render the element itself (its contents aside)
+    bool IsSupported(const BaseElement& element) const;
+
+    // Returns the card as the host should render it. Elements and actions the host doesn't support are replaced by
+    // their fallback content or dropped, following the rules renderers use: an element without fallback hands the
+    // fallback up to the nearest ancestor that has one, or is dropped if there isn't one. The warnings describe each
+    // fallback taken.
+    //
+    // Unchanged elements are shared with the original card, so neither card may be modified afterwards. Fallback
+    // content of supported elements is left in place; renderers never use it.
+    std::shared_ptr<ParseResult> Resolve(const AdaptiveCard& card) const;
+
+private:
+    struct Feature
+    {
+        std::string name;
+        // std::nullopt for "*"
+        std::optional<SemanticVersion> version;
+    };
+
+    const Feature* FindFeature(const std::string& name) const;
+
+    // hosts register few enough features that a scan beats hashing
+    std::vector<Feature> m_features;
+    std::unordered_set<std::string> m_unsupportedTypes;
+};
+} // namespace AdaptiveCards
@@ -0,0 +1,335 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ImmutableCard.h"
+#include "ActionSet.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "NumberInput.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+#include "Table.h"
+#include "TableRow.h"
+#include "TextInput.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+#include "Util.h"
+
+namespace
+{
+using namespace AdaptiveCards;
+using ElementEdit = std::function<std::shared_ptr<BaseCardElement>(const std::shared_ptr<BaseCardElement>&)>;
+
+std::shared_ptr<BaseCardElement> EditElement(const std::shared_ptr<BaseCardElement>& element, const std::string& id, const ElementEdit& edit);
+std::shared_ptr<AdaptiveCard> EditCard(const AdaptiveCard& card, const std::string& id, const ElementEdit& edit);
+
+template <typename T>
+bool IsExactly(const BaseElement& element)
+{
+    return typeid(element) == typeid(T);
+}
+
+// Containers on the path down to an edit are copied, which can't be done to a host's subclass of a built-in one
+// without slicing it
+template <typename T>
+std::shared_ptr<T> CopyContainer(const T& container, const std::string& id)
+{
+    if (!IsExactly<T>(container))
+    {
+        throw std::invalid_argument("Can't edit '" + id + "' below custom element '" + container.GetElementTypeString() + "'");
+    }
+    return std::static_pointer_cast<T>(CopyCardElement(container));
+}
+
+// If the element is in children (or under one of them), returns a copy of children with the edited child in its
+// place. The children themselves aren't copied.
+template <typename T>
+std::optional<std::vector<std::shared_ptr<T>>> EditChildren(const std::vector<std::shared_ptr<T>>& children,
+                                                            const std::string& id,
+                                                            const ElementEdit& edit)
+{
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        if (auto edited = EditElement(children[i], id, edit))
+        {
+            auto typedEdited = std::dynamic_pointer_cast<T>(edited);
+            if (!typedEdited)
+            {
+                throw std::invalid_argument("The replacement for '" + id + "' isn't the type of element its parent holds");
+            }
+
+            auto editedChildren = children;
+            editedChildren[i] = std::move(typedEdited);
+            return editedChildren;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::vector<std::shared_ptr<BaseActionElement>>> EditActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions,
+                                                                           const std::string& id,
+                                                                           const ElementEdit& edit)
+{
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        const auto showCardAction = std::dynamic_pointer_cast<ShowCardAction>(actions[i]);
+        if (!showCardAction || !showCardAction->GetCard())
+        {
+            continue;
+        }
+
+        if (auto editedCard = EditCard(*showCardAction->GetCard(), id, edit))
+        {
+            if (!IsExactly<ShowCardAction>(*showCardAction))
+            {
+                throw std::invalid_argument("Can't edit '" + id + "' below custom action '" + showCardAction->GetElementTypeString() + "'");
+            }
+
+            auto editedAction = std::make_shared<ShowCardAction>(*showCardAction);
+            editedAction->SetCard(editedCard);
+
+            auto editedActions = actions;
+            editedActions[i] = std::move(editedAction);
+            return editedActions;
+        }
+    }
+    return std::nullopt;
+}
+
+// Returns a copy of element with the edit made somewhere in it, or nullptr if it doesn't contain the id
+std::shared_ptr<BaseCardElement> EditElement(const std::shared_ptr<BaseCardElement>& element, const std::string& id, const ElementEdit& edit)
+{
+    if (!element)
+    {
+        return nullptr;
+    }
+
+    if (element->GetId() == id)
+    {
+        auto edited = edit(element);
+        if (!edited)
+        {
+            throw std::invalid_argument("The replacement for '" + id + "' is null");
+        }
+        return edited;
+    }
+
+    // Hosts' subclasses of the built-in containers are searched too, so that an edit below one is reported as such
+    // rather than as a missing id
+    switch (element->GetElementType())
+    {
+    case CardElementType::Container:
+        if (const auto container = std::dynamic_pointer_cast<Container>(element))
+        {
+            if (auto items = EditChildren(container->GetItems(), id, edit))
+            {
+                auto copy = CopyContainer(*container, id);
+                copy->GetItems() = std::move(*items);
+                return copy;
+            }
+        }
+        break;
+    case CardElementType::TableCell:
+        if (const auto cell = std::dynamic_pointer_cast<TableCell>(element))
+        {
+            if (auto items = EditChildren(cell->GetItems(), id, edit))
+            {
+                auto copy = CopyContainer(*cell, id);
+                copy->GetItems() = std::move(*items);
+                return copy;
+            }
+        }
+        break;
+    case CardElementType::Column:
+        if (const auto column = std::dynamic_pointer_cast<Column>(element))
+        {
+            if (auto items = EditChildren(column->GetItems(), id, edit))
+            {
+                auto copy = CopyContainer(*column, id);
+                copy->GetItems() = std::move(*items);
+                return copy;
+            }
+        }
+        break;
+    case CardElementType::ColumnSet:
+        if (const auto columnSet = std::dynamic_pointer_cast<ColumnSet>(element))
+        {
+            if (auto columns = EditChildren(columnSet->GetColumns(), id, edit))
+            {
+                auto copy = CopyContainer(*columnSet, id);
+                copy->GetColumns() = std::move(*columns);
+                return copy;
+            }
+        }
+        break;
+    case CardElementType::Table:
+        if (const auto table = std::dynamic_pointer_cast<Table>(element))
+        {
+            if (auto rows = EditChildren(table->GetRows(), id, edit))
+            {
+                auto copy = CopyContainer(*table, id);
+                copy->GetRows() = std::move(*rows);
+                return copy;
+            }
+        }
+        break;
+    case CardElementType::TableRow:
+        if (const auto row = std::dynamic_pointer_cast<TableRow>(element))
+        {
+            if (auto cells = EditChildren(row->GetCells(), id, edit))
+            {
+                auto copy = CopyContainer(*row, id);
+                copy->GetCells() = std::move(*cells);
+                return copy;
+            }
+        }
+        break;
+    case CardElementType::ActionSet:
+        if (const auto actionSet = std::dynamic_pointer_cast<ActionSet>(element))
+        {
+            if (auto actions = EditActions(actionSet->GetActions(), id, edit))
+            {
+                auto copy = CopyContainer(*actionSet, id);
+                copy->GetActions() = std::move(*actions);
+                return copy;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<AdaptiveCard> EditCard(const AdaptiveCard& card, const std::string& id, const ElementEdit& edit)
+{
+    if (auto body = EditChildren(card.GetBody(), id, edit))
+    {
+        auto copy = std::make_shared<AdaptiveCard>(card);
+        copy->GetBody() = std::move(*body);
+        return copy;
+    }
+
+    if (auto actions = EditActions(card.GetActions(), id, edit))
+    {
+        auto copy = std::make_shared<AdaptiveCard>(card);
+        copy->GetActions() = std::move(*actions);
+        return copy;
+    }
+
+    return nullptr;
+}
+
+std::optional<double> ParseNumberInputValue(const std::string& value)
+{
+    if (value.empty())
+    {
+        return std::nullopt;
+    }
+
+    size_t parsedLength = 0;
+    const double number = std::stod(value, &parsedLength);
+    if (parsedLength != value.size())
+    {
+        throw std::invalid_argument("'" + value + "' is not a number");
+    }
+    return number;
+}
+} // namespace
+
+namespace AdaptiveCards
+{
+ImmutableCard::ImmutableCard(std::shared_ptr<const AdaptiveCard> card) : m_card(std::move(card))
+{
+    if (!m_card)
+    {
+        throw std::invalid_argument("card is null");
+    }
+}
+
+std::shared_ptr<const AdaptiveCard> ImmutableCard::GetCard() const
+{
+    return m_card;
+}
+
+ImmutableCard ImmutableCard::WithInputValue(const std::string& id, const std::string& value) const
+{
+    return Apply(id, [&id, &value](const std::shared_ptr<BaseCardElement>& element) {
+        switch (element->GetElementType())
+        {
+        case CardElementType::ChoiceSetInput:
+        {
+            auto copy = CopyCardElement(*element);
+            std::static_pointer_cast<ChoiceSetInput>(copy)->SetValue(value);
+            return copy;
+        }
+        case CardElementType::DateInput:
+        {
+            auto copy = CopyCardElement(*element);
+            std::static_pointer_cast<DateInput>(copy)->SetValue(value);
+            return copy;
+        }
+        case CardElementType::NumberInput:
+        {
+            const auto number = ParseNumberInputValue(value);
+            auto copy = CopyCardElement(*element);
+            std::static_pointer_cast<NumberInput>(copy)->SetValue(number);
+            return copy;
+        }
+        case CardElementType::TextInput:
+        {
+            auto copy = CopyCardElement(*element);
+            std::static_pointer_cast<TextInput>(copy)->SetValue(value);
+            return copy;
+        }
+        case CardElementType::TimeInput:
+        {
+            auto copy = CopyCardElement(*element);
+            std::static_pointer_cast<TimeInput>(copy)->SetValue(value);
+            return copy;
+        }
+        case CardElementType::ToggleInput:
+        {
+            auto copy = CopyCardElement(*element);
+            std::static_pointer_cast<ToggleInput>(copy)->SetValue(value);
+            return copy;
+        }
+        default:
+            throw std::invalid_argument("'" + id + "' is not an input");
+        }
+    });
+}
+
+ImmutableCard ImmutableCard::WithIsVisible(const std::string& id, bool isVisible) const
+{
+    return WithEdit(id, [isVisible](BaseCardElement& element) { element.SetIsVisible(isVisible); });
+}
+
+ImmutableCard ImmutableCard::WithElement(const std::string& id, std::shared_ptr<BaseCardElement> replacement) const
+{
+    return Apply(id, [&replacement](const std::shared_ptr<BaseCardElement>&) { return replacement; });
+}
+
+ImmutableCard ImmutableCard::WithEdit(const std::string& id, const std::function<void(BaseCardElement&)>& edit) const
+{
+    return Apply(id, [&edit](const std::shared_ptr<BaseCardElement>& element) {
+        auto copy = CopyCardElement(*element);
+        edit(*copy);
+        return copy;
+    });
+}
+
+ImmutableCard ImmutableCard::Apply(const std::string& id, const ElementEdit& edit) const
+{
+    auto card = EditCard(*m_card, id, edit);
+    if (!card)
+    {
+        throw std::invalid_argument("No element has the id '" + id + "'");
+    }
+    return ImmutableCard(std::move(card));
+}
+} // namespace AdaptiveCards
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveCards
+{
+class AdaptiveCard;
+class BaseCardElement;
+
+// An AdaptiveCard that is never modified in place, for making many small variations of one card (e.g. a cached
+// card with each user's input values filled in). Every edit returns a new ImmutableCard whose tree shares all of its
+// unchanged elements with the original; only the edited element and the containers on the path down to it are
+// copied, so a variant costs memory in proportion to the depth of the edit rather than the size of the card.
+//
+// Elements are found by id anywhere in the card's body, including inside containers, column sets, tables, action
+// sets and the cards of Action.ShowCard actions (fallback content isn't searched). Edits throw std::invalid_argument
+// if no element has the id, or if it's below a custom element or action (including hosts' subclasses of built-in
+// containers), since the elements on the path down to an edit are copied and custom ones can't be.
+//
+// The card handed to the constructor, and every card returned by GetCard(), must not be modified afterwards:
+// they're shared with the other variants.
+class ImmutableCard
+{
+public:
+    explicit ImmutableCard(std::shared_ptr<const AdaptiveCard> card);
+
+    std::shared_ptr<const AdaptiveCard> GetCard() const;
+
+    // Sets the value of an input. For Input.Number the value is parsed as a number (empty clears it).
+    ImmutableCard WithInputValue(const std::string& id, const std::string& value) const;
+
+    ImmutableCard WithIsVisible(const std::string& id, bool isVisible) const;
+
+    // Replaces an element outright. Elements that live in typed collections (a ColumnSet's columns, a Table's rows
+    // and cells) can only be replaced with an element of the same type.
+    ImmutableCard WithElement(const std::string& id, std::shared_ptr<BaseCardElement> replacement) const;
+
+    // Applies edit to a copy of the element. The copy has its own sub-objects (e.g. a TextBlock's text properties or
+    // a RichTextBlock's inlines) but shares its child elements with the original, so edit shouldn't reach into
+    // children; edit them by their own id. Only the built-in element types can be copied; use WithElement for custom
+    // elements.
+    ImmutableCard WithEdit(const std::string& id, const std::function<void(BaseCardElement&)>& edit) const;
+
+private:
+    using ElementEdit = std::function<std::shared_ptr<BaseCardElement>(const std::shared_ptr<BaseCardElement>&)>;
+    ImmutableCard Apply(const std::string& id, const ElementEdit& edit) const;
+
+    std::shared_ptr<const AdaptiveCard> m_card;
+};
+} // namespace AdaptiveCards
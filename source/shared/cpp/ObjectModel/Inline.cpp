@@ -6,7 +6,7 @@
 
 using namespace AdaptiveCards;
 
-Inline::Inline(InlineElementType type) : m_type(type)
+Inline::Inline(InlineElementType type) : m_knownProperties(nullptr), m_type(type)
 {
     PopulateKnownPropertiesSet();
 }
@@ -53,5 +53,6 @@ std::shared_ptr<Inline> Inline::Deserialize(ParseContext& context, const Json::V
 
 void Inline::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)});
+    static const std::unordered_set<std::string> knownProperties{AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)};
+    m_knownProperties = &knownProperties;
 }
@@ -33,7 +33,8 @@ public:
     void SetAdditionalProperties(const Json::Value& additionalProperties);
 
 protected:
-    std::unordered_set<std::string> m_knownProperties;
+    // shared by every instance of a type; see BaseElement::SetKnownProperties
+    const std::unordered_set<std::string>* m_knownProperties;
     Json::Value m_additionalProperties;
 
 private:
@@ -8,6 +8,10 @@ namespace AdaptiveCards
 {
 // Used to uniquely identify a single BaseElement-derived object through the course of deserializing. For more
 // details, refer to the giant comment on ID collision detection in ParseContext.cpp.
+//
+// Next() hands out process-wide unique ids and is safe to call from any number of threads. Current() returns the
+// id most recently handed out *on the calling thread*, which is how an element picks up the id its parser wrapper
+// allocated for it just before constructing it, even while other threads are parsing.
 class InternalId
 {
 public:
@@ -40,7 +44,8 @@ public:
     }
 
 private:
-    static unsigned int s_currentInternalId;
+    static std::atomic<unsigned int> s_nextInternalId;
+    static thread_local unsigned int s_currentInternalId;
     InternalId(const unsigned int id);
     unsigned int m_internalId;
 };
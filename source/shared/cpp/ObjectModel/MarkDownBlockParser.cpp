@@ -1,20 +1,19 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "pch.h"
-#include <iostream>
 #include "MarkDownBlockParser.h"
 
 using namespace AdaptiveCards;
 
 // Parses according to each key words
-void MarkDownBlockParser::ParseBlock(std::stringstream& stream)
+void MarkDownBlockParser::ParseBlock(MarkDownCursor& stream)
 {
-    switch (stream.peek())
+    switch (stream.Peek())
     {
         // parses link
     case '[':
     {
-        LinkParser linkParser;
+        LinkParser linkParser(m_store);
         // do syntax check of link
         linkParser.Match(stream);
         // append link result to the rest
@@ -28,7 +27,7 @@ void MarkDownBlockParser::ParseBlock(std::stringstream& stream)
     {
         // add these char as token to code gen list
         char streamChar{};
-        stream.get(streamChar);
+        stream.Get(streamChar);
         m_parsedResult.AddNewTokenToParsedResult(streamChar);
         break;
     }
@@ -37,7 +36,7 @@ void MarkDownBlockParser::ParseBlock(std::stringstream& stream)
     {
         // add new line char as token to code gen list
         char streamChar{};
-        stream.get(streamChar);
+        stream.Get(streamChar);
         m_parsedResult.AddNewLineTokenToParsedResult(streamChar);
         break;
     }
@@ -46,7 +45,7 @@ void MarkDownBlockParser::ParseBlock(std::stringstream& stream)
     case '+':
     case '*':
     {
-        ListParser listParser;
+        ListParser listParser(m_store);
         // do syntax check of list
         listParser.Match(stream);
         // append list result to the rest
@@ -65,7 +64,7 @@ void MarkDownBlockParser::ParseBlock(std::stringstream& stream)
     case '8':
     case '9':
     {
-        OrderedListParser orderedListParser;
+        OrderedListParser orderedListParser(m_store);
         // do syntax check of list
         orderedListParser.Match(stream);
         // append list result to the rest
@@ -78,9 +77,9 @@ void MarkDownBlockParser::ParseBlock(std::stringstream& stream)
     }
 }
 
-void MarkDownBlockParser::ParseTextAndEmphasis(std::stringstream& stream)
+void MarkDownBlockParser::ParseTextAndEmphasis(MarkDownCursor& stream)
 {
-    EmphasisParser emphasisParser;
+    EmphasisParser emphasisParser(m_store);
     // do syntax check of normal text + emphasis
     emphasisParser.Match(stream);
     // append result to the rest
@@ -92,11 +91,12 @@ void MarkDownBlockParser::ParseTextAndEmphasis(std::stringstream& stream)
 // capture until it can't capture anymore.
 // it moves two states, emphasis state and text state,
 // at each transition of state, one token is captured
-void EmphasisParser::Match(std::stringstream& stream)
+void EmphasisParser::Match(MarkDownCursor& stream)
 {
+    m_currentTokenOffset = m_store.text.size();
     while (m_current_state != EmphasisState::Captured)
     {
-        m_current_state = m_stateMachine.at(m_current_state)(*this, stream, m_current_token);
+        m_current_state = (m_current_state == EmphasisState::Text) ? MatchText(*this, stream) : MatchEmphasis(*this, stream);
     }
 }
 
@@ -106,15 +106,15 @@ bool EmphasisParser::IsEmphasisToken(int currentChar)
 }
 
 /// captures text until it see emphasis character. When it does, switch to Emphasis state
-EmphasisParser::EmphasisState EmphasisParser::MatchText(EmphasisParser& parser, std::stringstream& stream, std::string& token)
+EmphasisParser::EmphasisState EmphasisParser::MatchText(EmphasisParser& parser, MarkDownCursor& stream)
 {
-    const int currentChar = stream.peek();
+    const int currentChar = stream.Peek();
     const bool isEmphasisToken = IsEmphasisToken(currentChar);
 
     /// MarkDown keywords
-    if (stream.eof() || (parser.m_lookBehind != DelimiterType::Escape && isEmphasisToken))
+    if (stream.Eof() || (parser.m_lookBehind != DelimiterType::Escape && isEmphasisToken))
     {
-        parser.Flush(currentChar, token);
+        parser.Flush(currentChar);
         return EmphasisState::Captured;
     }
 
@@ -124,16 +124,16 @@ EmphasisParser::EmphasisState EmphasisParser::MatchText(EmphasisParser& parser,
         parser.CaptureCurrentCollectedStringAsRegularToken();
         const DelimiterType emphasisType = EmphasisParser::GetDelimiterTypeForChar(currentChar);
         // get previous character and update the look behind if it was captured before
-        if (stream.tellg())
+        if (stream.Tell())
         {
-            stream.unget();
-            parser.UpdateLookBehind(stream.get());
+            stream.Unget();
+            parser.UpdateLookBehind(stream.Get());
         }
 
         parser.UpdateCurrentEmphasisRunState(emphasisType);
         char streamChar{};
-        stream.get(streamChar);
-        token += streamChar;
+        stream.Get(streamChar);
+        parser.m_store.text += streamChar;
         return EmphasisState::Emphasis;
     }
     else
@@ -141,29 +141,29 @@ EmphasisParser::EmphasisState EmphasisParser::MatchText(EmphasisParser& parser,
         if (isEmphasisToken && parser.m_lookBehind == DelimiterType::Escape)
         {
             // remove escape char from stream
-            token.pop_back();
+            parser.m_store.text.pop_back();
         }
 
         parser.UpdateLookBehind(currentChar);
         char streamChar{};
-        stream.get(streamChar);
-        token += streamChar;
+        stream.Get(streamChar);
+        parser.m_store.text += streamChar;
         return EmphasisState::Text;
     }
 }
 
 /// captures text until it see non-emphasis character. When it does, switch to text state
-EmphasisParser::EmphasisState EmphasisParser::MatchEmphasis(EmphasisParser& parser, std::stringstream& stream, std::string& token)
+EmphasisParser::EmphasisState EmphasisParser::MatchEmphasis(EmphasisParser& parser, MarkDownCursor& stream)
 {
     // key word is encountered, flush what is being processed, and have those keyword
     // handled by ParseBlock()
 
-    const int currentChar = stream.peek();
+    const int currentChar = stream.Peek();
 
     if (currentChar == '[' || currentChar == ']' || currentChar == ')' || currentChar == '\n' || currentChar == '\r' ||
-        stream.eof())
+        stream.Eof())
     {
-        parser.Flush(currentChar, token);
+        parser.Flush(currentChar);
         return EmphasisState::Captured;
     }
 
@@ -177,44 +177,43 @@ EmphasisParser::EmphasisState EmphasisParser::MatchEmphasis(EmphasisParser& pars
         }
 
         char streamChar{};
-        stream.get(streamChar);
-        token += streamChar;
+        stream.Get(streamChar);
+        parser.m_store.text += streamChar;
     }
     /// delimiter run is ended, capture the current accumulated token as emphasis
     else
     {
-        parser.CaptureEmphasisToken(currentChar, token);
+        parser.CaptureEmphasisToken(currentChar);
 
         if (currentChar == '\\')
         {
             // skips escape char
-            stream.get();
+            stream.Get();
         }
 
         parser.ResetCurrentEmphasisState();
-        parser.UpdateLookBehind(stream.peek());
+        parser.UpdateLookBehind(stream.Peek());
         char streamChar{};
-        stream.get(streamChar);
-        token += streamChar;
+        stream.Get(streamChar);
+        parser.m_store.text += streamChar;
         return EmphasisState::Text;
     }
     return EmphasisState::Emphasis;
 }
 
-// Captures remaining charaters in given token
+// Captures remaining charaters in current token
 // and causes the emphasis parsing to terminate
-void EmphasisParser::Flush(const int ch, std::string& currentToken)
+void EmphasisParser::Flush(const int ch)
 {
     if (m_current_state == EmphasisState::Emphasis)
     {
-        CaptureEmphasisToken(ch, currentToken);
+        CaptureEmphasisToken(ch);
         m_delimiterCnts = 0;
     }
     else
     {
-        CaptureCurrentCollectedStringAsRegularToken(currentToken);
+        CaptureCurrentCollectedStringAsRegularToken();
     }
-    currentToken.clear();
 }
 
 bool EmphasisParser::IsMarkDownDelimiter(const int ch) const
@@ -222,23 +221,30 @@ bool EmphasisParser::IsMarkDownDelimiter(const int ch) const
     return ((ch == '*' || ch == '_') && (m_lookBehind != DelimiterType::Escape));
 }
 
-void EmphasisParser::CaptureCurrentCollectedStringAsRegularToken(std::string& currentToken)
+void EmphasisParser::CaptureCurrentCollectedStringAsRegularToken()
 {
-    if (currentToken.empty())
+    const size_t length = m_store.text.size() - m_currentTokenOffset;
+    if (length == 0)
     {
         return;
     }
 
-    std::shared_ptr<MarkDownHtmlGenerator> codeGen = std::make_shared<MarkDownStringHtmlGenerator>(currentToken);
-
-    m_parsedResult.AppendToTokens(codeGen);
+    m_parsedResult.AppendToTokens(m_store.AddToken(MarkDownTokenType::Text, m_currentTokenOffset, length));
 
-    currentToken.clear();
+    m_currentTokenOffset = m_store.text.size();
 }
 
-void EmphasisParser::CaptureCurrentCollectedStringAsRegularToken()
+// emphasis tokens are saved in the look up table for later reference
+void EmphasisParser::CaptureCurrentCollectedStringAsEmphasisToken(MarkDownEmphasis::Kind kind)
 {
-    CaptureCurrentCollectedStringAsRegularToken(m_current_token);
+    const size_t emphasis = m_store.AddEmphasis(kind, m_delimiterCnts, m_currentDelimiterType);
+
+    m_parsedResult.AppendToLookUpTable(emphasis);
+
+    m_parsedResult.AppendToTokens(
+        m_store.AddToken(MarkDownTokenType::Emphasis, m_currentTokenOffset, m_store.text.size() - m_currentTokenOffset, emphasis));
+
+    m_currentTokenOffset = m_store.text.size();
 }
 
 void EmphasisParser::UpdateCurrentEmphasisRunState(DelimiterType emphasisType)
@@ -293,46 +299,32 @@ bool EmphasisParser::IsRightEmphasisDelimiter(const int ch) const
     return false;
 }
 
-bool EmphasisParser::TryCapturingRightEmphasisToken(const int ch, std::string& currentToken)
+bool EmphasisParser::TryCapturingRightEmphasisToken(const int ch)
 {
     if (IsRightEmphasisDelimiter(ch))
     {
-        std::shared_ptr<MarkDownEmphasisHtmlGenerator> codeGen = nullptr;
         // right emphasis can be also left emphasis
         if (IsLeftEmphasisDelimiter(ch))
         {
             // since it is both left and right emphasis, create one accordingly
-            codeGen = std::make_shared<MarkDownLeftAndRightEmphasisHtmlGenerator>(currentToken, m_delimiterCnts, m_currentDelimiterType);
+            CaptureCurrentCollectedStringAsEmphasisToken(MarkDownEmphasis::Kind::LeftAndRight);
         }
         else
         {
-            codeGen = std::make_shared<MarkDownRightEmphasisHtmlGenerator>(currentToken, m_delimiterCnts, m_currentDelimiterType);
+            CaptureCurrentCollectedStringAsEmphasisToken(MarkDownEmphasis::Kind::Right);
         }
 
-        m_parsedResult.AppendToLookUpTable(codeGen);
-
-        m_parsedResult.AppendToTokens(codeGen);
-
-        currentToken.clear();
-
         return true;
     }
     return false;
 }
 
-bool EmphasisParser::TryCapturingLeftEmphasisToken(const int ch, std::string& currentToken)
+bool EmphasisParser::TryCapturingLeftEmphasisToken(const int ch)
 {
     // left emphasis detected, save emphasis for later reference
     if (IsLeftEmphasisDelimiter(ch))
     {
-        std::shared_ptr<MarkDownEmphasisHtmlGenerator> codeGen =
-            std::make_shared<MarkDownLeftEmphasisHtmlGenerator>(currentToken, m_delimiterCnts, m_currentDelimiterType);
-
-        m_parsedResult.AppendToLookUpTable(codeGen);
-
-        m_parsedResult.AppendToTokens(codeGen);
-
-        currentToken.clear();
+        CaptureCurrentCollectedStringAsEmphasisToken(MarkDownEmphasis::Kind::Left);
         return true;
     }
     return false;
@@ -355,18 +347,17 @@ void EmphasisParser::UpdateLookBehind(const int ch)
     }
 }
 
-void EmphasisParser::CaptureEmphasisToken(const int ch, std::string& currentToken)
+void EmphasisParser::CaptureEmphasisToken(const int ch)
 {
-    if (!TryCapturingRightEmphasisToken(ch, currentToken) && !TryCapturingLeftEmphasisToken(ch, currentToken) &&
-        !currentToken.empty())
+    if (!TryCapturingRightEmphasisToken(ch) && !TryCapturingLeftEmphasisToken(ch))
     {
         // no valid emphasis delimiter runs found during current emphasis delimiter run
         // treat them as regular string tokens
-        CaptureCurrentCollectedStringAsRegularToken(currentToken);
+        CaptureCurrentCollectedStringAsRegularToken();
     }
 }
 
-void LinkParser::Match(std::stringstream& stream)
+void LinkParser::Match(MarkDownCursor& stream)
 {
     // link syntax check, match keyword at each stage
     bool capturedLink = (MatchAtLinkInit(stream) && MatchAtLinkTextRun(stream) && MatchAtLinkTextEnd(stream));
@@ -378,12 +369,12 @@ void LinkParser::Match(std::stringstream& stream)
 }
 
 // link is in form of [txt](url), this method matches '['
-bool LinkParser::MatchAtLinkInit(std::stringstream& lookahead)
+bool LinkParser::MatchAtLinkInit(MarkDownCursor& lookahead)
 {
-    if (lookahead.peek() == '[')
+    if (lookahead.Peek() == '[')
     {
         char streamChar{};
-        lookahead.get(streamChar);
+        lookahead.Get(streamChar);
         m_linkTextParsedResult.AddNewTokenToParsedResult(streamChar);
         return true;
     }
@@ -394,19 +385,19 @@ bool LinkParser::MatchAtLinkInit(std::stringstream& lookahead)
 }
 
 // link is in form of [txt](url), this method matches txt
-bool LinkParser::MatchAtLinkTextRun(std::stringstream& lookahead)
+bool LinkParser::MatchAtLinkTextRun(MarkDownCursor& lookahead)
 {
-    if (lookahead.peek() == ']')
+    if (lookahead.Peek() == ']')
     {
         char streamChar{};
-        lookahead.get(streamChar);
+        lookahead.Get(streamChar);
         m_linkTextParsedResult.AddNewTokenToParsedResult(streamChar);
         return true;
     }
     else
     {
         // parses recursively to the right
-        while (lookahead.peek() != EOF && lookahead.peek() != ']')
+        while (lookahead.Peek() != EOF && lookahead.Peek() != ']')
         {
             MarkDownBlockParser::ParseBlock(lookahead);
             m_linkTextParsedResult.AppendParseResult(GetParsedResult());
@@ -417,11 +408,11 @@ bool LinkParser::MatchAtLinkTextRun(std::stringstream& lookahead)
             }
         }
 
-        if (lookahead.peek() == ']')
+        if (lookahead.Peek() == ']')
         {
             // move code gen objects to link text list to further process it
             char streamChar{};
-            lookahead.get(streamChar);
+            lookahead.Get(streamChar);
             m_linkTextParsedResult.AddNewTokenToParsedResult(streamChar);
             return true;
         }
@@ -432,13 +423,13 @@ bool LinkParser::MatchAtLinkTextRun(std::stringstream& lookahead)
 }
 
 // link is in form of [txt](url), this method matches ']'
-bool LinkParser::MatchAtLinkTextEnd(std::stringstream& lookahead)
+bool LinkParser::MatchAtLinkTextEnd(MarkDownCursor& lookahead)
 {
-    if (lookahead.peek() == '(')
+    if (lookahead.Peek() == '(')
     {
         ++m_linkDestinationStart;
         char streamChar{};
-        lookahead.get(streamChar);
+        lookahead.Get(streamChar);
         m_linkTextParsedResult.AddNewTokenToParsedResult(streamChar);
         return true;
     }
@@ -448,10 +439,10 @@ bool LinkParser::MatchAtLinkTextEnd(std::stringstream& lookahead)
 }
 
 // link is in form of [txt](url), this method matches '('
-bool LinkParser::MatchAtLinkDestinationStart(std::stringstream& lookahead)
+bool LinkParser::MatchAtLinkDestinationStart(MarkDownCursor& lookahead)
 {
     // handles [xx](
-    if (lookahead.peek() < 0)
+    if (lookahead.Peek() < 0)
     {
         m_parsedResult.AppendParseResult(m_linkTextParsedResult);
         return false;
@@ -459,12 +450,12 @@ bool LinkParser::MatchAtLinkDestinationStart(std::stringstream& lookahead)
 
     // identify where the destination value ends by marking the position
     // e.g: ([ab()c])()()() end = 7
-    m_parsingCurrentPos = lookahead.tellg();
+    m_parsingCurrentPos = lookahead.Tell();
     int i = static_cast<int>(m_parsingCurrentPos);
-    while (lookahead.peek() != EOF && m_linkDestinationStart > 0)
+    while (lookahead.Peek() != EOF && m_linkDestinationStart > 0)
     {
         char c;
-        lookahead.get(c);
+        lookahead.Get(c);
 
         if (c == '(')
         {
@@ -480,11 +471,11 @@ bool LinkParser::MatchAtLinkDestinationStart(std::stringstream& lookahead)
         }
         ++i;
     }
-    lookahead.clear();
-    lookahead.seekg(m_parsingCurrentPos, std::ios::beg);
+    lookahead.Clear();
+    lookahead.Seek(m_parsingCurrentPos);
 
     // control key is detected, syntax check failed
-    if (MarkDownBlockParser::IsCntrl(lookahead.peek()))
+    if (MarkDownBlockParser::IsCntrl(lookahead.Peek()))
     {
         m_parsedResult.AppendParseResult(m_linkTextParsedResult);
         return false;
@@ -493,30 +484,30 @@ bool LinkParser::MatchAtLinkDestinationStart(std::stringstream& lookahead)
     return true;
 }
 // link is in form of [txt](url), this method matches ')'
-bool LinkParser::MatchAtLinkDestinationRun(std::stringstream& lookahead)
+bool LinkParser::MatchAtLinkDestinationRun(MarkDownCursor& lookahead)
 {
-    if (lookahead.peek() > 0 &&
-        (MarkDownBlockParser::IsSpace(lookahead.peek()) || MarkDownBlockParser::IsCntrl(lookahead.peek())))
+    if (lookahead.Peek() > 0 &&
+        (MarkDownBlockParser::IsSpace(lookahead.Peek()) || MarkDownBlockParser::IsCntrl(lookahead.Peek())))
     {
         m_parsedResult.AppendParseResult(m_linkTextParsedResult);
         return false;
     }
 
-    m_parsingCurrentPos = lookahead.tellg();
-    while (m_parsingCurrentPos <= m_linkDestinationEnd && lookahead.peek() != EOF)
+    m_parsingCurrentPos = lookahead.Tell();
+    while (m_parsingCurrentPos <= m_linkDestinationEnd && lookahead.Peek() != EOF)
     {
-        if (lookahead.peek() == '[')
+        if (lookahead.Peek() == '[')
         {
             // we found an opening in the destination. Catch it.
             char c{};
-            lookahead.get(c);
+            lookahead.Get(c);
             m_parsedResult.AddNewTokenToParsedResult(c);
         }
         else
         {
             ParseBlock(lookahead);
         }
-        m_parsingCurrentPos = int(lookahead.tellg());
+        m_parsingCurrentPos = lookahead.Tell();
     }
 
     m_parsedResult.PopBack();
@@ -526,17 +517,11 @@ bool LinkParser::MatchAtLinkDestinationRun(std::stringstream& lookahead)
 
 // this method is called when link syntax check is complete
 // it processes the parsed result from link destination  and link text
-// and build a MarkDownStringHtmlGenerator that will output
+// and build a link token that will output
 // string in link syntax (text)[destination) will converts to
 // <a href=\destination\>text</a>
 void LinkParser::CaptureLinkToken()
 {
-    std::ostringstream html;
-    html << "<a href=\"";
-    // process link destination
-    html << m_parsedResult.GenerateHtmlString();
-    html << "\">";
-
     // when syntax check is complete, we have seen
     // '[', ']', '(', these keywords are not
     // needed anymore, so pop them from the parse result
@@ -549,34 +534,31 @@ void LinkParser::CaptureLinkToken()
     // translate what is captured in text of link
     // emphasis are processed here
     m_linkTextParsedResult.Translate();
-    html << m_linkTextParsedResult.GenerateHtmlString();
-    html << "</a>";
 
-    std::string html_string = html.str();
-
-    // Generate a MarkDownStringHtmlGenerator object
-    const std::shared_ptr<MarkDownHtmlGenerator> codeGen = std::make_shared<MarkDownStringHtmlGenerator>(html_string);
+    // Generate a link token holding the tokens of link destination and text
+    const size_t link = m_store.AddLink(m_parsedResult.GetFirstToken(), m_linkTextParsedResult.GetFirstToken());
+    const size_t token = m_store.AddToken(MarkDownTokenType::Link, 0, 0, link);
 
     m_parsedResult.Clear();
     m_parsedResult.FoundHtmlTags();
-    m_parsedResult.AppendToTokens(codeGen);
+    m_parsedResult.AppendToTokens(token);
     m_parsedResult.SetIsCaptured(true);
 }
 
 // list marker have form of ^-\s+ or \r-\s+
 // this method matches -\s
-bool ListParser::MatchNewListItem(std::stringstream& stream)
+bool ListParser::MatchNewListItem(MarkDownCursor& stream)
 {
-    const int ch = stream.peek();
+    const int ch = stream.Peek();
     if (IsHyphen(ch) || IsPlus(ch) || IsAsterisk(ch))
     {
-        stream.get();
-        if (stream.peek() == ' ')
+        stream.Get();
+        if (stream.Peek() == ' ')
         {
-            stream.unget();
+            stream.Unget();
             return true;
         }
-        stream.unget();
+        stream.Unget();
     }
     return false;
 }
@@ -587,14 +569,14 @@ bool ListParser::MatchNewListItem(std::stringstream& stream)
 // before calling this method
 // this method will return true, after it mataches new line char
 // at least once.
-bool ListParser::MatchNewBlock(std::stringstream& stream)
+bool ListParser::MatchNewBlock(MarkDownCursor& stream)
 {
-    if (IsNewLine(stream.peek()))
+    if (IsNewLine(stream.Peek()))
     {
         do
         {
-            stream.get();
-        } while (IsNewLine(stream.peek()));
+            stream.Get();
+        } while (IsNewLine(stream.Peek()));
 
         return true;
     }
@@ -604,19 +586,19 @@ bool ListParser::MatchNewBlock(std::stringstream& stream)
 
 // ordered list marker has form of ^\d+\.\s* or [\r,\n]\d+\.\s*, and this method checks the syntax
 // this method matches \d+\.
-bool ListParser::MatchNewOrderedListItem(std::stringstream& stream, std::string& number_string)
+bool ListParser::MatchNewOrderedListItem(MarkDownCursor& stream, std::string& number_string)
 {
     do
     {
         char streamChar{};
-        stream.get(streamChar);
+        stream.Get(streamChar);
         number_string += streamChar;
-    } while (MarkDownBlockParser::IsDigit(stream.peek()));
+    } while (MarkDownBlockParser::IsDigit(stream.Peek()));
 
-    if (IsDot(stream.peek()))
+    if (IsDot(stream.Peek()))
     {
         // ordered list syntax check complete
-        stream.unget();
+        stream.Unget();
         return true;
     }
 
@@ -626,16 +608,16 @@ bool ListParser::MatchNewOrderedListItem(std::stringstream& stream, std::string&
 // parse blocks that wasn't captured
 // if what we encounter is one of following items, start of new list, list item, or new block element,
 // we do not include in the current block, we return, and have it handled by the caller
-void ListParser::ParseSubBlocks(std::stringstream& stream)
+void ListParser::ParseSubBlocks(MarkDownCursor& stream)
 {
-    while (!stream.eof())
+    while (!stream.Eof())
     {
-        if (IsNewLine(stream.peek()))
+        if (IsNewLine(stream.Peek()))
         {
             char newLineChar{};
-            stream.get(newLineChar);
+            stream.Get(newLineChar);
             // check if it is the start of new block items
-            if (MarkDownBlockParser::IsDigit(stream.peek()))
+            if (MarkDownBlockParser::IsDigit(stream.Peek()))
             {
                 std::string number_string = "";
                 if (MatchNewOrderedListItem(stream, number_string))
@@ -658,18 +640,18 @@ void ListParser::ParseSubBlocks(std::stringstream& stream)
     }
 }
 
-bool ListParser::CompleteListParsing(std::stringstream& stream)
+bool ListParser::CompleteListParsing(MarkDownCursor& stream)
 {
     // check for - of -\s+ list marker
-    if (stream.peek() == ' ')
+    if (stream.Peek() == ' ')
     {
         // at this point, syntax check is complete,
         // thus any other spaces are ignored
         // remove space
         do
         {
-            stream.get();
-        } while (stream.peek() == ' ');
+            stream.Get();
+        } while (stream.Peek() == ' ');
 
         ParseBlock(stream);
         // parse blocks that follows
@@ -681,13 +663,13 @@ bool ListParser::CompleteListParsing(std::stringstream& stream)
 }
 
 // list marker has a form of ^-\s+ or [\r, \n]-\s+, and this method checks the syntax
-void ListParser::Match(std::stringstream& stream)
+void ListParser::Match(MarkDownCursor& stream)
 {
     // check for - of -\s+ list marker
-    const int ch = stream.peek();
+    const int ch = stream.Peek();
     if (IsHyphen(ch) || IsPlus(ch) || IsAsterisk(ch))
     {
-        stream.get();
+        stream.Get();
         if (CompleteListParsing(stream))
         {
             CaptureListToken();
@@ -698,7 +680,7 @@ void ListParser::Match(std::stringstream& stream)
             if (IsAsterisk(ch))
             {
                 // ch is '*', it's safe to cast and put back
-                stream.putback(static_cast<unsigned char>(ch));
+                stream.Putback(static_cast<char>(ch));
 
                 ParseTextAndEmphasis(stream);
             }
@@ -713,40 +695,32 @@ void ListParser::Match(std::stringstream& stream)
 
 void ListParser::CaptureListToken()
 {
-    std::ostringstream html;
     m_parsedResult.Translate();
-    std::string const htmlString = m_parsedResult.GenerateHtmlString();
-
-    html << "<li>";
-    html << htmlString;
-    html << "</li>";
-
-    std::string html_string = html.str();
-    std::shared_ptr<MarkDownListHtmlGenerator> const codeGen = std::make_shared<MarkDownListHtmlGenerator>(html_string);
+    const size_t token = m_store.AddToken(MarkDownTokenType::ListItem, 0, 0, m_parsedResult.GetFirstToken());
 
     m_parsedResult.Clear();
     m_parsedResult.FoundHtmlTags();
-    m_parsedResult.AppendToTokens(codeGen);
+    m_parsedResult.AppendToTokens(token);
 }
 
 // ordered list marker has form of ^\d+\.\s* or [\r,\n]\d+\.\s*, and this method checks the syntax
-void OrderedListParser::Match(std::stringstream& stream)
+void OrderedListParser::Match(MarkDownCursor& stream)
 {
     // used to capture digit char
     std::string number_string = "";
-    if (MarkDownBlockParser::IsDigit(stream.peek()))
+    if (MarkDownBlockParser::IsDigit(stream.Peek()))
     {
         do
         {
             char streamChar{};
-            stream.get(streamChar);
+            stream.Get(streamChar);
             number_string += streamChar;
-        } while (MarkDownBlockParser::IsDigit(stream.peek()));
+        } while (MarkDownBlockParser::IsDigit(stream.Peek()));
 
-        if (IsDot(stream.peek()))
+        if (IsDot(stream.Peek()))
         {
             // ordered list syntax check complete
-            stream.get();
+            stream.Get();
             if (CompleteListParsing(stream))
             {
                 CaptureOrderedListToken(number_string);
@@ -765,21 +739,17 @@ void OrderedListParser::Match(std::stringstream& stream)
     }
 }
 
-void OrderedListParser::CaptureOrderedListToken(std::string& number_string)
+void OrderedListParser::CaptureOrderedListToken(const std::string& number_string)
 {
-    std::ostringstream html;
     m_parsedResult.Translate();
-    const std::string htmlString = m_parsedResult.GenerateHtmlString();
-
-    html << "<li>";
-    html << htmlString;
-    html << "</li>";
 
-    std::string html_string = html.str();
-    const std::shared_ptr<MarkDownOrderedListHtmlGenerator> codeGen =
-        std::make_shared<MarkDownOrderedListHtmlGenerator>(html_string, number_string);
+    // the item's text is the list's start number
+    const size_t offset = m_store.text.size();
+    m_store.text += number_string;
+    const size_t token = m_store.AddToken(
+        MarkDownTokenType::OrderedListItem, offset, number_string.size(), m_parsedResult.GetFirstToken());
 
     m_parsedResult.Clear();
     m_parsedResult.FoundHtmlTags();
-    m_parsedResult.AppendToTokens(codeGen);
+    m_parsedResult.AppendToTokens(token);
 }
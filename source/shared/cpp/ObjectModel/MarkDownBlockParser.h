@@ -8,15 +8,146 @@
 
 namespace AdaptiveCards
 {
+// The read position of the block parsers in the text being parsed. It has the subset of std::istream's interface
+// they use, with the same behavior at the end of the text (reading past it sets eof, and once eof is set the next
+// read fails until it's cleared by Unget() or Seek()), over a contiguous buffer instead of a std::stringstream.
+class MarkDownCursor
+{
+public:
+    explicit MarkDownCursor(std::string_view text) noexcept :
+        m_text(text), m_position(0), m_eof(false), m_fail(false), m_bad(false)
+    {
+    }
+
+    // The next character (as an unsigned char) without consuming it, or EOF
+    int Peek() noexcept
+    {
+        if (!IsGood())
+        {
+            m_fail = true;
+            return EOF;
+        }
+        if (m_position == m_text.size())
+        {
+            m_eof = true;
+            return EOF;
+        }
+        return static_cast<unsigned char>(m_text[m_position]);
+    }
+
+    // Consumes the next character and returns it (as an unsigned char), or EOF
+    int Get() noexcept
+    {
+        if (!IsGood())
+        {
+            m_fail = true;
+            return EOF;
+        }
+        if (m_position == m_text.size())
+        {
+            m_eof = true;
+            m_fail = true;
+            return EOF;
+        }
+        return static_cast<unsigned char>(m_text[m_position++]);
+    }
+
+    // Consumes the next character into ch, which is left as it is at the end
+    void Get(char& ch) noexcept
+    {
+        const int next = Get();
+        if (next != EOF)
+        {
+            ch = static_cast<char>(next);
+        }
+    }
+
+    // Steps back over the last character consumed
+    void Unget() noexcept
+    {
+        m_eof = false;
+        if (!IsGood())
+        {
+            m_fail = true;
+        }
+        else if (m_position == 0)
+        {
+            m_bad = true;
+        }
+        else
+        {
+            --m_position;
+        }
+    }
+
+    // Steps back over the last character consumed, which must be ch (the text is never modified)
+    void Putback(char ch) noexcept
+    {
+        if (m_position != 0 && m_text[m_position - 1] != ch)
+        {
+            m_eof = false;
+            m_bad = true;
+            return;
+        }
+        Unget();
+    }
+
+    bool Eof() const noexcept
+    {
+        return m_eof;
+    }
+
+    // The offset of the next character, or -1 if a read has failed (or eof is set)
+    std::ptrdiff_t Tell() noexcept
+    {
+        if (!IsGood())
+        {
+            m_fail = true;
+            return -1;
+        }
+        return static_cast<std::ptrdiff_t>(m_position);
+    }
+
+    void Seek(std::ptrdiff_t position) noexcept
+    {
+        m_eof = false;
+        if (!IsGood() || position < 0 || static_cast<size_t>(position) > m_text.size())
+        {
+            m_fail = true;
+            return;
+        }
+        m_position = static_cast<size_t>(position);
+    }
+
+    void Clear() noexcept
+    {
+        m_eof = false;
+        m_fail = false;
+        m_bad = false;
+    }
+
+private:
+    bool IsGood() const noexcept
+    {
+        return !m_eof && !m_fail && !m_bad;
+    }
+
+    std::string_view m_text;
+    size_t m_position;
+    bool m_eof;
+    bool m_fail;
+    bool m_bad;
+};
+
 class MarkDownBlockParser
 {
 public:
-    MarkDownBlockParser(){};
+    explicit MarkDownBlockParser(MarkDownTokenStore& store) : m_store(store), m_parsedResult(store){};
     // Matches each MarkDown's Syntax Form
-    // For each match, stream moves to the next char
-    virtual void Match(std::stringstream&) = 0;
+    // For each match, the cursor moves to the next char
+    virtual void Match(MarkDownCursor&) = 0;
     // Parses Block
-    void ParseBlock(std::stringstream&);
+    void ParseBlock(MarkDownCursor&);
     // Returns Parse result
     MarkDownParsedResult& GetParsedResult()
     {
@@ -51,8 +182,10 @@ protected:
         return (ch > 0) && isdigit(ch);
     }
 
-    void ParseTextAndEmphasis(std::stringstream& stream);
+    void ParseTextAndEmphasis(MarkDownCursor& stream);
 
+    // Holds the tokens of parsed results
+    MarkDownTokenStore& m_store;
     // Holds parsed results
     MarkDownParsedResult m_parsedResult;
 };
@@ -60,7 +193,7 @@ protected:
 class EmphasisParser : public MarkDownBlockParser
 {
 public:
-    EmphasisParser() = default;
+    explicit EmphasisParser(MarkDownTokenStore& store) : MarkDownBlockParser(store){};
     EmphasisParser(const EmphasisParser&) = delete;
     EmphasisParser(EmphasisParser&&) = delete;
     EmphasisParser& operator=(const EmphasisParser&) = delete;
@@ -74,15 +207,14 @@ public:
         Captured  // Emphasis parsing is complete
     };
 
-    void Match(std::stringstream&) override;
+    void Match(MarkDownCursor&) override;
 
-    // Captures remaining charaters in given token and causes the emphasis parsing to terminate
-    void Flush(const int ch, std::string& currentToken);
+    // Captures remaining charaters in current token and causes the emphasis parsing to terminate
+    void Flush(const int ch);
 
     // check if given character is * or _
     bool IsMarkDownDelimiter(const int ch) const;
 
-    void CaptureCurrentCollectedStringAsRegularToken(std::string& currentToken);
     void CaptureCurrentCollectedStringAsRegularToken();
     void UpdateCurrentEmphasisRunState(DelimiterType emphasisType);
     // Check if current delimiter will be considererd as a delimiter run
@@ -97,23 +229,22 @@ public:
     bool IsLeftEmphasisDelimiter(const int ch) const;
     bool IsRightEmphasisDelimiter(const int ch) const;
     // Attempt to capture current emphasis as left emphasis
-    bool TryCapturingLeftEmphasisToken(const int ch, std::string& currentToken);
+    bool TryCapturingLeftEmphasisToken(const int ch);
     // Attempt to capture current emphasis as right emphasis
-    bool TryCapturingRightEmphasisToken(const int ch, std::string& currentToken);
-    void CaptureEmphasisToken(const int ch, std::string& currentToken);
+    bool TryCapturingRightEmphasisToken(const int ch);
+    void CaptureEmphasisToken(const int ch);
+    void CaptureCurrentCollectedStringAsEmphasisToken(MarkDownEmphasis::Kind kind);
     void UpdateLookBehind(const int ch);
     static constexpr DelimiterType GetDelimiterTypeForChar(const int ch)
     {
         return (ch == '*') ? DelimiterType::Asterisk : DelimiterType::Underscore;
     };
 
-    typedef EmphasisState (*MatchWithChar)(EmphasisParser&, std::stringstream&, std::string&);
-
     // Callback function that handles the Text State
-    static EmphasisState MatchText(EmphasisParser&, std::stringstream&, std::string&);
+    static EmphasisState MatchText(EmphasisParser&, MarkDownCursor&);
 
     // Callback function that handles the Emphasis State
-    static EmphasisState MatchEmphasis(EmphasisParser&, std::stringstream&, std::string&);
+    static EmphasisState MatchEmphasis(EmphasisParser&, MarkDownCursor&);
 
     static bool IsEmphasisToken(int token);
 
@@ -125,43 +256,39 @@ protected:
     DelimiterType m_currentDelimiterType = DelimiterType::Init;
     EmphasisState m_current_state = EmphasisState::Text;
 
-    // vector of callback functions that handles state transistions
-    const std::unordered_map<EmphasisState, MatchWithChar> m_stateMachine = {
-        {EmphasisState::Text, MatchText}, {EmphasisState::Emphasis, MatchEmphasis}};
-
-    // holds currently collected token
-    std::string m_current_token;
+    // currently collected token is the store's text from here on
+    size_t m_currentTokenOffset = 0;
 };
 
 class LinkParser : public MarkDownBlockParser
 {
 public:
-    LinkParser() = default;
-    LinkParser(const LinkParser&) = default;
-    LinkParser(LinkParser&&) = default;
-    LinkParser& operator=(const LinkParser&) = default;
-    LinkParser& operator=(LinkParser&&) = default;
+    explicit LinkParser(MarkDownTokenStore& store) : MarkDownBlockParser(store), m_linkTextParsedResult(store){};
+    LinkParser(const LinkParser&) = delete;
+    LinkParser(LinkParser&&) = delete;
+    LinkParser& operator=(const LinkParser&) = delete;
+    LinkParser& operator=(LinkParser&&) = delete;
     virtual ~LinkParser() = default;
 
-    void Match(std::stringstream&) override;
+    void Match(MarkDownCursor&) override;
 
 private:
     void CaptureLinkToken();
 
     // Matches Initial syntax of link
-    bool MatchAtLinkInit(std::stringstream&);
+    bool MatchAtLinkInit(MarkDownCursor&);
     // Matches LinkText Run syntax of link
-    bool MatchAtLinkTextRun(std::stringstream&);
+    bool MatchAtLinkTextRun(MarkDownCursor&);
     // Matches LinkText End syntax of link
-    bool MatchAtLinkTextEnd(std::stringstream&);
+    bool MatchAtLinkTextEnd(MarkDownCursor&);
     // Matches LinkDestination Start syntax of link
-    bool MatchAtLinkDestinationStart(std::stringstream&);
+    bool MatchAtLinkDestinationStart(MarkDownCursor&);
     // Matches LinkDestination Run syntax of link
-    bool MatchAtLinkDestinationRun(std::stringstream&);
+    bool MatchAtLinkDestinationRun(MarkDownCursor&);
 
     int m_linkDestinationStart = 0;
     int m_linkDestinationEnd = 0;
-    std::stringstream::pos_type m_parsingCurrentPos = 0;
+    std::ptrdiff_t m_parsingCurrentPos = 0;
 
     // holds intermediate result of LinkText
     MarkDownParsedResult m_linkTextParsedResult;
@@ -170,17 +297,17 @@ private:
 class ListParser : public MarkDownBlockParser
 {
 public:
-    ListParser() = default;
-    ListParser(const ListParser&) = default;
-    ListParser(ListParser&&) = default;
-    ListParser& operator=(const ListParser&) = default;
-    ListParser& operator=(ListParser&&) = default;
+    explicit ListParser(MarkDownTokenStore& store) : MarkDownBlockParser(store){};
+    ListParser(const ListParser&) = delete;
+    ListParser(ListParser&&) = delete;
+    ListParser& operator=(const ListParser&) = delete;
+    ListParser& operator=(ListParser&&) = delete;
     virtual ~ListParser() = default;
 
-    void Match(std::stringstream&) override;
-    bool MatchNewListItem(std::stringstream&);
-    bool MatchNewBlock(std::stringstream&);
-    bool MatchNewOrderedListItem(std::stringstream&, std::string&);
+    void Match(MarkDownCursor&) override;
+    bool MatchNewListItem(MarkDownCursor&);
+    bool MatchNewBlock(MarkDownCursor&);
+    bool MatchNewOrderedListItem(MarkDownCursor&, std::string&);
     static constexpr bool IsHyphen(const int ch)
     {
         return ch == '-';
@@ -203,8 +330,8 @@ public:
     };
 
 protected:
-    void ParseSubBlocks(std::stringstream&);
-    bool CompleteListParsing(std::stringstream& stream);
+    void ParseSubBlocks(MarkDownCursor&);
+    bool CompleteListParsing(MarkDownCursor& stream);
 
 private:
     void CaptureListToken();
@@ -213,16 +340,16 @@ private:
 class OrderedListParser : public ListParser
 {
 public:
-    OrderedListParser() = default;
-    OrderedListParser(const OrderedListParser&) = default;
-    OrderedListParser(OrderedListParser&&) = default;
-    OrderedListParser& operator=(const OrderedListParser&) = default;
-    OrderedListParser& operator=(OrderedListParser&&) = default;
+    explicit OrderedListParser(MarkDownTokenStore& store) : ListParser(store){};
+    OrderedListParser(const OrderedListParser&) = delete;
+    OrderedListParser(OrderedListParser&&) = delete;
+    OrderedListParser& operator=(const OrderedListParser&) = delete;
+    OrderedListParser& operator=(OrderedListParser&&) = delete;
     ~OrderedListParser() = default;
 
-    void Match(std::stringstream&) override;
+    void Match(MarkDownCursor&) override;
 
 private:
-    void CaptureOrderedListToken(std::string&);
+    void CaptureOrderedListToken(const std::string&);
 };
 } // namespace AdaptiveCards
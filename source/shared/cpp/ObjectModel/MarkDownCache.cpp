@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "MarkDownCache.h"
+#include "MarkDownParser.h"
+
+namespace AdaptiveCards
+{
+std::shared_ptr<const MarkDownResult> MarkDownResult::Transform(const std::string& text)
+{
+    MarkDownParser parser(text);
+    auto result = std::make_shared<MarkDownResult>();
+    result->text = text;
+    result->html = parser.TransformToHtml();
+    result->runs = parser.TransformToRuns();
+    result->hasHtmlTags = parser.HasHtmlTags();
+    result->isEscaped = parser.IsEscaped();
+    return result;
+}
+
+MarkDownCache::MarkDownCache(size_t maxBytes) :
+    m_maxBytes(maxBytes), m_byteCount(0), m_hits(0), m_misses(0), m_evictions(0)
+{
+}
+
+std::shared_ptr<const MarkDownResult> MarkDownCache::Transform(const std::string& text)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto entry = m_index.find(text);
+        if (entry != m_index.end())
+        {
+            ++m_hits;
+            m_entries.splice(m_entries.begin(), m_entries, entry->second);
+            return entry->second->result;
+        }
+        ++m_misses;
+    }
+
+    // Parse without holding the lock so that misses on different text don't wait on each other
+    auto result = MarkDownResult::Transform(text);
+    const size_t cost = sizeof(Entry) + sizeof(MarkDownResult) + result->text.size() + result->html.size() +
+                        result->runs.text.size() + result->runs.runs.size() * sizeof(MarkDownRun);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (cost > m_maxBytes)
+    {
+        return result;
+    }
+
+    // Another thread may have parsed the same text while this one was
+    const auto existing = m_index.find(text);
+    if (existing != m_index.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, existing->second);
+        return existing->second->result;
+    }
+
+    m_entries.push_front(Entry{result, cost});
+    m_index.emplace(result->text, m_entries.begin());
+    m_byteCount += cost;
+    EvictToBudget();
+
+    return result;
+}
+
+void MarkDownCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.clear();
+    m_entries.clear();
+    m_byteCount = 0;
+}
+
+MarkDownCache::Statistics MarkDownCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Statistics{m_hits, m_misses, m_evictions, m_entries.size(), m_byteCount};
+}
+
+size_t MarkDownCache::GetMaxBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxBytes;
+}
+
+void MarkDownCache::SetMaxBytes(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = maxBytes;
+    EvictToBudget();
+}
+
+void MarkDownCache::EvictToBudget()
+{
+    while (m_byteCount > m_maxBytes && !m_entries.empty())
+    {
+        const auto oldest = std::prev(m_entries.end());
+        m_index.erase(oldest->result->text);
+        m_byteCount -= oldest->cost;
+        m_entries.erase(oldest);
+        ++m_evictions;
+    }
+}
+
+MarkDownResultHolder::MarkDownResultHolder(const MarkDownResultHolder& other) :
+    m_result(std::atomic_load(&other.m_result))
+{
+}
+
+MarkDownResultHolder& MarkDownResultHolder::operator=(const MarkDownResultHolder& other)
+{
+    std::atomic_store(&m_result, std::atomic_load(&other.m_result));
+    return *this;
+}
+
+std::shared_ptr<const MarkDownResult> MarkDownResultHolder::Transform(const std::string& text, MarkDownCache* cache) const
+{
+    auto result = std::atomic_load(&m_result);
+    if (result && result->text == text)
+    {
+        return result;
+    }
+
+    result = cache ? cache->Transform(text) : MarkDownResult::Transform(text);
+    std::atomic_store(&m_result, result);
+    return result;
+}
+} // namespace AdaptiveCards
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "MarkDownHtmlGenerator.h"
+#include <list>
+#include <mutex>
+
+namespace AdaptiveCards
+{
+// What MarkDownParser makes of a string, as html and as runs
+struct MarkDownResult
+{
+    std::string text;
+    std::string html;
+    MarkDownRuns runs;
+    bool hasHtmlTags;
+    bool isEscaped;
+
+    // parses the text once for both of its outputs
+    static std::shared_ptr<const MarkDownResult> Transform(const std::string& text);
+};
+
+// A thread-safe cache of markdown results, for hosts that render the same strings over and over across cards and
+// re-renders. Entries are keyed by the bytes of the text transformed. Least recently used entries are evicted once
+// the cache grows past its byte budget.
+//
+// Results are shared between every caller that asks for the same text, possibly on different threads.
+class MarkDownCache
+{
+public:
+    static constexpr size_t DefaultMaxBytes = 4 * 1024 * 1024;
+
+    struct Statistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t entryCount;
+        size_t byteCount;
+    };
+
+    explicit MarkDownCache(size_t maxBytes = DefaultMaxBytes);
+
+    MarkDownCache(const MarkDownCache&) = delete;
+    MarkDownCache& operator=(const MarkDownCache&) = delete;
+
+    // Same as MarkDownResult::Transform, except that text already in the cache isn't parsed again
+    std::shared_ptr<const MarkDownResult> Transform(const std::string& text);
+
+    // Drops every entry. The hit, miss, and eviction counts keep counting from where they were.
+    void Clear();
+    Statistics GetStatistics() const;
+
+    // Entries are charged for their text and the html and runs made from it. Lowering the budget evicts right away.
+    size_t GetMaxBytes() const;
+    void SetMaxBytes(size_t maxBytes);
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<const MarkDownResult> result;
+        size_t cost;
+    };
+    using EntryList = std::list<Entry>;
+
+    void EvictToBudget();
+
+    mutable std::mutex m_mutex;
+    // most recently used first
+    EntryList m_entries;
+    // keyed by the text of the entry's result
+    std::unordered_map<std::string_view, EntryList::iterator> m_index;
+    size_t m_maxBytes;
+    size_t m_byteCount;
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_evictions;
+};
+
+// The markdown result of an element's text, kept on the element so that rendering it again doesn't parse its text or
+// look it up in a cache. The text given is the one the host renders, which may differ from the element's text (with
+// its dates formatted, for one), and a result is only reused for the same text. Thread-safe.
+class MarkDownResultHolder
+{
+public:
+    MarkDownResultHolder() = default;
+    MarkDownResultHolder(const MarkDownResultHolder& other);
+    MarkDownResultHolder& operator=(const MarkDownResultHolder& other);
+    ~MarkDownResultHolder() = default;
+
+    // the result kept if it's for the given text, otherwise a new one from the cache (or parsed, without a cache)
+    std::shared_ptr<const MarkDownResult> Transform(const std::string& text, MarkDownCache* cache) const;
+
+private:
+    // accessed with std::atomic_load and std::atomic_store
+    mutable std::shared_ptr<const MarkDownResult> m_result;
+};
+} // namespace AdaptiveCards
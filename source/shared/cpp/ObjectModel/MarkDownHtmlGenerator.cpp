@@ -5,210 +5,483 @@
 
 using namespace AdaptiveCards;
 
-std::string MarkDownStringHtmlGenerator::GenerateHtmlString()
+namespace
 {
-    if (m_isHead)
+// html of each MarkDownEmphasisTag
+constexpr std::string_view c_tagHtml[] = {"<em>", "</em>", "<strong>", "</strong>"};
+constexpr size_t c_maxTagLength = sizeof("</strong>") - 1;
+// a token's block tags and its own tags: <ol start="..."></ol> and <a href="..."></a>
+constexpr size_t c_maxTokenMarkupLength = sizeof("<ol start=\"\"></ol>") - 1 + sizeof("<a href=\"\"></a>") - 1;
+
+struct HtmlEntity
+{
+    std::string_view escaped;
+    char ch;
+};
+
+// what MarkDownParser::EscapeText() escapes
+constexpr HtmlEntity c_htmlEntities[] = {{"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&amp;", '&'}};
+
+void AppendUnescaped(std::string& out, std::string_view text)
+{
+    size_t start = 0;
+    for (size_t ampersand = text.find('&'); ampersand != std::string_view::npos; ampersand = text.find('&', start))
     {
-        m_token = "<p>" + m_token;
+        out.append(text.substr(start, ampersand - start));
+        start = ampersand + 1;
+        char ch = '&';
+        for (const auto& entity : c_htmlEntities)
+        {
+            if (text.compare(ampersand, entity.escaped.size(), entity.escaped) == 0)
+            {
+                ch = entity.ch;
+                start = ampersand + entity.escaped.size();
+                break;
+            }
+        }
+        out += ch;
     }
+    out.append(text.substr(start));
+}
 
-    if (m_isTail)
+// the number of an ordered list's first item; lists whose numbers don't fit are numbered from 1, as renderers do
+unsigned int ParseListStart(std::string_view digits)
+{
+    unsigned long long number = 0;
+    for (const char digit : digits)
     {
-        return m_token + "</p>";
+        number = number * 10 + static_cast<unsigned long long>(digit - '0');
+        if (number > std::numeric_limits<unsigned int>::max())
+        {
+            return 1;
+        }
     }
-
-    return m_token;
+    return static_cast<unsigned int>(number);
 }
 
+// Writes tokens as runs, keeping track of what the html tags before each token would apply to its text
+class MarkDownRunWriter
+{
+public:
+    MarkDownRunWriter(const MarkDownTokenStore& store, MarkDownRuns& runs) : m_store(store), m_runs(runs) {}
+
+    void Write(size_t firstToken)
+    {
+        // items of an ordered list are numbered from the start the list's first token has
+        unsigned int nextListItemNumber = 1;
+        for (size_t token = firstToken; token != MarkDownTokenStore::None; token = m_store.tokens[token].next)
+        {
+            Write(m_store.tokens[token], nextListItemNumber);
+        }
+    }
+
+    // writes a paragraph or list item that was started but had no text
+    void Finish()
+    {
+        if (m_startsParagraph || m_startsListItem)
+        {
+            AddRun(m_runs.text.size(), 0);
+        }
+    }
+
+private:
+    void Write(const MarkDownToken& token, unsigned int& nextListItemNumber)
+    {
+        if (token.isHead)
+        {
+            switch (token.GetBlockType())
+            {
+            case MarkDownBlockType::ContainerBlock:
+                Finish();
+                m_startsParagraph = true;
+                break;
+            case MarkDownBlockType::OrderedList:
+                nextListItemNumber = ParseListStart(std::string_view(m_store.text).substr(token.offset, token.length));
+                break;
+            default:
+                break;
+            }
+        }
+
+        switch (token.type)
+        {
+        case MarkDownTokenType::Emphasis:
+        {
+            const MarkDownEmphasis& emphasis = m_store.emphases[token.index];
+            const size_t unusedDelimiters = static_cast<size_t>(emphasis.numberOfUnusedDelimiters);
+            const size_t unusedOffset = token.offset + token.length - unusedDelimiters;
+            const auto firstTag = m_store.tags.begin() + emphasis.tagsOffset;
+            const auto lastTag = firstTag + emphasis.tagCount;
+
+            // same order as html: left emphasis writes its delimiters before its tags, in reverse order
+            if (emphasis.kind == MarkDownEmphasis::Kind::Left)
+            {
+                WriteText(unusedOffset, unusedDelimiters);
+                for (auto itr = std::make_reverse_iterator(lastTag); itr != std::make_reverse_iterator(firstTag); ++itr)
+                {
+                    ApplyTag(*itr);
+                }
+            }
+            else
+            {
+                for (auto itr = firstTag; itr != lastTag; ++itr)
+                {
+                    ApplyTag(*itr);
+                }
+                WriteText(unusedOffset, unusedDelimiters);
+            }
+            break;
+        }
+        case MarkDownTokenType::Link:
+        {
+            const MarkDownLink& link = m_store.links[token.index];
+            const bool wasLink = m_isLink;
+            const size_t urlOffset = m_urlOffset;
+            const size_t urlLength = m_urlLength;
+
+            m_urlOffset = m_runs.text.size();
+            WritePlainText(link.destination);
+            m_urlLength = m_runs.text.size() - m_urlOffset;
+            m_isLink = true;
+            Write(link.text);
+
+            m_isLink = wasLink;
+            m_urlOffset = urlOffset;
+            m_urlLength = urlLength;
+            break;
+        }
+        case MarkDownTokenType::ListItem:
+        case MarkDownTokenType::OrderedListItem:
+            Finish();
+            m_startsListItem = true;
+            m_isOrderedListItem = (token.type == MarkDownTokenType::OrderedListItem);
+            m_listItemNumber = m_isOrderedListItem ? nextListItemNumber++ : 0;
+            Write(token.index);
+            break;
+        default:
+            WriteText(token.offset, token.length);
+            break;
+        }
+    }
+
+    void ApplyTag(MarkDownEmphasisTag tag)
+    {
+        switch (tag)
+        {
+        case MarkDownEmphasisTag::OpenItalic:
+            ++m_italicDepth;
+            break;
+        case MarkDownEmphasisTag::CloseItalic:
+            m_italicDepth = std::max(m_italicDepth - 1, 0);
+            break;
+        case MarkDownEmphasisTag::OpenBold:
+            ++m_boldDepth;
+            break;
+        case MarkDownEmphasisTag::CloseBold:
+            m_boldDepth = std::max(m_boldDepth - 1, 0);
+            break;
+        }
+    }
+
+    void WriteText(size_t offset, size_t length)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+
+        const size_t runOffset = m_runs.text.size();
+        AppendUnescaped(m_runs.text, std::string_view(m_store.text).substr(offset, length));
+        const size_t runLength = m_runs.text.size() - runOffset;
+
+        // text that follows the last run with the same formatting extends it
+        if (!m_runs.runs.empty() && !m_startsParagraph && !m_startsListItem)
+        {
+            MarkDownRun& last = m_runs.runs.back();
+            if (last.offset + last.length == runOffset && last.isBold == (m_boldDepth > 0) &&
+                last.isItalic == (m_italicDepth > 0) && last.isLink == m_isLink && last.urlOffset == m_urlOffset &&
+                last.urlLength == m_urlLength)
+            {
+                last.length += runLength;
+                return;
+            }
+        }
+        AddRun(runOffset, runLength);
+    }
+
+    void AddRun(size_t offset, size_t length)
+    {
+        m_runs.runs.push_back({offset,
+                               length,
+                               m_isLink ? m_urlOffset : 0,
+                               m_isLink ? m_urlLength : 0,
+                               m_listItemNumber,
+                               m_boldDepth > 0,
+                               m_italicDepth > 0,
+                               m_isLink,
+                               m_startsParagraph,
+                               m_startsListItem,
+                               m_isOrderedListItem});
+        m_startsParagraph = false;
+        m_startsListItem = false;
+        m_isOrderedListItem = false;
+        m_listItemNumber = 0;
+    }
+
+    // writes the text of the tokens without formatting, for link destinations
+    void WritePlainText(size_t firstToken)
+    {
+        for (size_t token = firstToken; token != MarkDownTokenStore::None; token = m_store.tokens[token].next)
+        {
+            const MarkDownToken& x = m_store.tokens[token];
+            switch (x.type)
+            {
+            case MarkDownTokenType::Emphasis:
+            {
+                const size_t unusedDelimiters = static_cast<size_t>(m_store.emphases[x.index].numberOfUnusedDelimiters);
+                const size_t unusedOffset = x.offset + x.length - unusedDelimiters;
+                AppendUnescaped(m_runs.text, std::string_view(m_store.text).substr(unusedOffset, unusedDelimiters));
+                break;
+            }
+            case MarkDownTokenType::Link:
+                WritePlainText(m_store.links[x.index].text);
+                break;
+            case MarkDownTokenType::ListItem:
+            case MarkDownTokenType::OrderedListItem:
+                WritePlainText(x.index);
+                break;
+            default:
+                AppendUnescaped(m_runs.text, std::string_view(m_store.text).substr(x.offset, x.length));
+                break;
+            }
+        }
+    }
+
+    const MarkDownTokenStore& m_store;
+    MarkDownRuns& m_runs;
+    int m_boldDepth = 0;
+    int m_italicDepth = 0;
+    bool m_isLink = false;
+    size_t m_urlOffset = 0;
+    size_t m_urlLength = 0;
+    // what the next run starts
+    bool m_startsParagraph = false;
+    bool m_startsListItem = false;
+    bool m_isOrderedListItem = false;
+    unsigned int m_listItemNumber = 0;
+};
+} // namespace
+
 //     left and right emphasis tokens are match if
 //     1. they are same types
 //     2. neither of the emphasis tokens are both left and right emphasis tokens, and
 //        if either or both of them are, then their sum is not multiple of 3
-bool MarkDownEmphasisHtmlGenerator::IsMatch(const MarkDownEmphasisHtmlGenerator& emphasisToken)
+bool MarkDownEmphasis::IsMatch(const MarkDownEmphasis& emphasis) const
 {
-    if (this->type == emphasisToken.type)
+    if (type == emphasis.type)
     {
         // rule #9 & #10, sum of delimiter count can't be multiple of 3
-        return !(
-            (this->IsLeftAndRightEmphasis() || emphasisToken.IsLeftAndRightEmphasis()) &&
-            (((this->m_numberOfUnusedDelimiters + emphasisToken.m_numberOfUnusedDelimiters) % 3) == 0));
+        return !((IsLeftAndRightEmphasis() || emphasis.IsLeftAndRightEmphasis()) &&
+                 (((numberOfUnusedDelimiters + emphasis.numberOfUnusedDelimiters) % 3) == 0));
     }
     return false;
 }
 
-bool MarkDownEmphasisHtmlGenerator::IsSameType(const MarkDownEmphasisHtmlGenerator& token)
-{
-    return this->type == token.type;
-}
-
 // adjust number of emphasis counts after maching is done
-int MarkDownEmphasisHtmlGenerator::AdjustEmphasisCounts(int leftOver, MarkDownEmphasisHtmlGenerator& rightToken)
+int MarkDownEmphasis::AdjustEmphasisCounts(int leftOver, MarkDownEmphasis& rightEmphasis)
 {
     int delimiterCount = 0;
     if (leftOver >= 0)
     {
-        delimiterCount = this->m_numberOfUnusedDelimiters - leftOver;
-        this->m_numberOfUnusedDelimiters = leftOver;
-        rightToken.m_numberOfUnusedDelimiters = 0;
+        delimiterCount = numberOfUnusedDelimiters - leftOver;
+        numberOfUnusedDelimiters = leftOver;
+        rightEmphasis.numberOfUnusedDelimiters = 0;
     }
     else
     {
-        delimiterCount = this->m_numberOfUnusedDelimiters;
-        rightToken.m_numberOfUnusedDelimiters = leftOver * (-1);
-        this->m_numberOfUnusedDelimiters = 0;
+        delimiterCount = numberOfUnusedDelimiters;
+        rightEmphasis.numberOfUnusedDelimiters = leftOver * (-1);
+        numberOfUnusedDelimiters = 0;
     }
     return delimiterCount;
 }
 
-// generate bold and emphasis html tags
-bool MarkDownEmphasisHtmlGenerator::GenerateTags(MarkDownEmphasisHtmlGenerator& token)
+void MarkDownTokenStore::Reserve(size_t length)
 {
-    int delimiterCount = 0, leftOver = 0;
-    leftOver = this->m_numberOfUnusedDelimiters - token.m_numberOfUnusedDelimiters;
-    delimiterCount = this->AdjustEmphasisCounts(leftOver, token);
-    const bool hasHtmlTags = (delimiterCount > 0);
-
-    // emphasis found
-    if (delimiterCount % 2)
-    {
-        this->PushItalicTag();
-        token.PushItalicTag();
-    }
-
-    // strong emphasis found
-    for (int i = 0; i < delimiterCount / 2; i++)
-    {
-        this->PushBoldTag();
-        token.PushBoldTag();
-    }
-    return hasHtmlTags;
+    // tokens hold about as much text as the markdown string
+    text.reserve(length);
+    tokens.reserve(length / 4 + 1);
 }
 
-void MarkDownEmphasisHtmlGenerator::PushItalicTag()
+size_t MarkDownTokenStore::AddToken(MarkDownTokenType type, size_t offset, size_t length, size_t index)
 {
-    m_tags.push_back("<em>");
+    tokens.push_back({type, false, false, offset, length, index, None, None});
+    return tokens.size() - 1;
 }
 
-void MarkDownEmphasisHtmlGenerator::PushBoldTag()
+size_t MarkDownTokenStore::AddEmphasis(MarkDownEmphasis::Kind kind, int sizeOfEmphasisDelimiterRun, DelimiterType type)
 {
-    m_tags.push_back("<strong>");
+    // every match uses up at least as many delimiters as it adds tags, so the run never needs more tags than it has
+    // delimiters
+    emphases.push_back({kind, MarkDownEmphasis::Direction::Right, type, sizeOfEmphasisDelimiterRun, tags.size(), 0, None});
+    tags.resize(tags.size() + static_cast<size_t>(std::max(sizeOfEmphasisDelimiterRun, 0)));
+    return emphases.size() - 1;
 }
 
-std::string MarkDownLeftEmphasisHtmlGenerator::GenerateHtmlString()
+size_t MarkDownTokenStore::AddLink(size_t destination, size_t text)
 {
-    if (m_isHead)
-    {
-        html << "<p>";
-    }
+    links.push_back({destination, text});
+    return links.size() - 1;
+}
 
-    if (m_numberOfUnusedDelimiters)
-    {
-        const size_t startIdx = m_token.size() - m_numberOfUnusedDelimiters;
-        html << m_token.substr(startIdx, std::string::npos);
-    }
+// generate bold and emphasis html tags
+bool MarkDownTokenStore::GenerateTags(size_t leftEmphasis, size_t rightEmphasis)
+{
+    MarkDownEmphasis& left = emphases[leftEmphasis];
+    MarkDownEmphasis& right = emphases[rightEmphasis];
+    const int leftOver = left.numberOfUnusedDelimiters - right.numberOfUnusedDelimiters;
+    const int delimiterCount = left.AdjustEmphasisCounts(leftOver, right);
+    const bool hasHtmlTags = (delimiterCount > 0);
 
-    // append tags; since left delims, append it in the reverse order
-    for (auto itr = m_tags.rbegin(); itr != m_tags.rend(); ++itr)
+    // emphasis found
+    if (delimiterCount % 2)
     {
-        html << *itr;
+        PushItalicTag(left);
+        PushItalicTag(right);
     }
 
-    if (m_isTail)
+    // strong emphasis found
+    for (int i = 0; i < delimiterCount / 2; i++)
     {
-        return html.str() + "</p>";
+        PushBoldTag(left);
+        PushBoldTag(right);
     }
-
-    return html.str();
+    return hasHtmlTags;
 }
 
-void MarkDownRightEmphasisHtmlGenerator::PushItalicTag()
+void MarkDownTokenStore::PushItalicTag(MarkDownEmphasis& emphasis)
 {
-    m_tags.push_back("</em>");
+    PushTag(emphasis, MarkDownEmphasisTag::OpenItalic, MarkDownEmphasisTag::CloseItalic);
 }
 
-void MarkDownRightEmphasisHtmlGenerator::PushBoldTag()
+void MarkDownTokenStore::PushBoldTag(MarkDownEmphasis& emphasis)
 {
-    m_tags.push_back("</strong>");
+    PushTag(emphasis, MarkDownEmphasisTag::OpenBold, MarkDownEmphasisTag::CloseBold);
 }
 
-std::string MarkDownRightEmphasisHtmlGenerator::GenerateHtmlString()
+// left emphasis opens tags and right emphasis closes them; left and right emphasis does what its current direction is
+void MarkDownTokenStore::PushTag(MarkDownEmphasis& emphasis, MarkDownEmphasisTag openingTag, MarkDownEmphasisTag closingTag)
 {
-    if (m_isHead)
-    {
-        html << "<p>";
-    }
-
-    // append tags;
-    for (auto itr = m_tags.begin(); itr != m_tags.end(); ++itr)
-    {
-        html << *itr;
-    }
-
-    // if there are unused emphasis, append them
-    if (m_numberOfUnusedDelimiters)
-    {
-        const size_t startIdx = m_token.size() - m_numberOfUnusedDelimiters;
-        html << m_token.substr(startIdx, std::string::npos);
-    }
-
-    if (m_isTail)
-    {
-        return html.str() + "</p>";
-    }
-
-    return html.str();
+    tags[emphasis.tagsOffset + emphasis.tagCount++] = emphasis.IsLeftEmphasis() ? openingTag : closingTag;
 }
 
-void MarkDownLeftAndRightEmphasisHtmlGenerator::PushItalicTag()
+void MarkDownTokenStore::GenerateHtmlString(size_t firstToken, std::string& html) const
 {
-    if (m_directionType == Left)
-    {
-        m_tags.push_back("<em>");
-    }
-    else
+    for (size_t token = firstToken; token != None; token = tokens[token].next)
     {
-        m_tags.push_back("</em>");
+        GenerateHtmlString(tokens[token], html);
     }
 }
 
-void MarkDownLeftAndRightEmphasisHtmlGenerator::PushBoldTag()
+void MarkDownTokenStore::GenerateHtmlString(const MarkDownToken& token, std::string& html) const
 {
-    if (m_directionType == Left)
-    {
-        m_tags.push_back("<strong>");
-    }
-    else
+    const MarkDownBlockType blockType = token.GetBlockType();
+    if (token.isHead)
     {
-        m_tags.push_back("</strong>");
+        switch (blockType)
+        {
+        case MarkDownBlockType::UnorderedList:
+            html += "<ul>";
+            break;
+        case MarkDownBlockType::OrderedList:
+            html += "<ol start=\"";
+            html.append(text, token.offset, token.length);
+            html += "\">";
+            break;
+        default:
+            html += "<p>";
+            break;
+        }
     }
-}
 
-std::string MarkDownListHtmlGenerator::GenerateHtmlString()
-{
-    if (m_isHead)
+    switch (token.type)
+    {
+    case MarkDownTokenType::Emphasis:
     {
-        m_token = "<ul>" + m_token;
+        const MarkDownEmphasis& emphasis = emphases[token.index];
+        const size_t unusedDelimiters = static_cast<size_t>(emphasis.numberOfUnusedDelimiters);
+        const size_t unusedOffset = token.offset + token.length - unusedDelimiters;
+        const auto firstTag = tags.begin() + emphasis.tagsOffset;
+        const auto lastTag = firstTag + emphasis.tagCount;
+
+        if (emphasis.kind == MarkDownEmphasis::Kind::Left)
+        {
+            html.append(text, unusedOffset, unusedDelimiters);
+
+            // append tags; since left delims, append it in the reverse order
+            for (auto itr = std::make_reverse_iterator(lastTag); itr != std::make_reverse_iterator(firstTag); ++itr)
+            {
+                html += c_tagHtml[static_cast<size_t>(*itr)];
+            }
+        }
+        else
+        {
+            // append tags;
+            for (auto itr = firstTag; itr != lastTag; ++itr)
+            {
+                html += c_tagHtml[static_cast<size_t>(*itr)];
+            }
+
+            // if there are unused emphasis, append them
+            html.append(text, unusedOffset, unusedDelimiters);
+        }
+        break;
+    }
+    case MarkDownTokenType::Link:
+        html += "<a href=\"";
+        GenerateHtmlString(links[token.index].destination, html);
+        html += "\">";
+        GenerateHtmlString(links[token.index].text, html);
+        html += "</a>";
+        break;
+    case MarkDownTokenType::ListItem:
+    case MarkDownTokenType::OrderedListItem:
+        html += "<li>";
+        GenerateHtmlString(token.index, html);
+        html += "</li>";
+        break;
+    default:
+        html.append(text, token.offset, token.length);
+        break;
     }
 
-    if (m_isTail)
+    if (token.isTail)
     {
-        return m_token + "</ul>";
+        switch (blockType)
+        {
+        case MarkDownBlockType::UnorderedList:
+            html += "</ul>";
+            break;
+        case MarkDownBlockType::OrderedList:
+            html += "</ol>";
+            break;
+        default:
+            html += "</p>";
+            break;
+        }
     }
-
-    return m_token;
 }
 
-std::string MarkDownOrderedListHtmlGenerator::GenerateHtmlString()
+// every token is written at most once
+size_t MarkDownTokenStore::GetMaxHtmlLength() const
 {
-    if (m_isHead)
-    {
-        m_token = "<ol start=\"" + m_numberString + "\">" + m_token;
-    }
-
-    if (m_isTail)
-    {
-        return m_token + "</ol>";
-    }
+    return text.size() + tokens.size() * c_maxTokenMarkupLength + tags.size() * c_maxTagLength;
+}
 
-    return m_token;
+void MarkDownTokenStore::GenerateRuns(size_t firstToken, MarkDownRuns& runs) const
+{
+    runs.text.reserve(runs.text.size() + text.size());
+    MarkDownRunWriter writer(*this, runs);
+    writer.Write(firstToken);
+    writer.Finish();
 }
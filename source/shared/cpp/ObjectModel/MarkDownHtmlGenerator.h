@@ -1,11 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #pragma once
-#include <string>
-#include <iomanip>
-#include <vector>
-#include <list>
-#include "BaseCardElement.h"
+#include "pch.h"
+#include <limits>
 
 namespace AdaptiveCards
 {
@@ -20,284 +17,213 @@ enum class DelimiterType
     Asterisk
 };
 
-// this class knows how to generate html string of their types
-// - MarkDownStringHtmlGenerator
+// tokens know how to generate html string of their types
+// - Text
 //   it is the most basic form,
 //   it simply retains and return text as string
-// - MarkDownEmphasisHtmlGenerator
+// - NewLine
+//   it contains new line chars, and is dropped where it ends a block
+// - Emphasis
 //   it knows how to handle bold and italic html
 //   tags and apply those to its text when asked to generate html string
-// - MarkDownListHtmlGenerator
-//   it functions similarly as MarkDownStringHtmlGenerator, but its GetBlockType() returns
+// - Link
+//   it holds the tokens of link text and destination, and generates <a href=\destination\>text</a>
+// - ListItem and OrderedListItem
+//   they hold the tokens of the item, and generate <li>item</li>, but their GetBlockType() returns
 //   MarkDownBlockType, this is used in generating html block tags
-//   list uses block tag of <ul> all others use <p>
-class MarkDownHtmlGenerator
+//   list uses block tag of <ul> or <ol> all others use <p>
+enum class MarkDownTokenType : uint8_t
 {
-public:
-    MarkDownHtmlGenerator(const MarkDownHtmlGenerator&) = delete;
-    MarkDownHtmlGenerator(MarkDownHtmlGenerator&&) = delete;
-    MarkDownHtmlGenerator& operator=(const MarkDownHtmlGenerator&) = delete;
-    MarkDownHtmlGenerator& operator=(MarkDownHtmlGenerator&&) = delete;
-    virtual ~MarkDownHtmlGenerator() = default;
+    Text,
+    NewLine,
+    Emphasis,
+    Link,
+    ListItem,
+    OrderedListItem
+};
 
-    enum MarkDownBlockType
-    {
-        ContainerBlock,
-        UnorderedList,
-        OrderedList
-    };
+enum class MarkDownBlockType : uint8_t
+{
+    ContainerBlock,
+    UnorderedList,
+    OrderedList
+};
 
-    MarkDownHtmlGenerator() : m_token(""){};
-    MarkDownHtmlGenerator(std::string& token) : m_token(token){};
-    void MakeItHead()
-    {
-        m_isHead = true;
-    }
-    void MakeItTail()
-    {
-        m_isTail = true;
-    }
-    virtual bool IsNewLine()
-    {
-        return false;
+// Tokens are plain data kept together in a MarkDownTokenStore. A MarkDownParsedResult holds a list of them linked
+// through previous and next, so tokens are moved between results without being copied.
+struct MarkDownToken
+{
+    MarkDownTokenType type;
+    // first and last token of an html block, which also generate the block's tags
+    bool isHead;
+    bool isTail;
+    // text of the token in MarkDownTokenStore::text; the list's start number for OrderedListItem
+    size_t offset;
+    size_t length;
+    // Emphasis: its entry in MarkDownTokenStore::emphases
+    // Link: its entry in MarkDownTokenStore::links
+    // ListItem and OrderedListItem: the first token of the item
+    size_t index;
+    size_t previous;
+    size_t next;
+
+    MarkDownBlockType GetBlockType() const
+    {
+        switch (type)
+        {
+        case MarkDownTokenType::ListItem:
+            return MarkDownBlockType::UnorderedList;
+        case MarkDownTokenType::OrderedListItem:
+            return MarkDownBlockType::OrderedList;
+        default:
+            return MarkDownBlockType::ContainerBlock;
+        }
     }
-    virtual std::string GenerateHtmlString() = 0;
-    virtual MarkDownBlockType GetBlockType() const
-    {
-        return ContainerBlock;
-    };
-
-protected:
-    std::string m_token;
-    std::ostringstream html;
-    bool m_isHead = false;
-    bool m_isTail = false;
 };
 
-// - MarkDownStringHtmlGenerator
-//   it is the most basic form,
-//   it simply retains and return text as string
-class MarkDownStringHtmlGenerator : public MarkDownHtmlGenerator
+// first tokens of link's destination and text
+struct MarkDownLink
 {
-public:
-    MarkDownStringHtmlGenerator() = delete;
-    MarkDownStringHtmlGenerator(const MarkDownStringHtmlGenerator&) = delete;
-    MarkDownStringHtmlGenerator(MarkDownStringHtmlGenerator&&) = delete;
-    MarkDownStringHtmlGenerator& operator=(const MarkDownStringHtmlGenerator&) = delete;
-    MarkDownStringHtmlGenerator& operator=(MarkDownStringHtmlGenerator&&) = delete;
-    ~MarkDownStringHtmlGenerator() = default;
-
-    MarkDownStringHtmlGenerator(std::string& token) : MarkDownHtmlGenerator(token){};
-    std::string GenerateHtmlString() override;
+    size_t destination;
+    size_t text;
 };
 
-// - MarkDownNewLineHtmlGenerator
-//   it contains new line chars
-class MarkDownNewLineHtmlGenerator : public MarkDownStringHtmlGenerator
+enum class MarkDownEmphasisTag : uint8_t
 {
-public:
-    MarkDownNewLineHtmlGenerator() = delete;
-    MarkDownNewLineHtmlGenerator(const MarkDownNewLineHtmlGenerator&) = delete;
-    MarkDownNewLineHtmlGenerator(MarkDownNewLineHtmlGenerator&&) = delete;
-    MarkDownNewLineHtmlGenerator& operator=(const MarkDownNewLineHtmlGenerator&) = delete;
-    MarkDownNewLineHtmlGenerator& operator=(MarkDownNewLineHtmlGenerator&&) = delete;
-    ~MarkDownNewLineHtmlGenerator() = default;
-
-    MarkDownNewLineHtmlGenerator(std::string& token) : MarkDownStringHtmlGenerator(token){};
-    bool IsNewLine() override
-    {
-        return true;
-    }
+    OpenItalic,
+    CloseItalic,
+    OpenBold,
+    CloseBold
 };
 
-// - MarkDownEmphasisHtmlGenerator
-//   it knows how to handle bold and italic html
-//   tags and apply those to its text when asked to generate html string
-class MarkDownEmphasisHtmlGenerator : public MarkDownHtmlGenerator
+// Emphasis delimiter run of an Emphasis token, which is matched with others by MarkDownParsedResult::Translate()
+// - Left
+//   it knows how to generates opening italic and bold html tags
+// - Right
+//   it knows how to generates closing italic and bold html tags
+// - LeftAndRight
+//   it can have both directions, and its final direction is determined at the later stage
+struct MarkDownEmphasis
 {
-public:
-    MarkDownEmphasisHtmlGenerator() = delete;
-    MarkDownEmphasisHtmlGenerator(const MarkDownEmphasisHtmlGenerator&) = delete;
-    MarkDownEmphasisHtmlGenerator(MarkDownEmphasisHtmlGenerator&&) = delete;
-    MarkDownEmphasisHtmlGenerator& operator=(const MarkDownEmphasisHtmlGenerator&) = delete;
-    MarkDownEmphasisHtmlGenerator& operator=(MarkDownEmphasisHtmlGenerator&&) = delete;
-    ~MarkDownEmphasisHtmlGenerator() = default;
+    enum class Kind : uint8_t
+    {
+        Left,
+        Right,
+        LeftAndRight
+    };
 
-    MarkDownEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type) :
-        MarkDownHtmlGenerator(token), m_numberOfUnusedDelimiters(sizeOfEmphasisDelimiterRun), type(type){};
+    enum class Direction : uint8_t
+    {
+        Left,
+        Right
+    };
 
-    MarkDownEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type, std::vector<std::string>& tags) :
-        MarkDownHtmlGenerator(token), m_numberOfUnusedDelimiters(sizeOfEmphasisDelimiterRun), type(type), m_tags(tags){};
+    Kind kind;
+    Direction direction;
+    DelimiterType type;
+    int numberOfUnusedDelimiters;
+    // tags in MarkDownTokenStore::tags, which has room for one per delimiter of the run
+    size_t tagsOffset;
+    size_t tagCount;
+    // next emphasis in the look up table of the parsed result holding it
+    size_t next;
 
-    virtual bool IsRightEmphasis() const
+    bool IsLeftEmphasis() const
     {
-        return false;
+        return kind == Kind::Left || (kind == Kind::LeftAndRight && direction == Direction::Left);
     }
-    virtual bool IsLeftEmphasis() const
+    bool IsRightEmphasis() const
     {
-        return false;
+        return kind == Kind::Right || (kind == Kind::LeftAndRight && direction == Direction::Right);
     }
-    virtual bool IsLeftAndRightEmphasis() const
+    bool IsLeftAndRightEmphasis() const
     {
-        return false;
+        return kind == Kind::LeftAndRight;
     }
-    virtual void PushItalicTag();
-    virtual void PushBoldTag();
-
-    bool IsMatch(const MarkDownEmphasisHtmlGenerator& token);
-    bool IsSameType(const MarkDownEmphasisHtmlGenerator& token);
-    bool IsDone() const
+    bool IsMatch(const MarkDownEmphasis& emphasis) const;
+    bool IsSameType(const MarkDownEmphasis& emphasis) const
     {
-        return m_numberOfUnusedDelimiters == 0;
+        return type == emphasis.type;
     }
-    int GetNumberOfUnusedDelimiters() const
+    bool IsDone() const
     {
-        return m_numberOfUnusedDelimiters;
-    };
-    bool GenerateTags(MarkDownEmphasisHtmlGenerator& token);
+        return numberOfUnusedDelimiters == 0;
+    }
     void ReverseDirectionType()
     {
-        m_directionType = !m_directionType;
-    };
-
-protected:
-    enum
-    {
-        Left = 0,
-        Right = 1,
-    };
-
-    int AdjustEmphasisCounts(int leftOver, MarkDownEmphasisHtmlGenerator& rightToken);
-    int m_numberOfUnusedDelimiters;
-    int m_directionType = Right;
-    DelimiterType type;
-    std::vector<std::string> m_tags;
+        direction = (direction == Direction::Left) ? Direction::Right : Direction::Left;
+    }
+    // adjust number of emphasis counts after maching is done, and return how many delimiters were matched
+    int AdjustEmphasisCounts(int leftOver, MarkDownEmphasis& rightEmphasis);
 };
 
-// - MarkDownLeftEmphasisHtmlGenerator
-//   it knows how to generates opening italic and bold html tags
-class MarkDownLeftEmphasisHtmlGenerator : public MarkDownEmphasisHtmlGenerator
+// A run of text with the same formatting, see MarkDownRuns
+struct MarkDownRun
 {
-public:
-    MarkDownLeftEmphasisHtmlGenerator() = delete;
-    MarkDownLeftEmphasisHtmlGenerator(const MarkDownLeftEmphasisHtmlGenerator&) = delete;
-    MarkDownLeftEmphasisHtmlGenerator(MarkDownLeftEmphasisHtmlGenerator&&) = delete;
-    MarkDownLeftEmphasisHtmlGenerator& operator=(const MarkDownLeftEmphasisHtmlGenerator&) = delete;
-    MarkDownLeftEmphasisHtmlGenerator& operator=(MarkDownLeftEmphasisHtmlGenerator&&) = delete;
-    ~MarkDownLeftEmphasisHtmlGenerator() = default;
-
-    MarkDownLeftEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type) :
-        MarkDownEmphasisHtmlGenerator(token, sizeOfEmphasisDelimiterRun, type){};
-
-    MarkDownLeftEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type, std::vector<std::string>& tags) :
-        MarkDownEmphasisHtmlGenerator(token, sizeOfEmphasisDelimiterRun, type, tags){};
-
-    bool IsLeftEmphasis() const override
-    {
-        return true;
-    }
-    std::string GenerateHtmlString() override;
+    // the run's text in MarkDownRuns::text
+    size_t offset;
+    size_t length;
+    // the destination of the link the run is in, in MarkDownRuns::text
+    size_t urlOffset;
+    size_t urlLength;
+    // the number of the list item the run starts, for items of ordered lists
+    unsigned int listItemNumber;
+    bool isBold;
+    bool isItalic;
+    bool isLink;
+    // the run is the first of a paragraph or a list item, and may be empty if that has no text
+    bool startsParagraph;
+    bool startsListItem;
+    bool isOrderedListItem;
 };
 
-// - MarkDownRightEmphasisHtmlGenerator
-//   it knows how to generates closing italic and bold html tags
-class MarkDownRightEmphasisHtmlGenerator : public MarkDownEmphasisHtmlGenerator
+// Markdown as runs of formatted text, which is what TransformToHtml()'s html describes, for renderers to use without
+// parsing html. Text isn't html escaped.
+struct MarkDownRuns
 {
-public:
-    MarkDownRightEmphasisHtmlGenerator() = delete;
-    MarkDownRightEmphasisHtmlGenerator(const MarkDownRightEmphasisHtmlGenerator&) = delete;
-    MarkDownRightEmphasisHtmlGenerator(MarkDownRightEmphasisHtmlGenerator&&) = delete;
-    MarkDownRightEmphasisHtmlGenerator& operator=(const MarkDownRightEmphasisHtmlGenerator&) = delete;
-    MarkDownRightEmphasisHtmlGenerator& operator=(MarkDownRightEmphasisHtmlGenerator&&) = delete;
-    ~MarkDownRightEmphasisHtmlGenerator() = default;
-
-    MarkDownRightEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type) :
-        MarkDownEmphasisHtmlGenerator(token, sizeOfEmphasisDelimiterRun, type){};
-
-    void GenerateTags(std::shared_ptr<MarkDownEmphasisHtmlGenerator>& token);
-    bool IsRightEmphasis() const override
-    {
-        return true;
-    }
-    std::string GenerateHtmlString() override;
-    void PushItalicTag() override;
-    void PushBoldTag() override;
+    std::string text;
+    std::vector<MarkDownRun> runs;
 };
 
-// - MarkDownLeftAndRightEmphasisHtmlGenerator
-//   it can have both directions, and its final direction is determined at the later stage
-class MarkDownLeftAndRightEmphasisHtmlGenerator : public MarkDownRightEmphasisHtmlGenerator
+// Holds what the parsers produce for one markdown string, shared by all the parsers and parsed results working on it
+// so that parsing allocates per buffer rather than per token
+struct MarkDownTokenStore
 {
-public:
-    MarkDownLeftAndRightEmphasisHtmlGenerator() = delete;
-    MarkDownLeftAndRightEmphasisHtmlGenerator(const MarkDownLeftAndRightEmphasisHtmlGenerator&) = delete;
-    MarkDownLeftAndRightEmphasisHtmlGenerator(MarkDownLeftAndRightEmphasisHtmlGenerator&&) = delete;
-    MarkDownLeftAndRightEmphasisHtmlGenerator& operator=(const MarkDownLeftAndRightEmphasisHtmlGenerator&) = delete;
-    MarkDownLeftAndRightEmphasisHtmlGenerator& operator=(MarkDownLeftAndRightEmphasisHtmlGenerator&&) = delete;
-    ~MarkDownLeftAndRightEmphasisHtmlGenerator() = default;
+    static constexpr size_t None = std::numeric_limits<size_t>::max();
 
-    MarkDownLeftAndRightEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type) :
-        MarkDownRightEmphasisHtmlGenerator(token, sizeOfEmphasisDelimiterRun, type){};
-    bool IsRightEmphasis() const override
-    {
-        return m_directionType == Right;
-    }
-    bool IsLeftEmphasis() const override
-    {
-        return m_directionType == Left;
-    }
-    bool IsLeftAndRightEmphasis() const override
-    {
-        return true;
-    };
-    void PushItalicTag() override;
-    void PushBoldTag() override;
-};
+    // text of all tokens; the token being collected is at its end
+    std::string text;
+    std::vector<MarkDownToken> tokens;
+    std::vector<MarkDownEmphasis> emphases;
+    std::vector<MarkDownEmphasisTag> tags;
+    std::vector<MarkDownLink> links;
 
-// - MarkDownListHtmlGenerator
-//   it functions similarly as MarkDownStringHtmlGenerator, but its GetBlockType() returns
-//   UnorderedList type, this is used in generating html block tags <ul>
-class MarkDownListHtmlGenerator : public MarkDownStringHtmlGenerator
-{
-public:
-    MarkDownListHtmlGenerator() = delete;
-    MarkDownListHtmlGenerator(const MarkDownListHtmlGenerator&) = delete;
-    MarkDownListHtmlGenerator(MarkDownListHtmlGenerator&&) = delete;
-    MarkDownListHtmlGenerator& operator=(const MarkDownListHtmlGenerator&) = delete;
-    MarkDownListHtmlGenerator& operator=(MarkDownListHtmlGenerator&&) = delete;
-    ~MarkDownListHtmlGenerator() = default;
+    // used while matching emphases
+    std::vector<size_t> leftEmphasisToExplore;
+    std::vector<size_t> unmatchedLeftEmphasis;
 
-    MarkDownListHtmlGenerator(std::string& token) : MarkDownStringHtmlGenerator(token){};
-    std::string GenerateHtmlString() override;
-    MarkDownBlockType GetBlockType() const override
-    {
-        return UnorderedList;
-    };
-};
+    // reserves room for parsing a markdown string of given length
+    void Reserve(size_t length);
 
-// - MarkDownUnorderedListHtmlGenerator
-//   it functions similarly as MarkDownStringHtmlGenerator, but its GetBlockType() returns
-//   OrderedList type, this is used in generating html block tags <ol>
-class MarkDownOrderedListHtmlGenerator : public MarkDownStringHtmlGenerator
-{
-public:
-    MarkDownOrderedListHtmlGenerator() = delete;
-    MarkDownOrderedListHtmlGenerator(const MarkDownOrderedListHtmlGenerator&) = delete;
-    MarkDownOrderedListHtmlGenerator(MarkDownOrderedListHtmlGenerator&&) = delete;
-    MarkDownOrderedListHtmlGenerator& operator=(const MarkDownOrderedListHtmlGenerator&) = delete;
-    MarkDownOrderedListHtmlGenerator& operator=(MarkDownOrderedListHtmlGenerator&&) = delete;
-    ~MarkDownOrderedListHtmlGenerator() = default;
+    size_t AddToken(MarkDownTokenType type, size_t offset, size_t length, size_t index = None);
+    size_t AddEmphasis(MarkDownEmphasis::Kind kind, int sizeOfEmphasisDelimiterRun, DelimiterType type);
+    size_t AddLink(size_t destination, size_t text);
 
-    MarkDownOrderedListHtmlGenerator(std::string& token, std::string& number_string) :
-        MarkDownStringHtmlGenerator(token), m_numberString(number_string){};
-    std::string GenerateHtmlString() override;
-    MarkDownBlockType GetBlockType() const override
-    {
-        return OrderedList;
-    };
+    // generate bold and emphasis html tags for a match of left and right emphasis
+    bool GenerateTags(size_t leftEmphasis, size_t rightEmphasis);
+
+    // appends html of the tokens from the given one on
+    void GenerateHtmlString(size_t firstToken, std::string& html) const;
+    // the most GenerateHtmlString() can append for any of the tokens
+    size_t GetMaxHtmlLength() const;
+
+    // appends runs of the tokens from the given one on
+    void GenerateRuns(size_t firstToken, MarkDownRuns& runs) const;
 
 private:
-    std::string m_numberString;
+    void GenerateHtmlString(const MarkDownToken& token, std::string& html) const;
+    void PushItalicTag(MarkDownEmphasis& emphasis);
+    void PushBoldTag(MarkDownEmphasis& emphasis);
+    void PushTag(MarkDownEmphasis& emphasis, MarkDownEmphasisTag openingTag, MarkDownEmphasisTag closingTag);
 };
-
 } // namespace AdaptiveCards
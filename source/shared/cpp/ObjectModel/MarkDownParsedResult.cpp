@@ -14,108 +14,196 @@ void MarkDownParsedResult::Translate()
 void MarkDownParsedResult::AddBlockTags()
 {
     // Parsing is done, let code gen token know who is the head of the list
-    m_codeGenTokens.front()->MakeItHead();
+    m_store.tokens[m_firstToken].isHead = true;
 
     // Parsing is done, let code gen token know who is the tail of the list
-    m_codeGenTokens.back()->MakeItTail();
+    m_store.tokens[m_lastToken].isTail = true;
 }
 
-void MarkDownParsedResult::MarkTags(MarkDownHtmlGenerator& x)
+void MarkDownParsedResult::MarkTags(MarkDownToken& x)
 {
-    if (m_codeGenTokens.back()->GetBlockType() != x.GetBlockType())
+    if (m_store.tokens[m_lastToken].GetBlockType() != x.GetBlockType())
     {
-        if (m_codeGenTokens.back()->IsNewLine())
+        if (m_store.tokens[m_lastToken].type == MarkDownTokenType::NewLine)
         {
-            m_codeGenTokens.pop_back();
+            PopBack();
         }
 
-        if (!m_codeGenTokens.empty())
+        if (m_lastToken != MarkDownTokenStore::None)
         {
-            m_codeGenTokens.back()->MakeItTail();
+            m_store.tokens[m_lastToken].isTail = true;
         }
-        x.MakeItHead();
+        x.isHead = true;
     }
 }
 // append caller's parsed result to callee's parsed result
 void MarkDownParsedResult::AppendParseResult(MarkDownParsedResult& x)
 {
-    if (!m_codeGenTokens.empty() && !x.m_codeGenTokens.empty())
+    if (x.m_firstToken != MarkDownTokenStore::None)
     {
-        // check if two different block types, then add closing tag followed by the opening tag of new type
-        MarkTags(*(x.m_codeGenTokens.front()));
+        if (m_lastToken != MarkDownTokenStore::None)
+        {
+            // check if two different block types, then add closing tag followed by the opening tag of new type
+            MarkTags(m_store.tokens[x.m_firstToken]);
+        }
+
+        if (m_lastToken == MarkDownTokenStore::None)
+        {
+            m_firstToken = x.m_firstToken;
+        }
+        else
+        {
+            m_store.tokens[m_lastToken].next = x.m_firstToken;
+            m_store.tokens[x.m_firstToken].previous = m_lastToken;
+        }
+        m_lastToken = x.m_lastToken;
+        x.m_firstToken = MarkDownTokenStore::None;
+        x.m_lastToken = MarkDownTokenStore::None;
     }
-    m_codeGenTokens.splice(m_codeGenTokens.end(), x.m_codeGenTokens);
-    m_emphasisLookUpTable.splice(m_emphasisLookUpTable.end(), x.m_emphasisLookUpTable);
+
+    if (x.m_firstEmphasis != MarkDownTokenStore::None)
+    {
+        if (m_lastEmphasis == MarkDownTokenStore::None)
+        {
+            m_firstEmphasis = x.m_firstEmphasis;
+        }
+        else
+        {
+            m_store.emphases[m_lastEmphasis].next = x.m_firstEmphasis;
+        }
+        m_lastEmphasis = x.m_lastEmphasis;
+        x.m_firstEmphasis = MarkDownTokenStore::None;
+        x.m_lastEmphasis = MarkDownTokenStore::None;
+    }
+
     m_isHTMLTagsAdded = m_isHTMLTagsAdded || x.HasHtmlTags();
     SetIsCaptured(x.GetIsCaptured());
 }
 
-// append MarkDownHtmlGenerator object to callee's prased result
-void MarkDownParsedResult::AppendToTokens(const std::shared_ptr<MarkDownHtmlGenerator>& x)
+// append token to callee's prased result
+void MarkDownParsedResult::AppendToTokens(size_t token)
 {
-    if (!m_codeGenTokens.empty())
+    MarkDownToken& x = m_store.tokens[token];
+    if (m_lastToken != MarkDownTokenStore::None)
     {
         // check if two different block types, then add closing tag followed by the opening tag of new type
-        MarkTags(*(x));
+        MarkTags(x);
+    }
+
+    x.previous = m_lastToken;
+    x.next = MarkDownTokenStore::None;
+    if (m_lastToken == MarkDownTokenStore::None)
+    {
+        m_firstToken = token;
+    }
+    else
+    {
+        m_store.tokens[m_lastToken].next = token;
     }
-    m_codeGenTokens.push_back(x);
+    m_lastToken = token;
 }
 
-void MarkDownParsedResult::AppendToLookUpTable(const std::shared_ptr<MarkDownEmphasisHtmlGenerator>& x)
+void MarkDownParsedResult::AppendToLookUpTable(size_t emphasis)
 {
-    m_emphasisLookUpTable.push_back(x);
+    m_store.emphases[emphasis].next = MarkDownTokenStore::None;
+    if (m_lastEmphasis == MarkDownTokenStore::None)
+    {
+        m_firstEmphasis = emphasis;
+    }
+    else
+    {
+        m_store.emphases[m_lastEmphasis].next = emphasis;
+    }
+    m_lastEmphasis = emphasis;
+}
+
+// removes token from the list; it stays in the look up table if it's an emphasis
+void MarkDownParsedResult::RemoveToken(size_t token)
+{
+    const MarkDownToken& x = m_store.tokens[token];
+    if (x.previous == MarkDownTokenStore::None)
+    {
+        m_firstToken = x.next;
+    }
+    else
+    {
+        m_store.tokens[x.previous].next = x.next;
+    }
+
+    if (x.next == MarkDownTokenStore::None)
+    {
+        m_lastToken = x.previous;
+    }
+    else
+    {
+        m_store.tokens[x.next].previous = x.previous;
+    }
 }
 
 void MarkDownParsedResult::PopFront()
 {
-    m_codeGenTokens.pop_front();
+    if (m_firstToken != MarkDownTokenStore::None)
+    {
+        RemoveToken(m_firstToken);
+    }
 }
 
 void MarkDownParsedResult::PopBack()
 {
-    m_codeGenTokens.pop_back();
+    if (m_lastToken != MarkDownTokenStore::None)
+    {
+        RemoveToken(m_lastToken);
+    }
 }
 
 void MarkDownParsedResult::Clear()
 {
-    m_codeGenTokens.clear();
-    m_emphasisLookUpTable.clear();
+    m_firstToken = MarkDownTokenStore::None;
+    m_lastToken = MarkDownTokenStore::None;
+    m_firstEmphasis = MarkDownTokenStore::None;
+    m_lastEmphasis = MarkDownTokenStore::None;
 }
 
-// create and add new MarkDownStringHtmlGenerator object that has string of ch
+// create and add new text token that has string of ch
 void MarkDownParsedResult::AddNewTokenToParsedResult(int ch)
 {
-    std::string string_token = std::string(1, static_cast<char>(ch));
-    std::shared_ptr<MarkDownStringHtmlGenerator> htmlToken = std::make_shared<MarkDownStringHtmlGenerator>(string_token);
-    AppendToTokens(htmlToken);
+    const size_t offset = m_store.text.size();
+    m_store.text.push_back(static_cast<char>(ch));
+    AppendToTokens(m_store.AddToken(MarkDownTokenType::Text, offset, 1));
 }
 
-// create and add new MarkDownStringHtmlGenerator object that has string word
-void MarkDownParsedResult::AddNewTokenToParsedResult(std::string& word)
+// create and add new text token that has string word
+void MarkDownParsedResult::AddNewTokenToParsedResult(std::string_view word)
 {
-    std::shared_ptr<MarkDownStringHtmlGenerator> htmlToken = std::make_shared<MarkDownStringHtmlGenerator>(word);
-    AppendToTokens(htmlToken);
+    const size_t offset = m_store.text.size();
+    m_store.text.append(word);
+    AppendToTokens(m_store.AddToken(MarkDownTokenType::Text, offset, word.size()));
 }
 
-// create and add new MarkDownSpaceHtmlGenerator object that has string of ch
+// create and add new new line token that has string of ch
 void MarkDownParsedResult::AddNewLineTokenToParsedResult(char ch)
 {
-    std::string string_token = std::string(1, ch);
-    std::shared_ptr<MarkDownHtmlGenerator> htmlToken = std::make_shared<MarkDownNewLineHtmlGenerator>(string_token);
-    AppendToTokens(htmlToken);
+    const size_t offset = m_store.text.size();
+    m_store.text.push_back(ch);
+    AppendToTokens(m_store.AddToken(MarkDownTokenType::NewLine, offset, 1));
 }
 
-std::string MarkDownParsedResult::GenerateHtmlString()
+std::string MarkDownParsedResult::GenerateHtmlString() const
 {
-    // process tags
-    std::ostringstream html;
+    std::string html;
+    GenerateHtmlString(html);
+    return html;
+}
 
-    for (auto itr = m_codeGenTokens.begin(); itr != m_codeGenTokens.end(); ++itr)
-    {
-        html << (*itr)->GenerateHtmlString();
-    }
+void MarkDownParsedResult::GenerateHtmlString(std::string& html) const
+{
+    html.reserve(html.size() + m_store.GetMaxHtmlLength());
+    m_store.GenerateHtmlString(m_firstToken, html);
+}
 
-    return html.str();
+void MarkDownParsedResult::GenerateRuns(MarkDownRuns& runs) const
+{
+    m_store.GenerateRuns(m_firstToken, runs);
 }
 
 // Following the rules speicified in CommonMark (http://spec.commonmark.org/0.27/)
@@ -132,27 +220,29 @@ std::string MarkDownParsedResult::GenerateHtmlString()
 // add comments -> what it does: generating  n supported features + 1 tokens --> capture them in token class
 void MarkDownParsedResult::MatchLeftAndRightEmphasises()
 {
-    std::vector<std::list<std::shared_ptr<MarkDownEmphasisHtmlGenerator>>::iterator> leftEmphasisToExplore;
-    auto currentEmphasis = m_emphasisLookUpTable.begin();
+    std::vector<MarkDownEmphasis>& emphases = m_store.emphases;
+    std::vector<size_t>& leftEmphasisToExplore = m_store.leftEmphasisToExplore;
+    leftEmphasisToExplore.clear();
+    size_t currentEmphasis = m_firstEmphasis;
 
-    while (!(currentEmphasis == m_emphasisLookUpTable.end()))
+    while (currentEmphasis != MarkDownTokenStore::None)
     {
         // keep exploring left until right token is found
-        if ((*currentEmphasis)->IsLeftEmphasis() ||
-            ((*currentEmphasis)->IsLeftAndRightEmphasis() && leftEmphasisToExplore.empty()))
+        if (emphases[currentEmphasis].IsLeftEmphasis() ||
+            (emphases[currentEmphasis].IsLeftAndRightEmphasis() && leftEmphasisToExplore.empty()))
         {
-            if ((*currentEmphasis)->IsLeftAndRightEmphasis() && (*currentEmphasis)->IsRightEmphasis())
+            if (emphases[currentEmphasis].IsLeftAndRightEmphasis() && emphases[currentEmphasis].IsRightEmphasis())
             {
                 // Reverse Direction Type; right empahsis to left emphasis
-                (*currentEmphasis)->ReverseDirectionType();
+                emphases[currentEmphasis].ReverseDirectionType();
             }
 
             leftEmphasisToExplore.push_back(currentEmphasis);
-            ++currentEmphasis;
+            currentEmphasis = emphases[currentEmphasis].next;
         }
         else if (!leftEmphasisToExplore.empty())
         {
-            auto currentLeftEmphasis = leftEmphasisToExplore.back();
+            size_t currentLeftEmphasis = leftEmphasisToExplore.back();
             // because of rule #9 & #10 and multiple of 3 rule, left delim can jump ahead of right delim,
             // so need to check this condition.
 
@@ -172,9 +262,10 @@ void MarkDownParsedResult::MatchLeftAndRightEmphasises()
             //        as left emphasis
             //        else
             //        use current left emphasis to search, and pop current right emphasis
-            if (!(*currentLeftEmphasis)->IsMatch(*(*currentEmphasis)))
+            if (!emphases[currentLeftEmphasis].IsMatch(emphases[currentEmphasis]))
             {
-                std::vector<std::list<std::shared_ptr<MarkDownEmphasisHtmlGenerator>>::iterator> store;
+                std::vector<size_t>& store = m_store.unmatchedLeftEmphasis;
+                store.clear();
                 bool isFound = false;
                 // search first if matching left emphasis can be found with the right delim
                 // if match found, set the new left emphasis token as current token, and
@@ -183,8 +274,8 @@ void MarkDownParsedResult::MatchLeftAndRightEmphasises()
                 // pop until matching delim is found
                 while (!leftEmphasisToExplore.empty() && !isFound)
                 {
-                    auto leftToken = leftEmphasisToExplore.back();
-                    if ((*leftToken)->IsMatch(*(*currentEmphasis)))
+                    const size_t leftToken = leftEmphasisToExplore.back();
+                    if (emphases[leftToken].IsMatch(emphases[currentEmphasis]))
                     {
                         currentLeftEmphasis = leftToken;
                         isFound = true;
@@ -213,39 +304,38 @@ void MarkDownParsedResult::MatchLeftAndRightEmphasises()
                     }
 
                     // check for the reason why we had to backtrack
-                    if ((*leftEmphasisToExplore.back())->IsSameType(*(*currentEmphasis)))
+                    if (emphases[leftEmphasisToExplore.back()].IsSameType(emphases[currentEmphasis]))
                     {
                         // right emphasis becomes left emphasis
-                        /// create new left empahsis html generator from right
-                        (*currentEmphasis)->ReverseDirectionType();
+                        emphases[currentEmphasis].ReverseDirectionType();
                     }
                     else
                     {
                         // move to next token for right delim tokens
-                        ++currentEmphasis;
+                        currentEmphasis = emphases[currentEmphasis].next;
                     }
                     // no maching found begin from the start
                     continue;
                 }
             }
             // check which one has leftover delims
-            m_isHTMLTagsAdded = (*currentLeftEmphasis)->GenerateTags(*(*currentEmphasis)) || m_isHTMLTagsAdded;
+            m_isHTMLTagsAdded = m_store.GenerateTags(currentLeftEmphasis, currentEmphasis) || m_isHTMLTagsAdded;
 
             // all right delims used, move to next
-            if ((*currentEmphasis)->IsDone())
+            if (emphases[currentEmphasis].IsDone())
             {
-                ++currentEmphasis;
+                currentEmphasis = emphases[currentEmphasis].next;
             }
 
             // all left or right delims used, pop
-            if ((*currentLeftEmphasis)->IsDone())
+            if (emphases[currentLeftEmphasis].IsDone())
             {
                 leftEmphasisToExplore.pop_back();
             }
         }
         else
         {
-            ++currentEmphasis;
+            currentEmphasis = emphases[currentEmphasis].next;
         }
     }
 }
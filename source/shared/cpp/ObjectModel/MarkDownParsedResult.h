@@ -4,38 +4,50 @@
 
 #include "BaseCardElement.h"
 #include "MarkDownHtmlGenerator.h"
-#include <list>
 
 namespace AdaptiveCards
 {
-// Holds Parsing Result of MarkDown String
+// Holds Parsing Result of MarkDown String; its tokens are kept in the given store
 class MarkDownParsedResult
 {
 public:
-    MarkDownParsedResult() : m_isHTMLTagsAdded(false), m_isCaptured(false){};
+    explicit MarkDownParsedResult(MarkDownTokenStore& store) :
+        m_store(store), m_firstToken(MarkDownTokenStore::None), m_lastToken(MarkDownTokenStore::None),
+        m_firstEmphasis(MarkDownTokenStore::None), m_lastEmphasis(MarkDownTokenStore::None), m_isHTMLTagsAdded(false),
+        m_isCaptured(false){};
+    MarkDownParsedResult(const MarkDownParsedResult&) = delete;
+    MarkDownParsedResult(MarkDownParsedResult&&) = delete;
+    MarkDownParsedResult& operator=(const MarkDownParsedResult&) = delete;
+    MarkDownParsedResult& operator=(MarkDownParsedResult&&) = delete;
+    ~MarkDownParsedResult() = default;
 
     // Translate Intermediate Parsing Result to a form that can be written to html string
     void Translate();
     void AddBlockTags();
 
     // Write to html string
-    std::string GenerateHtmlString();
+    std::string GenerateHtmlString() const;
+    // Append html to the given string
+    void GenerateHtmlString(std::string& html) const;
+
+    // Append runs of formatted text to the given runs
+    void GenerateRuns(MarkDownRuns& runs) const;
 
     // Append contents of the given parsing result object
     void AppendParseResult(MarkDownParsedResult&);
 
-    // Append html code gen object to parse result
-    void AppendToTokens(const std::shared_ptr<MarkDownHtmlGenerator>&);
+    // Append token of the store to parse result
+    void AppendToTokens(size_t token);
 
-    // Append emphasis html code gen object to parse result
-    void AppendToLookUpTable(const std::shared_ptr<MarkDownEmphasisHtmlGenerator>&);
+    // Append emphasis of the store to parse result
+    void AppendToLookUpTable(size_t emphasis);
 
     // Take a char and convert it html code gen and append it to the result. used to store MarkDown keywords such as
     // '[', ']', '(', ')'
     void AddNewTokenToParsedResult(int ch);
 
     // Take string and convert it html code gen and append it to the result
-    void AddNewTokenToParsedResult(std::string& word);
+    void AddNewTokenToParsedResult(std::string_view word);
 
     // Take a new line char and convert it html code gen and append it to the result It is used to store MarkDown
     // keywords such as '\r', '\n'
@@ -53,15 +65,27 @@ public:
     {
         m_isCaptured = val;
     }
+    MarkDownTokenStore& GetStore()
+    {
+        return m_store;
+    }
+    size_t GetFirstToken() const
+    {
+        return m_firstToken;
+    }
 
 private:
-    void MarkTags(MarkDownHtmlGenerator&);
-    std::list<std::shared_ptr<MarkDownHtmlGenerator>> m_codeGenTokens;
-    std::list<std::shared_ptr<MarkDownEmphasisHtmlGenerator>> m_emphasisLookUpTable;
+    void MarkTags(MarkDownToken&);
+    void RemoveToken(size_t token);
+    MarkDownTokenStore& m_store;
+    size_t m_firstToken;
+    size_t m_lastToken;
+    size_t m_firstEmphasis;
+    size_t m_lastEmphasis;
     bool m_isHTMLTagsAdded;
     bool m_isCaptured;
 
-    // take m_emphasisLookUpTable and matches left and right emphasises
+    // take emphasis look up table and matches left and right emphasises
     void MatchLeftAndRightEmphasises();
 };
 } // namespace AdaptiveCards
@@ -1,14 +1,86 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "pch.h"
-#include <vector>
-#include <iomanip>
-#include <iostream>
 #include "MarkDownParser.h"
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MARKDOWN_SCAN_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MARKDOWN_SCAN_NEON
+#endif
 
 using namespace AdaptiveCards;
 
-MarkDownParser::MarkDownParser(const std::string& txt) : m_text(txt), m_hasHTMLTag(false), m_isEscaped(false)
+namespace
+{
+// chars EscapeText() escapes, and chars that are markdown syntax wherever they are
+constexpr char c_specialChars[] = {'<', '>', '"', '&', '*', '_', '[', ']', ')', '\n', '\r'};
+
+constexpr std::array<bool, 256> MakeSpecialCharTable()
+{
+    std::array<bool, 256> table{};
+    for (const char ch : c_specialChars)
+    {
+        table[static_cast<unsigned char>(ch)] = true;
+    }
+    return table;
+}
+
+constexpr std::array<bool, 256> c_isSpecialChar = MakeSpecialCharTable();
+
+bool IsSpecialChar(char ch)
+{
+    return c_isSpecialChar[static_cast<unsigned char>(ch)];
+}
+
+// the first special char from begin on, or end; text is compared a 16 byte block at a time where SSE2 or NEON is
+// available, which most text has no special chars in
+const char* FindSpecialChar(const char* begin, const char* end)
+{
+    constexpr ptrdiff_t c_blockSize = 16;
+#if defined(MARKDOWN_SCAN_SSE2)
+    while (end - begin >= c_blockSize)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        __m128i matches = _mm_setzero_si128();
+        for (const char ch : c_specialChars)
+        {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(ch)));
+        }
+        if (_mm_movemask_epi8(matches) != 0)
+        {
+            break;
+        }
+        begin += c_blockSize;
+    }
+#elif defined(MARKDOWN_SCAN_NEON)
+    while (end - begin >= c_blockSize)
+    {
+        const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(begin));
+        uint8x16_t matches = vdupq_n_u8(0);
+        for (const char ch : c_specialChars)
+        {
+            matches = vorrq_u8(matches, vceqq_u8(block, vdupq_n_u8(static_cast<uint8_t>(ch))));
+        }
+        const uint64x2_t lanes = vreinterpretq_u64_u8(matches);
+        if ((vgetq_lane_u64(lanes, 0) | vgetq_lane_u64(lanes, 1)) != 0)
+        {
+            break;
+        }
+        begin += c_blockSize;
+    }
+#endif
+    // the block with a special char, and the end of the text, are searched a char at a time
+    return std::find_if(begin, end, IsSpecialChar);
+}
+} // namespace
+
+MarkDownParser::MarkDownParser(const std::string& txt) :
+    m_text(txt), m_parsedResult(m_tokenStore), m_hasHTMLTag(false), m_isEscaped(false), m_isParsed(false),
+    m_isPlainText(false)
 {
 }
 
@@ -19,6 +91,55 @@ std::string MarkDownParser::TransformToHtml()
     {
         return "<p></p>";
     }
+    Parse();
+    if (m_isPlainText)
+    {
+        std::string html;
+        html.reserve(m_escapedText.length() + sizeof("<p></p>") - 1);
+        html += "<p>";
+        html += m_escapedText;
+        html += "</p>";
+        return html;
+    }
+    return m_parsedResult.GenerateHtmlString();
+}
+
+// transforms string to runs
+MarkDownRuns MarkDownParser::TransformToRuns()
+{
+    MarkDownRuns runs;
+    if (m_text.empty())
+    {
+        runs.runs.push_back({0, 0, 0, 0, 0, false, false, false, true, false, false});
+        return runs;
+    }
+    Parse();
+    if (m_isPlainText)
+    {
+        runs.text = m_text;
+        runs.runs.push_back({0, m_text.length(), 0, 0, 0, false, false, false, true, false, false});
+        return runs;
+    }
+    m_parsedResult.GenerateRuns(runs);
+    return runs;
+}
+
+// parses the string once, for any of its transforms
+void MarkDownParser::Parse()
+{
+    if (m_isParsed)
+    {
+        return;
+    }
+    m_isParsed = true;
+
+    // text without markdown syntax is a paragraph of its escaped text
+    EscapeText();
+    if (m_isPlainText)
+    {
+        return;
+    }
+
     // begin parsing html blocks
     ParseBlock();
 
@@ -30,7 +151,6 @@ std::string MarkDownParser::TransformToHtml()
     m_parsedResult.AddBlockTags();
 
     m_hasHTMLTag = m_parsedResult.HasHtmlTags();
-    return m_parsedResult.GenerateHtmlString();
 }
 
 bool MarkDownParser::HasHtmlTags()
@@ -51,44 +171,60 @@ std::string MarkDownParser::GetRawText() const
 // MarkDown is consisted of Blocks, this methods parses blocks
 void MarkDownParser::ParseBlock()
 {
-    std::stringstream stream(EscapeText());
-    EmphasisParser parser;
-    while (!stream.eof())
+    m_tokenStore.Reserve(m_escapedText.size());
+    MarkDownCursor stream(m_escapedText);
+    EmphasisParser parser(m_tokenStore);
+    while (!stream.Eof())
     {
         parser.ParseBlock(stream);
     }
     m_parsedResult.AppendParseResult(parser.GetParsedResult());
 }
 
-std::string MarkDownParser::EscapeText()
+// escapes html characters, and finds whether there is any markdown syntax to parse, in one pass over the text
+void MarkDownParser::EscapeText()
 {
-    std::string escaped;
-    unsigned int nonEscapedCounts = 0;
+    m_escapedText.reserve(m_text.length());
+    bool hasMarkDownChars = false;
 
-    for (std::string::size_type i = 0; i < m_text.length(); i++)
+    const char* text = m_text.data();
+    const char* const end = text + m_text.length();
+    while (text != end)
     {
-        switch (m_text.at(i))
+        const char* const special = FindSpecialChar(text, end);
+        m_escapedText.append(text, special);
+        if (special == end)
+        {
+            break;
+        }
+
+        switch (*special)
         {
         case '<':
-            escaped += "&lt;";
+            m_escapedText += "&lt;";
+            m_isEscaped = true;
             break;
         case '>':
-            escaped += "&gt;";
+            m_escapedText += "&gt;";
+            m_isEscaped = true;
             break;
         case '"':
-            escaped += "&quot;";
+            m_escapedText += "&quot;";
+            m_isEscaped = true;
             break;
         case '&':
-            escaped += "&amp;";
+            m_escapedText += "&amp;";
+            m_isEscaped = true;
             break;
         default:
-            escaped += m_text.at(i);
-            nonEscapedCounts++;
+            m_escapedText += *special;
+            hasMarkDownChars = true;
             break;
         }
+        text = special + 1;
     }
 
-    m_isEscaped = (nonEscapedCounts != m_text.length());
-
-    return escaped;
+    // list markers only start blocks, and with no new lines the only block starts with the text
+    const char first = m_text.front();
+    m_isPlainText = !hasMarkDownChars && first != '-' && first != '+' && !(first >= '0' && first <= '9');
 }
@@ -14,9 +14,14 @@ class MarkDownParser
 {
 public:
     MarkDownParser(const std::string& txt);
+    MarkDownParser(const MarkDownParser&) = delete;
+    MarkDownParser& operator=(const MarkDownParser&) = delete;
 
     std::string TransformToHtml();
 
+    // transforms string to runs of formatted text, the same the html of TransformToHtml() describes
+    MarkDownRuns TransformToRuns();
+
     std::string GetRawText() const;
 
     bool HasHtmlTags();
@@ -24,11 +29,17 @@ public:
     bool IsEscaped() const;
 
 private:
+    void Parse();
     void ParseBlock();
-    std::string EscapeText();
+    void EscapeText();
     std::string m_text;
+    std::string m_escapedText;
+    MarkDownTokenStore m_tokenStore;
     MarkDownParsedResult m_parsedResult;
     bool m_hasHTMLTag;
     bool m_isEscaped;
+    bool m_isParsed;
+    // the text has no markdown syntax, so it isn't parsed
+    bool m_isPlainText;
 };
 } // namespace AdaptiveCards
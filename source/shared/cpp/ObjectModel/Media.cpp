@@ -63,10 +63,11 @@ std::vector<std::shared_ptr<MediaSource>>& Media::GetSources()
 
 void Media::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Poster),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AltText),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Sources)});
+    SetKnownProperties(knownProperties);
 }
 
 void Media::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
@@ -57,9 +57,9 @@ void MediaSource::GetResourceInformation(std::vector<RemoteResourceInformation>&
     return;
 }
 
-std::shared_ptr<MediaSource> MediaSourceParser::Deserialize(ParseContext&, const Json::Value& json)
+std::shared_ptr<MediaSource> MediaSourceParser::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<MediaSource> mediaSource = std::make_shared<MediaSource>();
+    std::shared_ptr<MediaSource> mediaSource = context.MakeShared<MediaSource>();
 
     mediaSource->SetMimeType(ParseUtil::GetString(json, AdaptiveCardSchemaKey::MimeType, false));
     mediaSource->SetUrl(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Url, false));
@@ -101,9 +101,10 @@ std::shared_ptr<BaseCardElement> NumberInputParser::DeserializeFromString(ParseC
 
 void NumberInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min)});
+    SetKnownProperties(knownProperties);
 }
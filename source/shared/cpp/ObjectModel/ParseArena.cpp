@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ParseArena.h"
+
+namespace AdaptiveCards
+{
+ParseArena::ParseArena(size_t initialBlockSize) :
+    m_blocks{}, m_current(nullptr), m_remaining(0), m_nextBlockSize(std::max<size_t>(initialBlockSize, 64)),
+    m_allocationCount(0), m_allocatedBytes(0), m_reservedBytes(0)
+{
+}
+
+void* ParseArena::Allocate(size_t bytes, size_t alignment)
+{
+    // make room for the worst-case alignment padding up front so a fresh block is always big enough
+    if (m_remaining < bytes + alignment)
+    {
+        AddBlock(bytes + alignment);
+    }
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(m_current);
+    const size_t padding = (alignment - (address % alignment)) % alignment;
+
+    unsigned char* result = m_current + padding;
+    m_current += padding + bytes;
+    m_remaining -= padding + bytes;
+
+    ++m_allocationCount;
+    m_allocatedBytes += bytes;
+
+    return result;
+}
+
+void ParseArena::AddBlock(size_t minimumSize)
+{
+    // Blocks double in size so that a card of any size needs only a handful of them
+    const size_t blockSize = std::max(m_nextBlockSize, minimumSize);
+    m_blocks.emplace_back(new unsigned char[blockSize]);
+
+    m_current = m_blocks.back().get();
+    m_remaining = blockSize;
+    m_reservedBytes += blockSize;
+    m_nextBlockSize = blockSize * 2;
+}
+} // namespace AdaptiveCards
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveCards
+{
+// ParseArena is a monotonic allocator for the objects created while parsing a card. Memory is carved out of a
+// small number of large blocks and is never handed back individually -- the blocks are released together when the
+// arena is destroyed. See ParseContext::SetUseArenaAllocation() for how it's wired into parsing.
+//
+// An arena is not thread-safe for allocation; each parse uses its own.
+class ParseArena
+{
+public:
+    ParseArena(size_t initialBlockSize = 4096);
+
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment);
+
+    // Number of Allocate() calls serviced and the bytes they requested
+    size_t GetAllocationCount() const
+    {
+        return m_allocationCount;
+    }
+    size_t GetAllocatedBytes() const
+    {
+        return m_allocatedBytes;
+    }
+
+    // Number of blocks obtained from the heap and their total size
+    size_t GetBlockCount() const
+    {
+        return m_blocks.size();
+    }
+    size_t GetReservedBytes() const
+    {
+        return m_reservedBytes;
+    }
+
+private:
+    void AddBlock(size_t minimumSize);
+
+    std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+    unsigned char* m_current;
+    size_t m_remaining;
+    size_t m_nextBlockSize;
+    size_t m_allocationCount;
+    size_t m_allocatedBytes;
+    size_t m_reservedBytes;
+};
+
+// Standard allocator over a ParseArena, for use with std::allocate_shared. Every copy of the allocator (including
+// the one std::shared_ptr keeps in its control block) holds a reference on the arena, so the arena outlives every
+// object placed in it no matter who ends up holding on to them.
+template <typename T>
+class ParseArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ParseArenaAllocator(std::shared_ptr<ParseArena> arena) noexcept : m_arena(std::move(arena)) {}
+
+    template <typename U>
+    ParseArenaAllocator(const ParseArenaAllocator<U>& other) noexcept : m_arena(other.m_arena)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept
+    {
+        // memory is released with the arena
+    }
+
+    template <typename U>
+    bool operator==(const ParseArenaAllocator<U>& other) const noexcept
+    {
+        return m_arena == other.m_arena;
+    }
+    template <typename U>
+    bool operator!=(const ParseArenaAllocator<U>& other) const noexcept
+    {
+        return m_arena != other.m_arena;
+    }
+
+private:
+    template <typename U>
+    friend class ParseArenaAllocator;
+
+    std::shared_ptr<ParseArena> m_arena;
+};
+} // namespace AdaptiveCards
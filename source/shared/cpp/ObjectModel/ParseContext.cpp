@@ -8,16 +8,31 @@
 
 namespace AdaptiveCards
 {
+// What a sibling parsed by ParseSiblingsInParallel() leaves behind for MergeSibling()
+struct ParseContext::SiblingParseResult
+{
+    std::vector<std::optional<std::tuple<std::string, AdaptiveCards::InternalId, bool>>> idEvents;
+    std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings;
+    std::shared_ptr<ParseStatistics> statistics;
+    std::exception_ptr error;
+    // The fork the sibling was parsed on, kept if parsing it changed the state later siblings are parsed with (an
+    // Action.ShowCard's card sets the language and pushes its style, for one)
+    std::unique_ptr<ParseContext> changedContext;
+};
+
 ParseContext::ParseContext() :
     elementParserRegistration{std::make_shared<ElementParserRegistration>()},
     actionParserRegistration{std::make_shared<ActionParserRegistration>()}, warnings{}, m_elementIds{}, m_idStack{},
-    m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{}, m_canFallbackToAncestor(false)
+    m_deferIdValidation(false), m_deferredIdEvents{}, m_parentalContainerStyles{}, m_parentalPadding{},
+    m_parentalBleedDirection{}, m_canFallbackToAncestor(false), m_useArenaAllocation(false), m_parallelParseThreshold(0),
+    m_useLazyParsing(false), m_deserializeDepth(0)
 {
 }
 
 ParseContext::ParseContext(std::shared_ptr<ElementParserRegistration> elementRegistration, std::shared_ptr<ActionParserRegistration> actionRegistration) :
-    warnings{}, m_elementIds{}, m_idStack{}, m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{},
-    m_canFallbackToAncestor(false)
+    warnings{}, m_elementIds{}, m_idStack{}, m_deferIdValidation(false), m_deferredIdEvents{},
+    m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{}, m_canFallbackToAncestor(false),
+    m_useArenaAllocation(false), m_parallelParseThreshold(0), m_useLazyParsing(false), m_deserializeDepth(0)
 {
     elementParserRegistration = (elementRegistration) ? elementRegistration : std::make_shared<ElementParserRegistration>();
     actionParserRegistration = (actionRegistration) ? actionRegistration : std::make_shared<ActionParserRegistration>();
@@ -152,12 +167,29 @@ void ParseContext::PushElement(const std::string& idJsonProperty, const Adaptive
             ErrorStatusCode::InvalidPropertyValue, "Attemping to push an element on to the stack with an invalid ID");
     }
 
+    if (m_deferIdValidation)
+    {
+        m_deferredIdEvents.emplace_back(std::make_tuple(idJsonProperty, internalId, isFallback));
+        return;
+    }
+
     m_idStack.push_back({idJsonProperty, internalId, isFallback});
+
+    if (m_statistics)
+    {
+        m_statistics->maxDepth = std::max(m_statistics->maxDepth, m_idStack.size());
+    }
 }
 
 // Pop the last id off our stack and perform validation (see comment above)
 void ParseContext::PopElement()
 {
+    if (m_deferIdValidation)
+    {
+        m_deferredIdEvents.emplace_back(std::nullopt);
+        return;
+    }
+
     // about to pop an element off the stack. perform collision list maintenance and detection.
     const auto& idsToPop = m_idStack.back();
     const std::string& elementId{std::get<TupleIndex::Id>(idsToPop)};
@@ -198,6 +230,10 @@ void ParseContext::PopElement()
             catch (const std::out_of_range&)
             {
                 // we're looking at a toplevel element
+                if (m_statistics)
+                {
+                    ++m_statistics->exceptionsCaught;
+                }
             }
 
             // if the element we're inspecting is fallback content, continue on to the next entry
@@ -325,6 +361,316 @@ void ParseContext::PopBleedDirection()
     m_parentalBleedDirection.pop_back();
 }
 
+bool ParseContext::GetUseArenaAllocation() const
+{
+    return m_useArenaAllocation;
+}
+
+void ParseContext::SetUseArenaAllocation(const bool value)
+{
+    m_useArenaAllocation = value;
+}
+
+std::shared_ptr<ParseArena> ParseContext::GetArena() const
+{
+    return m_arena;
+}
+
+size_t ParseContext::GetParallelParseThreshold() const
+{
+    return m_parallelParseThreshold;
+}
+
+void ParseContext::SetParallelParseThreshold(const size_t value)
+{
+    m_parallelParseThreshold = value;
+}
+
+bool ParseContext::ShouldParseInParallel(const size_t elementCount) const
+{
+    // With a single hardware thread the forks, id recording, and replay would only add to the cost of a serial parse
+    static const bool c_hasConcurrency = std::thread::hardware_concurrency() > 1;
+    return c_hasConcurrency && m_parallelParseThreshold != 0 && elementCount > 1 && elementCount >= m_parallelParseThreshold;
+}
+
+bool ParseContext::GetUseLazyParsing() const
+{
+    return m_useLazyParsing;
+}
+
+void ParseContext::SetUseLazyParsing(const bool value)
+{
+    m_useLazyParsing = value;
+}
+
+bool ParseContext::GetCollectStatistics() const
+{
+    return m_statistics != nullptr;
+}
+
+void ParseContext::SetCollectStatistics(const bool value)
+{
+    if (!value)
+    {
+        m_statistics.reset();
+    }
+    else if (!m_statistics)
+    {
+        m_statistics = std::make_shared<ParseStatistics>();
+    }
+}
+
+void ParseContext::SetAllocationCounter(ParseStatistics::AllocationCounter counter)
+{
+    m_allocationCounter = std::move(counter);
+}
+
+ParseContext::DeserializeScope::DeserializeScope(ParseContext& context) :
+    m_context(context), m_isOutermost(context.m_deserializeDepth == 0), m_startAllocations{}, m_startWarnings(0)
+{
+    ++m_context.m_deserializeDepth;
+    if (!m_isOutermost)
+    {
+        return;
+    }
+
+    if (m_context.m_useArenaAllocation)
+    {
+        m_context.m_arena = std::make_shared<ParseArena>();
+    }
+
+    if (m_context.m_statistics)
+    {
+        m_context.m_statistics = std::make_shared<ParseStatistics>();
+        m_threadBinding.emplace(m_context.m_statistics.get());
+        m_startWarnings = m_context.warnings.size();
+        if (m_context.m_allocationCounter)
+        {
+            m_startAllocations = m_context.m_allocationCounter();
+        }
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+ParseContext::DeserializeScope::~DeserializeScope()
+{
+    --m_context.m_deserializeDepth;
+    if (!m_isOutermost)
+    {
+        return;
+    }
+
+    // the ParseResult, if there is one, holds the arena from here on
+    m_context.m_arena.reset();
+
+    if (m_context.m_statistics)
+    {
+        ParseStatistics& statistics = *m_context.m_statistics;
+        statistics.totalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+        statistics.buildTime = statistics.totalTime - statistics.jsonParseTime;
+        statistics.warnings = m_context.warnings.size() - std::min(m_startWarnings, m_context.warnings.size());
+        if (m_context.m_allocationCounter)
+        {
+            const auto allocations = m_context.m_allocationCounter();
+            statistics.allocations = allocations.allocations - m_startAllocations.allocations;
+            statistics.allocatedBytes = allocations.bytes - m_startAllocations.bytes;
+        }
+    }
+}
+
+// Parsing siblings concurrently
+//
+// Everything a parser reads from the context is either shared read-only (the registrations) or a stack describing
+// the element's ancestors (styles, padding, bleed). Each thread therefore parses on a fork of this context that
+// starts with copies of those stacks. The one thing that can't be decided locally is id collision detection, which
+// depends on every id seen earlier in the card. Forks record their id pushes and pops instead of acting on them, and
+// once all siblings are parsed we replay the recordings here, in document order. Since our own id stack at that point
+// is the one the siblings would have been parsed under, the replay sees exactly the state a serial parse would have.
+//
+// Errors are handled the same way: a sibling that throws keeps whatever it recorded before throwing, and is merged
+// in order like the rest. The first error a serial parse would have hit -- a collision found during replay, or the
+// exception of the earliest failing sibling -- is the one we throw.
+//
+// A sibling can also leave the state behind it changed (the card of an Action.ShowCard sets the language and pushes
+// its style without undoing either), which a serial parse would carry into every later sibling. The forks can't know
+// about that, so once the merge reaches such a sibling we take on the state it left and parse the rest of the
+// siblings again, serially, here.
+void ParseContext::ParseSiblingsInParallel(const size_t count, const std::function<void(ParseContext&, size_t)>& parseSibling)
+{
+    std::vector<SiblingParseResult> siblings(count);
+    std::atomic<size_t> nextIndex{0};
+    // serial parsing never gets past the first failure, so once we know about one there's no point going further
+    std::atomic<size_t> firstFailedIndex{count};
+
+    // Threads take the next unparsed sibling whenever they finish one, so a few large siblings don't hold up the rest
+    const auto parseSiblings = [&]() {
+        std::unique_ptr<ParseContext> siblingContext;
+        for (size_t index = nextIndex++; index < count && index < firstFailedIndex; index = nextIndex++)
+        {
+            SiblingParseResult& sibling = siblings[index];
+            try
+            {
+                if (!siblingContext)
+                {
+                    siblingContext = ForkForSibling();
+                }
+                const ParseStatistics::ThreadBinding statisticsBinding(siblingContext->GetStatistics());
+                parseSibling(*siblingContext, index);
+                if (!siblingContext->HasSameParseStateAs(*this))
+                {
+                    sibling.changedContext = std::move(siblingContext);
+                }
+            }
+            catch (...)
+            {
+                sibling.error = std::current_exception();
+
+                size_t failedIndex = firstFailedIndex;
+                while (index < failedIndex && !firstFailedIndex.compare_exchange_weak(failedIndex, index))
+                {
+                }
+            }
+
+            ParseContext* const parsedOn = sibling.changedContext ? sibling.changedContext.get() : siblingContext.get();
+            if (parsedOn)
+            {
+                sibling.idEvents.swap(parsedOn->m_deferredIdEvents);
+                sibling.warnings.swap(parsedOn->warnings);
+                if (parsedOn->m_statistics)
+                {
+                    sibling.statistics.swap(parsedOn->m_statistics);
+                    parsedOn->m_statistics = std::make_shared<ParseStatistics>();
+                }
+            }
+
+            if (sibling.error)
+            {
+                // the failed parse may have left the context's stacks mid-element
+                siblingContext.reset();
+            }
+        }
+    };
+
+    const size_t threadCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), count);
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        try
+        {
+            workers.emplace_back(parseSiblings);
+        }
+        catch (const std::system_error&)
+        {
+            // couldn't start another thread; the ones we have will get through the rest of the siblings
+            break;
+        }
+    }
+
+    parseSiblings();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        MergeSibling(siblings[index]);
+        if (siblings[index].changedContext)
+        {
+            TakeParseState(*siblings[index].changedContext);
+            for (++index; index < count; ++index)
+            {
+                parseSibling(*this, index);
+            }
+        }
+    }
+}
+
+std::unique_ptr<ParseContext> ParseContext::ForkForSibling() const
+{
+    auto fork = std::make_unique<ParseContext>(elementParserRegistration, actionParserRegistration);
+    fork->m_deferIdValidation = true;
+    fork->m_parentalContainerStyles = m_parentalContainerStyles;
+    fork->m_parentalPadding = m_parentalPadding;
+    fork->m_parentalBleedDirection = m_parentalBleedDirection;
+    fork->m_canFallbackToAncestor = m_canFallbackToAncestor;
+    fork->m_language = m_language;
+    fork->m_useLazyParsing = m_useLazyParsing;
+
+    // Arenas can't be shared between threads, so each fork gets its own. Objects keep the arena they were placed in
+    // alive, so the card graph stays valid no matter which arena its pieces came from.
+    fork->m_useArenaAllocation = m_useArenaAllocation;
+    if (m_arena)
+    {
+        fork->m_arena = std::make_shared<ParseArena>();
+    }
+    fork->SetCollectStatistics(GetCollectStatistics());
+    return fork;
+}
+
+// Whether parsers would see the same ancestors, language, and fallback state on both contexts
+bool ParseContext::HasSameParseStateAs(const ParseContext& other) const
+{
+    return m_parentalContainerStyles == other.m_parentalContainerStyles && m_parentalPadding == other.m_parentalPadding &&
+           m_parentalBleedDirection == other.m_parentalBleedDirection &&
+           m_canFallbackToAncestor == other.m_canFallbackToAncestor && m_language == other.m_language;
+}
+
+void ParseContext::TakeParseState(const ParseContext& other)
+{
+    m_parentalContainerStyles = other.m_parentalContainerStyles;
+    m_parentalPadding = other.m_parentalPadding;
+    m_parentalBleedDirection = other.m_parentalBleedDirection;
+    m_canFallbackToAncestor = other.m_canFallbackToAncestor;
+    m_language = other.m_language;
+}
+
+// A context for parsing a deferred subtree (see DeferredParse) as this one would have parsed it. The subtree's ids
+// were checked against the rest of the card when it was deferred, so the fork only needs to track the subtree's own.
+// It doesn't share our arena, since the subtree may be parsed on any thread.
+std::unique_ptr<ParseContext> ParseContext::ForkForDeferredParse() const
+{
+    auto fork = std::make_unique<ParseContext>(elementParserRegistration, actionParserRegistration);
+    fork->m_parentalContainerStyles = m_parentalContainerStyles;
+    fork->m_parentalPadding = m_parentalPadding;
+    fork->m_parentalBleedDirection = m_parentalBleedDirection;
+    fork->m_canFallbackToAncestor = m_canFallbackToAncestor;
+    fork->m_language = m_language;
+    fork->m_parallelParseThreshold = m_parallelParseThreshold;
+    fork->m_useLazyParsing = m_useLazyParsing;
+    return fork;
+}
+
+void ParseContext::MergeSibling(SiblingParseResult& sibling)
+{
+    for (const auto& idEvent : sibling.idEvents)
+    {
+        if (idEvent.has_value())
+        {
+            PushElement(std::get<TupleIndex::Id>(*idEvent), std::get<TupleIndex::InternalId>(*idEvent), std::get<TupleIndex::IsFallback>(*idEvent));
+        }
+        else
+        {
+            PopElement();
+        }
+    }
+
+    std::move(sibling.warnings.begin(), sibling.warnings.end(), std::back_inserter(warnings));
+
+    if (sibling.statistics && m_statistics)
+    {
+        m_statistics->Merge(*sibling.statistics);
+    }
+
+    if (sibling.error)
+    {
+        std::rethrow_exception(sibling.error);
+    }
+}
+
 void ParseContext::SetLanguage(const std::string& value)
 {
     m_language = value;
@@ -8,6 +8,8 @@
 #include "ElementParserRegistration.h"
 #include "ActionParserRegistration.h"
 #include "AdaptiveCardParseWarning.h"
+#include "ParseArena.h"
+#include "ParseStatistics.h"
 
 namespace AdaptiveCards
 {
@@ -48,7 +50,108 @@ public:
     void PushBleedDirection(const ContainerBleedDirection direction);
     void PopBleedDirection();
 
+    // When enabled, the card and every element, action, and sub-object created while parsing it are placed in a
+    // single ParseArena instead of being allocated one by one on the heap. Each parse (AdaptiveCard::Deserialize()
+    // and friends) gets an arena of its own, which is handed to the resulting ParseResult and is freed once the last
+    // object placed in it is released. Off by default.
+    bool GetUseArenaAllocation() const;
+    void SetUseArenaAllocation(const bool value);
+    // The arena of the parse in progress, or nullptr outside of a parse or if arena allocation isn't enabled
+    std::shared_ptr<ParseArena> GetArena() const;
+
+    // When the threshold is non-zero, element collections with at least that many members (e.g. a Table's rows or
+    // a long Container) have their members parsed concurrently, each on its own copy of this context. Ids, id
+    // collisions, and warnings are merged back in document order, so the result (or the error) is the same as a
+    // serial parse. A member that changes the context for the members after it (one holding an Action.ShowCard sets
+    // the language and container style of its card) has the members after it parsed again, serially. Collections
+    // nested inside a member that is being parsed concurrently are parsed serially. 0 (the default) disables
+    // parallel parsing, as does a machine with a single hardware thread.
+    size_t GetParallelParseThreshold() const;
+    void SetParallelParseThreshold(const size_t value);
+    bool ShouldParseInParallel(const size_t elementCount) const;
+
+    // Calls parseSibling(context, index) for every index in [0, count) on up to hardware_concurrency() threads, which
+    // are started for the call and joined before it returns (there's no pool kept between calls). Each call gets a
+    // context that looks to the parser exactly like this one at the point of the call. Callers are responsible for
+    // storing each result in its own slot. An index may be parsed twice (see above), in which case the result of the
+    // later call is the one to keep.
+    void ParseSiblingsInParallel(const size_t count, const std::function<void(ParseContext&, size_t)>& parseSibling);
+
+    // When enabled, the cards of Action.ShowCard actions and elements' fallback content are only walked for their
+    // ids while the card is parsed, so id collisions are reported exactly as they would be otherwise. Each is parsed
+    // the first time it's asked for (ShowCardAction::GetCard(), BaseElement::GetFallbackContent()), on a context
+    // that looks like this one did when it was reached. Subtrees containing custom elements or actions are parsed
+    // right away. Off by default.
+    //
+    // Errors other than id collisions in a deferred subtree are thrown by the accessor that parses it (or by
+    // building an ElementIndex, which parses every deferred subtree), and its warnings aren't reported.
+    // Deferred subtrees aren't placed in the arena.
+    //
+    // Which error a card reports can change too: id collisions are found across the whole card before any error in a
+    // deferred subtree, so a card with both (e.g. samples/Templates/Scenarios/ShowCardWizard.template.json, whose
+    // ShowCard cards have an invalid isRequired and repeat the id "${id}") throws IdCollision when parsed lazily and
+    // InvalidPropertyValue when not.
+    bool GetUseLazyParsing() const;
+    void SetUseLazyParsing(const bool value);
+
+    // When enabled, each card parsed with this context (AdaptiveCard::Deserialize() and friends) collects
+    // ParseStatistics, which are returned by ParseResult::GetStatistics(). Every parse starts a new set, so the
+    // results of earlier parses keep theirs. Off by default, in which case nothing is counted or timed.
+    //
+    // Siblings parsed concurrently are counted on their own and added up when they're merged back in.
+    bool GetCollectStatistics() const;
+    void SetCollectStatistics(const bool value);
+    // Counts the heap allocations of each parse while statistics are being collected
+    void SetAllocationCounter(ParseStatistics::AllocationCounter counter);
+    // The statistics of the parse in progress, or nullptr if they aren't being collected
+    ParseStatistics* GetStatistics() const
+    {
+        return m_statistics.get();
+    }
+
+    // Creates an object for the card graph, in the arena if arena allocation is enabled
+    template <typename T, typename... Args> std::shared_ptr<T> MakeShared(Args&&... args)
+    {
+        if (m_arena)
+        {
+            return std::allocate_shared<T>(ParseArenaAllocator<T>(m_arena), std::forward<Args>(args)...);
+        }
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
 private:
+    friend class AdaptiveCard;
+    friend class CardSnapshotReader;
+    friend class DeferredParse;
+
+    // Brackets one of AdaptiveCard's Deserialize methods. The outermost scope on a context starts a new arena and a
+    // new set of statistics, fills in the totals for the parse when it ends, and lets go of the arena once the
+    // ParseResult holds it; nested ones (e.g. for the card of an Action.ShowCard) leave all that to it.
+    class DeserializeScope
+    {
+    public:
+        explicit DeserializeScope(ParseContext& context);
+        ~DeserializeScope();
+
+        DeserializeScope(const DeserializeScope&) = delete;
+        DeserializeScope& operator=(const DeserializeScope&) = delete;
+
+    private:
+        ParseContext& m_context;
+        bool m_isOutermost;
+        std::optional<ParseStatistics::ThreadBinding> m_threadBinding;
+        std::chrono::steady_clock::time_point m_start;
+        ParseStatistics::AllocationCounts m_startAllocations;
+        size_t m_startWarnings;
+    };
+
+    struct SiblingParseResult;
+    std::unique_ptr<ParseContext> ForkForSibling() const;
+    std::unique_ptr<ParseContext> ForkForDeferredParse() const;
+    void MergeSibling(SiblingParseResult& sibling);
+    bool HasSameParseStateAs(const ParseContext& other) const;
+    void TakeParseState(const ParseContext& other);
+
     const AdaptiveCards::InternalId GetNearestFallbackId(const AdaptiveCards::InternalId& skipId) const;
     // This enum is just a helper to keep track of the position of contents within the std::tuple used in
     // m_idStack below. We don't use enum class here because we don't want typed values for use in std::get
@@ -74,11 +177,24 @@ private:
     //                             (ID,  internal ID, isFallback)[]
     std::vector<std::tuple<std::string, AdaptiveCards::InternalId, bool>> m_idStack;
 
+    // A context forked for parsing a sibling concurrently can't check for collisions, since it doesn't know what
+    // its earlier siblings contain. Instead it records every push (the pushed state) and pop (std::nullopt) so that
+    // they can be replayed on the parent in document order.
+    bool m_deferIdValidation;
+    std::vector<std::optional<std::tuple<std::string, AdaptiveCards::InternalId, bool>>> m_deferredIdEvents;
+
     std::vector<ContainerStyle> m_parentalContainerStyles;
     std::vector<AdaptiveCards::InternalId> m_parentalPadding;
     std::vector<ContainerBleedDirection> m_parentalBleedDirection;
 
     bool m_canFallbackToAncestor;
     std::string m_language;
+    bool m_useArenaAllocation;
+    std::shared_ptr<ParseArena> m_arena;
+    size_t m_parallelParseThreshold;
+    bool m_useLazyParsing;
+    std::shared_ptr<ParseStatistics> m_statistics;
+    ParseStatistics::AllocationCounter m_allocationCounter;
+    unsigned int m_deserializeDepth;
 };
 } // namespace AdaptiveCards
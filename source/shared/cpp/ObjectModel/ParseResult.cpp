@@ -2,7 +2,8 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "ParseResult.h"
-#include "ParseResult.h"
+#include "ParseArena.h"
+#include "ParseStatistics.h"
 #include "SharedAdaptiveCard.h"
 
 using namespace AdaptiveCards;
@@ -12,6 +13,21 @@ ParseResult::ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard, std::vector
 {
 }
 
+ParseResult::ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard,
+                         std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings,
+                         std::shared_ptr<ParseArena> arena) :
+    m_adaptiveCard(adaptiveCard), m_warnings(warnings), m_arena(arena)
+{
+}
+
+ParseResult::ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard,
+                         std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings,
+                         std::shared_ptr<ParseArena> arena,
+                         std::shared_ptr<const ParseStatistics> statistics) :
+    m_adaptiveCard(adaptiveCard), m_warnings(warnings), m_arena(arena), m_statistics(statistics)
+{
+}
+
 std::shared_ptr<AdaptiveCard> ParseResult::GetAdaptiveCard() const
 {
     return m_adaptiveCard;
@@ -21,3 +37,13 @@ std::vector<std::shared_ptr<AdaptiveCardParseWarning>> ParseResult::GetWarnings(
 {
     return m_warnings;
 }
+
+std::shared_ptr<ParseArena> ParseResult::GetArena() const
+{
+    return m_arena;
+}
+
+std::shared_ptr<const ParseStatistics> ParseResult::GetStatistics() const
+{
+    return m_statistics;
+}
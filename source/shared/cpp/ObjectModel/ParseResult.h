@@ -8,17 +8,34 @@ namespace AdaptiveCards
 {
 class AdaptiveCard;
 class AdaptiveCardParseWarning;
+class ParseArena;
+struct ParseStatistics;
 
 class ParseResult
 {
 public:
     ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard, std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings);
+    ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard,
+                std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings,
+                std::shared_ptr<ParseArena> arena);
+    ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard,
+                std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings,
+                std::shared_ptr<ParseArena> arena,
+                std::shared_ptr<const ParseStatistics> statistics);
 
     std::shared_ptr<AdaptiveCard> GetAdaptiveCard() const;
     std::vector<std::shared_ptr<AdaptiveCardParseWarning>> GetWarnings() const;
 
+    // The arena the card was allocated in, or nullptr if arena allocation wasn't enabled for the parse
+    std::shared_ptr<ParseArena> GetArena() const;
+
+    // What the parse cost, or nullptr if statistics weren't collected (see ParseContext::SetCollectStatistics())
+    std::shared_ptr<const ParseStatistics> GetStatistics() const;
+
 private:
     std::shared_ptr<AdaptiveCard> m_adaptiveCard;
     std::vector<std::shared_ptr<AdaptiveCardParseWarning>> m_warnings;
+    std::shared_ptr<ParseArena> m_arena;
+    std::shared_ptr<const ParseStatistics> m_statistics;
 };
 } // namespace AdaptiveCards
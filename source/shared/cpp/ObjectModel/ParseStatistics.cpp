@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ParseStatistics.h"
+
+namespace
+{
+thread_local AdaptiveCards::ParseStatistics* t_statistics = nullptr;
+}
+
+namespace AdaptiveCards
+{
+void ParseStatistics::CountElement(const std::string& type)
+{
+    ++elementsByType[type];
+    ++elements;
+}
+
+void ParseStatistics::CountAction(const std::string& type)
+{
+    ++actionsByType[type];
+    ++actions;
+}
+
+void ParseStatistics::Merge(const ParseStatistics& other)
+{
+    for (const auto& [type, count] : other.elementsByType)
+    {
+        elementsByType[type] += count;
+    }
+    for (const auto& [type, count] : other.actionsByType)
+    {
+        actionsByType[type] += count;
+    }
+    elements += other.elements;
+    actions += other.actions;
+    jsonValueCopies += other.jsonValueCopies;
+    exceptionsCaught += other.exceptionsCaught;
+    warnings += other.warnings;
+    maxDepth = std::max(maxDepth, other.maxDepth);
+    allocations += other.allocations;
+    allocatedBytes += other.allocatedBytes;
+    jsonParseTime += other.jsonParseTime;
+    buildTime += other.buildTime;
+    totalTime += other.totalTime;
+}
+
+void ParseStatistics::CountCaughtException() noexcept
+{
+    if (t_statistics)
+    {
+        ++t_statistics->exceptionsCaught;
+    }
+}
+
+ParseStatistics::ThreadBinding::ThreadBinding(ParseStatistics* statistics) noexcept : m_previous(t_statistics)
+{
+    t_statistics = statistics;
+}
+
+ParseStatistics::ThreadBinding::~ThreadBinding()
+{
+    t_statistics = m_previous;
+}
+
+ParseStatistics::PhaseTimer::PhaseTimer(ParseStatistics* statistics, std::chrono::nanoseconds ParseStatistics::*phase) noexcept :
+    m_statistics(statistics), m_phase(phase)
+{
+    if (m_statistics)
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+ParseStatistics::PhaseTimer::~PhaseTimer()
+{
+    if (m_statistics)
+    {
+        m_statistics->*m_phase += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+    }
+}
+} // namespace AdaptiveCards
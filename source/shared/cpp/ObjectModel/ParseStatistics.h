@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include <chrono>
+
+namespace AdaptiveCards
+{
+// What one parse cost, collected when ParseContext::SetCollectStatistics() is enabled and returned by
+// ParseResult::GetStatistics(). Counts cover the whole card, including the cards of Action.ShowCard actions and
+// fallback content, but not deferred subtrees parsed later on (see ParseContext::SetUseLazyParsing()).
+struct ParseStatistics
+{
+    struct AllocationCounts
+    {
+        size_t allocations;
+        size_t bytes;
+    };
+
+    // Reports how many heap allocations have been made so far (e.g. by a replacement operator new). The parse's
+    // allocations are the difference between what it reports before and after, so a process-wide counter includes
+    // whatever other threads allocate in the meantime.
+    using AllocationCounter = std::function<AllocationCounts()>;
+
+    // element and action type name (as given in the card) -> how many were created, fallback content included
+    std::unordered_map<std::string, size_t> elementsByType;
+    std::unordered_map<std::string, size_t> actionsByType;
+    size_t elements{};
+    size_t actions{};
+
+    // copies of parts of the card's json kept by the object model (unknown properties, action data)
+    size_t jsonValueCopies{};
+    // exceptions that were thrown and handled while parsing (an exception that fails the parse isn't reported)
+    size_t exceptionsCaught{};
+    size_t warnings{};
+    // the deepest nesting of elements and actions, counting the card's own body and actions as 1
+    size_t maxDepth{};
+
+    // 0 unless the context was given an AllocationCounter
+    size_t allocations{};
+    size_t allocatedBytes{};
+
+    // reading the card's text into json (just the top-level properties for DeserializeFromStringStreaming)
+    std::chrono::nanoseconds jsonParseTime{};
+    // building the object model from the json
+    std::chrono::nanoseconds buildTime{};
+    std::chrono::nanoseconds totalTime{};
+
+    void CountElement(const std::string& type);
+    void CountAction(const std::string& type);
+    // Adds the counts of part of the same parse (e.g. siblings parsed concurrently)
+    void Merge(const ParseStatistics& other);
+
+    // For helpers that aren't handed the ParseContext. Counts against the statistics bound to the calling thread,
+    // if any.
+    static void CountCaughtException() noexcept;
+
+    // Binds statistics to the calling thread for its lifetime (nullptr binds none)
+    class ThreadBinding
+    {
+    public:
+        explicit ThreadBinding(ParseStatistics* statistics) noexcept;
+        ~ThreadBinding();
+
+        ThreadBinding(const ThreadBinding&) = delete;
+        ThreadBinding& operator=(const ThreadBinding&) = delete;
+
+    private:
+        ParseStatistics* m_previous;
+    };
+
+    // Adds the time until it goes out of scope to the given phase (nothing if statistics is nullptr)
+    class PhaseTimer
+    {
+    public:
+        PhaseTimer(ParseStatistics* statistics, std::chrono::nanoseconds ParseStatistics::*phase) noexcept;
+        ~PhaseTimer();
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        ParseStatistics* m_statistics;
+        std::chrono::nanoseconds ParseStatistics::*m_phase;
+        std::chrono::steady_clock::time_point m_start;
+    };
+};
+} // namespace AdaptiveCards
@@ -8,16 +8,261 @@
 #include "TextBlock.h"
 #include "Container.h"
 #include "ShowCardAction.h"
-
+#include <cmath>
+#include <cstdio>
+
+// JSON writer
+//
+// We used to serialize with a Json::StreamWriter configured for compact output ("indentation": "", "commentStyle":
+// "None") into a std::ostringstream, creating both for every call. The functions below produce exactly the same
+// bytes, directly into a string. Each one mirrors the corresponding piece of jsoncpp 1.8.4's BuiltStyledStreamWriter
+// (see jsoncpp.cpp), quirks included, since renderers and tests compare serialized cards as strings.
 namespace
 {
-Json::StreamWriterBuilder CreateJsonStreamWriter()
+void AppendUnsigned(Json::LargestUInt value, std::string& output)
+{
+    char buffer[24];
+    char* const end = buffer + sizeof(buffer);
+    char* current = end;
+    do
+    {
+        *--current = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    } while (value != 0);
+    output.append(current, end);
+}
+
+void AppendInteger(Json::LargestInt value, std::string& output)
+{
+    if (value < 0)
+    {
+        output.push_back('-');
+        AppendUnsigned(Json::LargestUInt{0} - static_cast<Json::LargestUInt>(value), output);
+    }
+    else
+    {
+        AppendUnsigned(static_cast<Json::LargestUInt>(value), output);
+    }
+}
+
+void AppendDouble(double value, std::string& output)
+{
+    if (!std::isfinite(value))
+    {
+        output.append(std::isnan(value) ? "null" : (value < 0) ? "-1e+9999" : "1e+9999");
+        return;
+    }
+
+    char buffer[36];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    std::replace(buffer, buffer + length, ',', '.'); // in case the locale uses a decimal comma
+    output.append(buffer, length);
+
+    // keep the value recognizable as a double when it's read back
+    if (std::find_if(buffer, buffer + length, [](char c) { return c == '.' || c == 'e'; }) == buffer + length)
+    {
+        output.append(".0");
+    }
+}
+
+// Same decoding (and same handling of malformed input) as jsoncpp's utf8ToCodepoint
+unsigned int DecodeUtf8(const char*& current, const char* end)
+{
+    constexpr unsigned int replacementCharacter = 0xFFFD;
+    const unsigned int firstByte = static_cast<unsigned char>(*current);
+
+    if (firstByte < 0x80)
+    {
+        return firstByte;
+    }
+
+    if (firstByte < 0xE0)
+    {
+        if (end - current < 2)
+        {
+            return replacementCharacter;
+        }
+        const unsigned int codepoint = ((firstByte & 0x1F) << 6) | (static_cast<unsigned int>(current[1]) & 0x3F);
+        current += 1;
+        return (codepoint < 0x80) ? replacementCharacter : codepoint;
+    }
+
+    if (firstByte < 0xF0)
+    {
+        if (end - current < 3)
+        {
+            return replacementCharacter;
+        }
+        const unsigned int codepoint = ((firstByte & 0x0F) << 12) | ((static_cast<unsigned int>(current[1]) & 0x3F) << 6) |
+                                       (static_cast<unsigned int>(current[2]) & 0x3F);
+        current += 2;
+        if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+        {
+            return replacementCharacter;
+        }
+        return (codepoint < 0x800) ? replacementCharacter : codepoint;
+    }
+
+    if (firstByte < 0xF8)
+    {
+        if (end - current < 4)
+        {
+            return replacementCharacter;
+        }
+        const unsigned int codepoint = ((firstByte & 0x07) << 24) | ((static_cast<unsigned int>(current[1]) & 0x3F) << 12) |
+                                       ((static_cast<unsigned int>(current[2]) & 0x3F) << 6) |
+                                       (static_cast<unsigned int>(current[3]) & 0x3F);
+        current += 3;
+        return (codepoint < 0x10000) ? replacementCharacter : codepoint;
+    }
+
+    return replacementCharacter;
+}
+
+void AppendUnicodeEscape(unsigned int codeUnit, std::string& output)
+{
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    const char escape[] = {'\\',
+                           'u',
+                           hexDigits[(codeUnit >> 12) & 0xF],
+                           hexDigits[(codeUnit >> 8) & 0xF],
+                           hexDigits[(codeUnit >> 4) & 0xF],
+                           hexDigits[codeUnit & 0xF]};
+    output.append(escape, sizeof(escape));
+}
+
+void AppendQuotedString(const char* begin, const char* end, std::string& output)
 {
-    Json::StreamWriterBuilder builder;
-    builder["commentStyle"] = "None";
-    builder["indentation"] = "";
+    output.push_back('"');
+
+    // jsoncpp only writes a string verbatim if this finds nothing to escape. Since it tests every ASCII character
+    // (and, where char is signed, every other character too) that only happens for empty strings, or for strings
+    // with no ASCII at all where char is unsigned.
+    if (std::none_of(begin, end, [](char c) {
+            return c == '\\' || c == '"' || c < ' ' || static_cast<unsigned char>(c) < 0x80;
+        }))
+    {
+        output.append(begin, end);
+        output.push_back('"');
+        return;
+    }
 
-    return builder;
+    for (const char* current = begin; current != end; ++current)
+    {
+        switch (*current)
+        {
+        case '"':
+            output.append("\\\"");
+            break;
+        case '\\':
+            output.append("\\\\");
+            break;
+        case '\b':
+            output.append("\\b");
+            break;
+        case '\f':
+            output.append("\\f");
+            break;
+        case '\n':
+            output.append("\\n");
+            break;
+        case '\r':
+            output.append("\\r");
+            break;
+        case '\t':
+            output.append("\\t");
+            break;
+        default:
+        {
+            // everything outside of printable ASCII is written as \u escapes (surrogate pairs outside the BMP)
+            unsigned int codepoint = DecodeUtf8(current, end);
+            if (codepoint < 0x80 && codepoint >= 0x20)
+            {
+                output.push_back(static_cast<char>(codepoint));
+            }
+            else if (codepoint < 0x10000)
+            {
+                AppendUnicodeEscape(codepoint, output);
+            }
+            else
+            {
+                codepoint -= 0x10000;
+                AppendUnicodeEscape((codepoint >> 10) + 0xD800, output);
+                AppendUnicodeEscape((codepoint & 0x3FF) + 0xDC00, output);
+            }
+            break;
+        }
+        }
+    }
+
+    output.push_back('"');
+}
+
+void AppendJsonValue(const Json::Value& json, std::string& output)
+{
+    switch (json.type())
+    {
+    case Json::nullValue:
+        output.append("null");
+        break;
+    case Json::intValue:
+        AppendInteger(json.asLargestInt(), output);
+        break;
+    case Json::uintValue:
+        AppendUnsigned(json.asLargestUInt(), output);
+        break;
+    case Json::realValue:
+        AppendDouble(json.asDouble(), output);
+        break;
+    case Json::stringValue:
+    {
+        const char* begin;
+        const char* end;
+        if (json.getString(&begin, &end))
+        {
+            AppendQuotedString(begin, end, output);
+        }
+        break;
+    }
+    case Json::booleanValue:
+        output.append(json.asBool() ? "true" : "false");
+        break;
+    case Json::arrayValue:
+    {
+        output.push_back('[');
+        const Json::ArrayIndex size = json.size();
+        for (Json::ArrayIndex index = 0; index < size; ++index)
+        {
+            if (index != 0)
+            {
+                output.push_back(',');
+            }
+            AppendJsonValue(json[index], output);
+        }
+        output.push_back(']');
+        break;
+    }
+    case Json::objectValue:
+    {
+        // members are stored (and so iterated) in the same order the StreamWriter writes them in
+        output.push_back('{');
+        for (auto member = json.begin(); member != json.end(); ++member)
+        {
+            if (member != json.begin())
+            {
+                output.push_back(',');
+            }
+
+            const char* nameEnd;
+            const char* name = member.memberName(&nameEnd);
+            AppendQuotedString(name, nameEnd, output);
+            output.push_back(':');
+            AppendJsonValue(*member, output);
+        }
+        output.push_back('}');
+        break;
+    }
+    }
 }
 } // namespace
 
@@ -25,13 +270,16 @@ namespace AdaptiveCards
 {
 std::string ParseUtil::JsonToString(const Json::Value& json)
 {
-    const thread_local Json::StreamWriterBuilder builder = ::CreateJsonStreamWriter();
-    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+    std::string output;
+    JsonToString(json, output);
+    return output;
+}
 
-    std::ostringstream outStream;
-    writer->write(json, &outStream);
-    outStream << std::endl;
-    return outStream.str();
+void ParseUtil::JsonToString(const Json::Value& json, std::string& output)
+{
+    output.clear();
+    AppendJsonValue(json, output);
+    output.push_back('\n');
 }
 
 void ParseUtil::ThrowIfNotJsonObject(const Json::Value& json)
@@ -46,7 +294,8 @@ std::string ParseUtil::GetTypeAsString(const Json::Value& json)
 {
     const char typeKey[] = "type";
 
-    if (!json.isMember(typeKey))
+    const Json::Value* typeValue = json.find(std::begin(typeKey), std::end(typeKey) - 1);
+    if (typeValue == nullptr)
     {
         std::stringstream ss;
 
@@ -56,7 +305,7 @@ std::string ParseUtil::GetTypeAsString(const Json::Value& json)
         throw AdaptiveCardParseException(ErrorStatusCode::RequiredPropertyMissing, ss.str());
     }
 
-    return json.get(typeKey, Json::Value()).asString();
+    return typeValue->asString();
 }
 
 std::string ParseUtil::TryGetTypeAsString(const Json::Value& json)
@@ -67,6 +316,7 @@ std::string ParseUtil::TryGetTypeAsString(const Json::Value& json)
     }
     catch (const AdaptiveCardParseException&)
     {
+        ParseStatistics::CountCaughtException();
         return "";
     }
 }
@@ -79,6 +329,7 @@ std::string ParseUtil::TryGetString(const Json::Value& json, AdaptiveCardSchemaK
     }
     catch (Json::Exception&)
     {
+        ParseStatistics::CountCaughtException();
         return "";
     }
 }
@@ -87,7 +338,7 @@ std::string ParseUtil::TryGetString(const Json::Value& json, AdaptiveCardSchemaK
 std::string ParseUtil::GetString(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         if (isRequired)
@@ -126,7 +377,7 @@ std::string ParseUtil::GetString(const Json::Value& json, AdaptiveCardSchemaKey
 std::string ParseUtil::GetJsonString(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         if (isRequired)
@@ -147,7 +398,7 @@ std::string ParseUtil::GetJsonString(const Json::Value& json, AdaptiveCardSchema
 std::string ParseUtil::GetValueAsString(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         if (isRequired)
@@ -189,7 +440,7 @@ bool ParseUtil::GetBool(const Json::Value& json, AdaptiveCardSchemaKey key, bool
 std::optional<bool> ParseUtil::GetOptionalBool(const Json::Value& json, AdaptiveCardSchemaKey key)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         return std::nullopt;
@@ -208,7 +459,7 @@ std::optional<bool> ParseUtil::GetOptionalBool(const Json::Value& json, Adaptive
 unsigned int ParseUtil::GetUInt(const Json::Value& json, AdaptiveCardSchemaKey key, unsigned int defaultValue, bool isRequired)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         if (isRequired)
@@ -251,7 +502,7 @@ int ParseUtil::GetInt(const Json::Value& json, AdaptiveCardSchemaKey key, int de
 std::optional<int> ParseUtil::GetOptionalInt(const Json::Value& json, AdaptiveCardSchemaKey key)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         return std::nullopt;
@@ -270,7 +521,7 @@ std::optional<int> ParseUtil::GetOptionalInt(const Json::Value& json, AdaptiveCa
 std::optional<double> ParseUtil::GetOptionalDouble(const Json::Value& json, AdaptiveCardSchemaKey key)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (propertyValue.empty())
     {
         return std::nullopt;
@@ -317,14 +568,13 @@ void ParseUtil::ExpectKeyAndValueType(const Json::Value& json, const char* expec
             ErrorStatusCode::RequiredPropertyMissing, "The JSON element is missing the following key: " + std::string(expectedKey));
     }
 
-    auto value = json.get(expectedKey, Json::Value());
-    throwIfWrongType(value);
+    throwIfWrongType(json[expectedKey]);
 }
 
-Json::Value ParseUtil::GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
+const Json::Value& ParseUtil::GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto elementArray = json.get(propertyName, Json::Value());
+    const Json::Value& elementArray = GetJsonValue(json, key);
 
     if (!elementArray.isNull() && !elementArray.isArray())
     {
@@ -345,7 +595,7 @@ Json::Value ParseUtil::GetArray(const Json::Value& json, AdaptiveCardSchemaKey k
 
 std::vector<std::string> ParseUtil::GetStringArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
-    auto jsonArray = ParseUtil::GetArray(json, key, isRequired);
+    const Json::Value& jsonArray = ParseUtil::GetArray(json, key, isRequired);
     std::vector<std::string> strings;
 
     strings.reserve(jsonArray.size());
@@ -360,12 +610,18 @@ std::vector<std::string> ParseUtil::GetStringArray(const Json::Value& json, Adap
 
 Json::Value ParseUtil::GetJsonValueFromString(const std::string& jsonString)
 {
-    const thread_local Json::CharReaderBuilder readerBuilder;
-    std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+    return GetJsonValueFromBuffer(jsonString.data(), jsonString.data() + jsonString.size());
+}
+
+Json::Value ParseUtil::GetJsonValueFromBuffer(const char* begin, const char* end)
+{
+    // Making a reader takes several allocations, which adds up for callers that parse a card a piece at a time (see
+    // StreamingCardReader). A reader starts over on every parse, so each thread keeps one.
+    const thread_local std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
 
     Json::Value jsonValue;
     std::string errors;
-    if (!reader->parse(jsonString.data(), jsonString.data() + jsonString.size(), &jsonValue, &errors))
+    if (!reader->parse(begin, end, &jsonValue, &errors))
     {
         std::ostringstream exceptionMsg{};
         exceptionMsg << "Expected JSON Object (" << errors << ")";
@@ -375,10 +631,23 @@ Json::Value ParseUtil::GetJsonValueFromString(const std::string& jsonString)
     return jsonValue;
 }
 
-Json::Value ParseUtil::ExtractJsonValue(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
+const Json::Value* ParseUtil::FindJsonValue(const Json::Value& json, AdaptiveCardSchemaKey key)
 {
     const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-    auto propertyValue = json.get(propertyName, Json::Value());
+    return json.find(propertyName.data(), propertyName.data() + propertyName.size());
+}
+
+const Json::Value& ParseUtil::GetJsonValue(const Json::Value& json, AdaptiveCardSchemaKey key)
+{
+    // Json::Value::nullSingleton() is what jsoncpp itself hands out for missing members from const operator[]
+    const Json::Value* propertyValue = FindJsonValue(json, key);
+    return (propertyValue != nullptr) ? *propertyValue : Json::Value::nullSingleton();
+}
+
+const Json::Value& ParseUtil::ExtractJsonValue(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
+{
+    const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
+    const Json::Value& propertyValue = GetJsonValue(json, key);
     if (isRequired && propertyValue.empty())
     {
         throw AdaptiveCardParseException(
@@ -389,12 +658,22 @@ Json::Value ParseUtil::ExtractJsonValue(const Json::Value& json, AdaptiveCardSch
 
 std::string ParseUtil::ToLowercase(std::string const& value)
 {
-    std::string new_value;
-    new_value.resize(value.size());
-    std::transform(value.begin(), value.end(), new_value.begin(), [](char c) { return std::tolower(c, std::locale()); });
+    std::string new_value = value;
+    CaseInsensitive::ToLowerInPlace(new_value);
     return new_value;
 }
 
+std::string_view ParseUtil::GetStringView(const Json::Value& json)
+{
+    const char* begin;
+    const char* end;
+    if (json.isString() && json.getString(&begin, &end))
+    {
+        return std::string_view(begin, end - begin);
+    }
+    return std::string_view();
+}
+
 std::shared_ptr<BaseActionElement> ParseUtil::GetActionFromJsonValue(ParseContext& context, const Json::Value& json)
 {
     if (json.empty() || !json.isObject())
@@ -425,32 +704,17 @@ std::shared_ptr<BaseActionElement> ParseUtil::GetActionFromJsonValue(ParseContex
 std::vector<std::shared_ptr<BaseActionElement>> ParseUtil::GetActionCollection(
     ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
-    auto elementArray = GetArray(json, key, isRequired);
-
-    std::vector<std::shared_ptr<BaseActionElement>> elements;
-
-    if (elementArray.empty())
-    {
-        return elements;
-    }
-
-    elements.reserve(elementArray.size());
-
-    for (const auto& curJsonValue : elementArray)
-    {
-        auto action = ParseUtil::GetActionFromJsonValue(context, curJsonValue);
-        if (action != nullptr)
-        {
-            elements.push_back(action);
-        }
-    }
+    const Json::Value& elementArray = GetArray(json, key, isRequired);
 
-    return elements;
+    return GetActionCollection(
+        context, elementArray.size(), [&elementArray](size_t index) -> const Json::Value& {
+            return elementArray[static_cast<Json::ArrayIndex>(index)];
+        });
 }
 
 std::shared_ptr<BaseActionElement> ParseUtil::GetAction(ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
 {
-    auto selectAction = ParseUtil::ExtractJsonValue(json, key, isRequired);
+    const Json::Value& selectAction = ParseUtil::ExtractJsonValue(json, key, isRequired);
 
     if (!selectAction.empty())
     {
@@ -469,10 +733,10 @@ std::shared_ptr<BaseCardElement> ParseUtil::GetLabelFromJsonValue(ParseContext&
     }
 
     // Get the element's type
-    std::string typeString = ToLowercase(GetTypeAsString(json));
+    const std::string typeString = GetTypeAsString(json);
 
-    if ((typeString != ToLowercase(AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::TextBlock))) &&
-        (typeString != ToLowercase(AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::RichTextBlock))))
+    if (!CaseInsensitive::Equals(typeString, AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::TextBlock)) &&
+        !CaseInsensitive::Equals(typeString, AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::RichTextBlock)))
     {
         throw AdaptiveCardParseException(
             ErrorStatusCode::InvalidPropertyValue, "Element type is not a string, TextBlock or RichTextBlock");
@@ -492,7 +756,7 @@ std::shared_ptr<BaseCardElement> ParseUtil::GetLabelFromJsonValue(ParseContext&
 
 std::shared_ptr<BaseCardElement> ParseUtil::GetLabel(ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key)
 {
-    auto label = ParseUtil::ExtractJsonValue(json, key);
+    const Json::Value& label = ParseUtil::ExtractJsonValue(json, key);
 
     if (!label.empty())
     {
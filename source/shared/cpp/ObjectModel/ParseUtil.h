@@ -19,6 +19,10 @@ namespace ParseUtil
 {
     std::string JsonToString(const Json::Value& json);
 
+    // Same as above, but replaces the contents of output rather than returning a new string. Callers serializing
+    // many values can reuse one buffer and avoid reallocating it each time.
+    void JsonToString(const Json::Value& json, std::string& output);
+
     void ThrowIfNotJsonObject(const Json::Value& json);
 
     std::string GetTypeAsString(const Json::Value& json);
@@ -50,13 +54,21 @@ namespace ParseUtil
 
     std::optional<double> GetOptionalDouble(const Json::Value& json, AdaptiveCardSchemaKey key);
 
-    Json::Value GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
+    // Property lookups below hand out references into json rather than copies, so the result is only valid for as
+    // long as json is. Missing properties resolve to a shared null value.
+    const Json::Value* FindJsonValue(const Json::Value& json, AdaptiveCardSchemaKey key);
+
+    const Json::Value& GetJsonValue(const Json::Value& json, AdaptiveCardSchemaKey key);
+
+    const Json::Value& GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
 
     std::vector<std::string> GetStringArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
 
     Json::Value GetJsonValueFromString(const std::string& jsonString);
 
-    Json::Value ExtractJsonValue(const Json::Value& jsonRoot, AdaptiveCardSchemaKey key, bool isRequired = false);
+    Json::Value GetJsonValueFromBuffer(const char* begin, const char* end);
+
+    const Json::Value& ExtractJsonValue(const Json::Value& jsonRoot, AdaptiveCardSchemaKey key, bool isRequired = false);
 
     template <typename T, typename Fn>
     std::optional<T> GetOptionalEnumValue(const Json::Value& json, AdaptiveCardSchemaKey key, Fn enumConverter);
@@ -90,6 +102,13 @@ namespace ParseUtil
         bool isRequired = false,
         const std::string& impliedType = std::string());
 
+    // Parses elementCount elements, asking getElementJson(index) for the json of each one in turn. This lets
+    // callers that don't hold the whole collection in memory (see StreamingCardReader) share the bleed and implied
+    // type handling used for regular arrays.
+    template <typename T, typename Fn>
+    std::vector<std::shared_ptr<T>> GetElementCollection(
+        bool isTopToBottomContainer, ParseContext& context, size_t elementCount, Fn getElementJson, const std::string& impliedType = std::string());
+
     template <typename T>
     std::vector<std::shared_ptr<T>> GetElementCollectionOfSingleType(
         ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, DeserializeFn<T>& deserializer, bool isRequired = false);
@@ -97,6 +116,9 @@ namespace ParseUtil
     std::vector<std::shared_ptr<BaseActionElement>> GetActionCollection(
         ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
 
+    template <typename Fn>
+    std::vector<std::shared_ptr<BaseActionElement>> GetActionCollection(ParseContext& context, size_t elementCount, Fn getElementJson);
+
     std::shared_ptr<BaseActionElement> GetAction(ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
 
     template <typename T>
@@ -116,6 +138,9 @@ namespace ParseUtil
 
     std::string ToLowercase(const std::string& value);
 
+    // The string without copying it, or an empty view if json isn't a string
+    std::string_view GetStringView(const Json::Value& json);
+
     std::shared_ptr<BaseCardElement> GetLabel(ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key);
 
     std::shared_ptr<BaseCardElement> GetLabelFromJsonValue(ParseContext& context, const Json::Value& json);
@@ -127,8 +152,7 @@ std::optional<T> ParseUtil::GetOptionalEnumValue(const Json::Value& json, Adapti
     std::string propertyValueStr = "";
     try
     {
-        const std::string& propertyName = AdaptiveCardSchemaKeyToString(key);
-        auto const& propertyValue = json.get(propertyName, Json::Value());
+        const Json::Value& propertyValue = GetJsonValue(json, key);
         if (propertyValue.empty())
         {
             return std::nullopt;
@@ -140,11 +164,14 @@ std::optional<T> ParseUtil::GetOptionalEnumValue(const Json::Value& json, Adapti
                 ErrorStatusCode::InvalidPropertyValue, "Enum type was invalid. Expected type string.");
         }
 
+        // enumConverter may return either T (and throw std::out_of_range for unknown values, like the generated
+        // *FromString functions) or std::optional<T> (like *TryFromString, which is what we use internally)
         propertyValueStr = propertyValue.asString();
         return enumConverter(propertyValueStr);
     }
     catch (const std::out_of_range&)
     {
+        ParseStatistics::CountCaughtException();
         return std::nullopt;
     }
 }
@@ -205,7 +232,7 @@ std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollectionOfSingleType(
     const std::function<std::shared_ptr<T>(ParseContext& context, const Json::Value&)>& deserializer,
     bool isRequired)
 {
-    auto elementArray = GetArray(json, key, isRequired);
+    const Json::Value& elementArray = GetArray(json, key, isRequired);
 
     std::vector<std::shared_ptr<T>> elements;
     if (elementArray.empty())
@@ -215,6 +242,24 @@ std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollectionOfSingleType(
 
     elements.reserve(elementArray.size());
 
+    if (context.ShouldParseInParallel(elementArray.size()))
+    {
+        std::vector<std::shared_ptr<T>> parsedElements(elementArray.size());
+        context.ParseSiblingsInParallel(parsedElements.size(), [&](ParseContext& siblingContext, size_t index) {
+            parsedElements[index] = deserializer(siblingContext, elementArray[static_cast<Json::ArrayIndex>(index)]);
+        });
+
+        for (auto& el : parsedElements)
+        {
+            if (el != nullptr)
+            {
+                elements.push_back(std::move(el));
+            }
+        }
+
+        return elements;
+    }
+
     // Deserialize every element in the array
     for (const Json::Value& curJsonValue : elementArray)
     {
@@ -239,7 +284,7 @@ T ParseUtil::ExtractJsonValueAndMergeWithDefault(
     T result = defaultValue;
     try
     {
-        auto jsonObject = ParseUtil::ExtractJsonValue(rootJson, key);
+        const Json::Value& jsonObject = ParseUtil::ExtractJsonValue(rootJson, key);
         if (!jsonObject.empty())
         {
             result = deserializer(jsonObject, defaultValue);
@@ -248,6 +293,7 @@ T ParseUtil::ExtractJsonValueAndMergeWithDefault(
     catch (Json::Exception&)
     {
         // value missing
+        ParseStatistics::CountCaughtException();
     }
 
     return result;
@@ -267,22 +313,34 @@ template <typename T>
 std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollection(
     bool isTopToBottomContainer, ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired, const std::string& impliedType)
 {
-    auto elementArray = GetArray(json, key, isRequired);
+    const Json::Value& elementArray = GetArray(json, key, isRequired);
+
+    return GetElementCollection<T>(
+        isTopToBottomContainer,
+        context,
+        elementArray.size(),
+        [&elementArray](size_t index) -> const Json::Value& { return elementArray[static_cast<Json::ArrayIndex>(index)]; },
+        impliedType);
+}
 
+template <typename T, typename Fn>
+std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollection(
+    bool isTopToBottomContainer, ParseContext& context, size_t elementCount, Fn getElementJson, const std::string& impliedType)
+{
     std::vector<std::shared_ptr<T>> elements;
-    if (elementArray.empty())
+    if (elementCount == 0)
     {
         return elements;
     }
 
-    const size_t elemSize = elementArray.size();
-    elements.reserve(elemSize);
+    elements.reserve(elementCount);
 
     const ContainerBleedDirection previousBleedState = context.GetBleedDirection();
 
-    size_t currentIndex = 0;
-    for (auto& curJsonValue : elementArray)
-    {
+    const auto parseElement = [&](ParseContext& elementContext, size_t currentIndex) {
+        // Either a reference into the caller's array or a value materialized just for this element
+        auto&& curJsonValue = getElementJson(currentIndex);
+
         ContainerBleedDirection currentBleedState = previousBleedState;
 
         if (currentIndex != 0)
@@ -293,7 +351,7 @@ std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollection(
             currentBleedState &= isTopToBottomContainer ? ~ContainerBleedDirection::BleedUp : ~ContainerBleedDirection::BleedLeft;
         }
 
-        if (currentIndex != (elemSize - 1))
+        if (currentIndex != (elementCount - 1))
         {
             // In a top to bottom container (Container, Column) only the last item can bleed down, in a left
             // to right container (ColumnSet) only the last item can bleed right. If we're not the last item,
@@ -301,10 +359,12 @@ std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollection(
             currentBleedState &= isTopToBottomContainer ? ~ContainerBleedDirection::BleedDown : ~ContainerBleedDirection::BleedRight;
         }
 
-        context.PushBleedDirection(currentBleedState);
+        elementContext.PushBleedDirection(currentBleedState);
 
         // If all items in this collection have the same implied type (i.e. Columns), verify
-        // that if set it is set correctly and set it if it isn't
+        // that if set it is set correctly and set it if it isn't. Only elements that omit their type pay for a copy.
+        Json::Value jsonWithImpliedType;
+        const Json::Value* elementJson = &curJsonValue;
         if (!impliedType.empty())
         {
             const std::string typeString = ParseUtil::GetString(curJsonValue, AdaptiveCardSchemaKey::Type, impliedType, false);
@@ -314,17 +374,54 @@ std::vector<std::shared_ptr<T>> ParseUtil::GetElementCollection(
                     ErrorStatusCode::InvalidPropertyValue, "Unable to parse element of type " + typeString);
             }
 
-            curJsonValue[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)] = typeString;
+            if (ParseUtil::GetString(curJsonValue, AdaptiveCardSchemaKey::Type) != typeString)
+            {
+                jsonWithImpliedType = curJsonValue;
+                jsonWithImpliedType[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)] = typeString;
+                elementJson = &jsonWithImpliedType;
+            }
         }
 
         std::shared_ptr<BaseElement> curElement;
-        ParseJsonObject<T>(context, curJsonValue, curElement);
-        elements.push_back(std::static_pointer_cast<T>(curElement));
+        ParseJsonObject<T>(elementContext, *elementJson, curElement);
 
         // restores the parent's bleed state
-        context.PopBleedDirection();
+        elementContext.PopBleedDirection();
+
+        return std::static_pointer_cast<T>(curElement);
+    };
+
+    if (context.ShouldParseInParallel(elementCount))
+    {
+        elements.resize(elementCount);
+        context.ParseSiblingsInParallel(elementCount, [&](ParseContext& siblingContext, size_t index) {
+            elements[index] = parseElement(siblingContext, index);
+        });
+
+        return elements;
+    }
 
-        currentIndex++;
+    for (size_t currentIndex = 0; currentIndex < elementCount; currentIndex++)
+    {
+        elements.push_back(parseElement(context, currentIndex));
+    }
+
+    return elements;
+}
+
+template <typename Fn>
+std::vector<std::shared_ptr<BaseActionElement>> ParseUtil::GetActionCollection(ParseContext& context, size_t elementCount, Fn getElementJson)
+{
+    std::vector<std::shared_ptr<BaseActionElement>> elements;
+    elements.reserve(elementCount);
+
+    for (size_t currentIndex = 0; currentIndex < elementCount; currentIndex++)
+    {
+        auto action = ParseUtil::GetActionFromJsonValue(context, getElementJson(currentIndex));
+        if (action != nullptr)
+        {
+            elements.push_back(action);
+        }
     }
 
     return elements;
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ParsedCardCache.h"
+#include "ParseContext.h"
+#include "ParseResult.h"
+#include "SharedAdaptiveCard.h"
+
+namespace
+{
+// Rough size of a parsed card per byte of its JSON, for cards that weren't parsed into an arena (which measures it)
+constexpr size_t c_estimatedBytesPerJsonByte = 4;
+
+size_t CombineHash(size_t seed, size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+} // namespace
+
+namespace AdaptiveCards
+{
+ParsedCardCache::ParsedCardCache(size_t maxBytes) :
+    m_maxBytes(maxBytes), m_byteCount(0), m_hits(0), m_misses(0), m_evictions(0)
+{
+}
+
+std::shared_ptr<ParseResult> ParsedCardCache::DeserializeFromString(const std::string& jsonString, const std::string& rendererVersion)
+{
+    ParseContext context;
+    return DeserializeFromString(jsonString, rendererVersion, context);
+}
+
+std::shared_ptr<ParseResult> ParsedCardCache::DeserializeFromString(const std::string& jsonString,
+                                                                    const std::string& rendererVersion,
+                                                                    ParseContext& context)
+{
+    // copied, since parsing the card sets the context's language to the card's
+    const std::string language = context.GetLanguage();
+    const size_t parserFingerprint = GetParserFingerprint(context);
+
+    size_t hash = std::hash<std::string>()(jsonString);
+    hash = CombineHash(hash, std::hash<std::string>()(rendererVersion));
+    hash = CombineHash(hash, std::hash<std::string>()(language));
+    hash = CombineHash(hash, parserFingerprint);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto entry = Find(hash, jsonString, rendererVersion, language, parserFingerprint);
+        if (entry != m_entries.end())
+        {
+            ++m_hits;
+            m_entries.splice(m_entries.begin(), m_entries, entry);
+
+            auto result = entry->result;
+            const auto warnings = result->GetWarnings();
+            context.warnings.insert(context.warnings.end(), warnings.begin(), warnings.end());
+
+            // a parse leaves the card's language on the context, if the card has one
+            const std::string& cardLanguage = result->GetAdaptiveCard()->GetLanguage();
+            if (!cardLanguage.empty())
+            {
+                context.SetLanguage(cardLanguage);
+            }
+            return result;
+        }
+        ++m_misses;
+    }
+
+    // Parse without holding the lock so that misses on different cards don't wait on each other
+    const size_t priorWarningCount = context.warnings.size();
+    auto result = AdaptiveCard::DeserializeFromString(jsonString, rendererVersion, context);
+
+    // The result also carries any warnings the context already held, which don't belong to this card
+    if (priorWarningCount != 0)
+    {
+        return result;
+    }
+
+    const auto arena = result->GetArena();
+    const size_t cardBytes = arena ? arena->GetAllocatedBytes() : jsonString.size() * c_estimatedBytesPerJsonByte;
+    const size_t cost = sizeof(Entry) + jsonString.size() + rendererVersion.size() + language.size() + cardBytes;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (cost > m_maxBytes)
+    {
+        return result;
+    }
+
+    // Another thread may have parsed the same card while this one was
+    const auto existing = Find(hash, jsonString, rendererVersion, language, parserFingerprint);
+    if (existing != m_entries.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, existing);
+        return result;
+    }
+
+    // A hit doesn't parse anything, so it mustn't report the statistics of the parse that filled the entry
+    auto cached = result->GetStatistics() ?
+                      std::make_shared<ParseResult>(result->GetAdaptiveCard(), result->GetWarnings(), result->GetArena()) :
+                      result;
+    m_entries.push_front(Entry{hash, jsonString, rendererVersion, language, parserFingerprint, std::move(cached), cost});
+    m_index.emplace(hash, m_entries.begin());
+    m_byteCount += cost;
+    EvictToBudget();
+
+    return result;
+}
+
+void ParsedCardCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.clear();
+    m_entries.clear();
+    m_byteCount = 0;
+}
+
+ParsedCardCache::Statistics ParsedCardCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Statistics{m_hits, m_misses, m_evictions, m_entries.size(), m_byteCount};
+}
+
+size_t ParsedCardCache::GetMaxBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxBytes;
+}
+
+void ParsedCardCache::SetMaxBytes(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = maxBytes;
+    EvictToBudget();
+}
+
+size_t ParsedCardCache::GetParserFingerprint(const ParseContext& context)
+{
+    size_t fingerprint = 0;
+    if (context.elementParserRegistration)
+    {
+        fingerprint = context.elementParserRegistration->GetFingerprint();
+    }
+    if (context.actionParserRegistration)
+    {
+        fingerprint = CombineHash(fingerprint, context.actionParserRegistration->GetFingerprint());
+    }
+    // lazily parsed cards don't report the warnings of their deferred parts
+    return CombineHash(fingerprint, context.GetUseLazyParsing());
+}
+
+bool ParsedCardCache::Matches(const Entry& entry,
+                              size_t hash,
+                              const std::string& jsonString,
+                              const std::string& rendererVersion,
+                              const std::string& language,
+                              size_t parserFingerprint)
+{
+    return entry.hash == hash && entry.parserFingerprint == parserFingerprint && entry.jsonString == jsonString &&
+           entry.rendererVersion == rendererVersion && entry.language == language;
+}
+
+ParsedCardCache::EntryList::iterator ParsedCardCache::Find(
+    size_t hash, const std::string& jsonString, const std::string& rendererVersion, const std::string& language, size_t parserFingerprint)
+{
+    const auto candidates = m_index.equal_range(hash);
+    for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+    {
+        if (Matches(*candidate->second, hash, jsonString, rendererVersion, language, parserFingerprint))
+        {
+            return candidate->second;
+        }
+    }
+    return m_entries.end();
+}
+
+void ParsedCardCache::EvictToBudget()
+{
+    while (m_byteCount > m_maxBytes && !m_entries.empty())
+    {
+        const auto oldest = std::prev(m_entries.end());
+
+        const auto candidates = m_index.equal_range(oldest->hash);
+        for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+        {
+            if (candidate->second == oldest)
+            {
+                m_index.erase(candidate);
+                break;
+            }
+        }
+
+        m_byteCount -= oldest->cost;
+        m_entries.erase(oldest);
+        ++m_evictions;
+    }
+}
+} // namespace AdaptiveCards
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include <list>
+#include <mutex>
+
+namespace AdaptiveCards
+{
+class ParseContext;
+class ParseResult;
+
+// A thread-safe cache of parsed cards, for hosts that see the same card payloads over and over. Entries are keyed
+// by the JSON text itself (looked up by hash, then compared), the renderer version, and the parts of the
+// ParseContext that change what a parse produces: the custom element and action parsers registered, the language,
+// and whether lazy parsing is on. Least recently used entries are evicted once the cache grows past its byte budget.
+//
+// Cached ParseResults are shared between every caller that asks for the same card, possibly on different threads.
+// They must be treated as read-only; copy a card before modifying it.
+class ParsedCardCache
+{
+public:
+    static constexpr size_t DefaultMaxBytes = 64 * 1024 * 1024;
+
+    struct Statistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t entryCount;
+        size_t byteCount;
+    };
+
+    explicit ParsedCardCache(size_t maxBytes = DefaultMaxBytes);
+
+    ParsedCardCache(const ParsedCardCache&) = delete;
+    ParsedCardCache& operator=(const ParsedCardCache&) = delete;
+
+    // Same as AdaptiveCard::DeserializeFromString, except that a card already in the cache isn't parsed again. On a
+    // hit the cached result's warnings are added to the context and the card's language is set on it, just as a parse
+    // would have done, and the result has no statistics (see ParseContext::SetCollectStatistics()), since nothing was parsed. Cards that fail
+    // to parse aren't cached.
+    std::shared_ptr<ParseResult> DeserializeFromString(const std::string& jsonString, const std::string& rendererVersion);
+    std::shared_ptr<ParseResult> DeserializeFromString(const std::string& jsonString, const std::string& rendererVersion, ParseContext& context);
+
+    // Drops every entry. The hit, miss, and eviction counts keep counting from where they were.
+    void Clear();
+    Statistics GetStatistics() const;
+
+    // Entries are charged for their JSON text plus the memory their card takes up (measured when the card was
+    // parsed into an arena, estimated from the size of the JSON otherwise). Lowering the budget evicts right away.
+    size_t GetMaxBytes() const;
+    void SetMaxBytes(size_t maxBytes);
+
+private:
+    struct Entry
+    {
+        size_t hash;
+        std::string jsonString;
+        std::string rendererVersion;
+        std::string language;
+        size_t parserFingerprint;
+        std::shared_ptr<ParseResult> result;
+        size_t cost;
+    };
+    using EntryList = std::list<Entry>;
+
+    // Built from the generations of the context's parser registrations (see ElementParserRegistration::GetFingerprint()),
+    // not from the parsers themselves. Two registrations with the same custom parsers never share entries, and neither
+    // does a registration that had a parser added and then removed with the one it was before.
+    static size_t GetParserFingerprint(const ParseContext& context);
+    static bool Matches(const Entry& entry, size_t hash, const std::string& jsonString, const std::string& rendererVersion, const std::string& language, size_t parserFingerprint);
+
+    EntryList::iterator Find(size_t hash, const std::string& jsonString, const std::string& rendererVersion, const std::string& language, size_t parserFingerprint);
+    void EvictToBudget();
+
+    mutable std::mutex m_mutex;
+    // most recently used first
+    EntryList m_entries;
+    std::unordered_multimap<size_t, EntryList::iterator> m_index;
+    size_t m_maxBytes;
+    size_t m_byteCount;
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_evictions;
+};
+} // namespace AdaptiveCards
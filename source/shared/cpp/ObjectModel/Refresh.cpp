@@ -70,7 +70,7 @@ Json::Value Refresh::SerializeToJsonValue() const
 
 std::shared_ptr<Refresh> Refresh::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<Refresh> refresh = std::make_shared<Refresh>();
+    std::shared_ptr<Refresh> refresh = context.MakeShared<Refresh>();
 
     refresh->SetAction(ParseUtil::GetAction(context, json, AdaptiveCardSchemaKey::Action));
     refresh->SetUserIds(std::move(ParseUtil::GetStringArray(json, AdaptiveCardSchemaKey::UserIds)));
@@ -64,7 +64,7 @@ std::shared_ptr<BaseCardElement> RichTextBlockParser::Deserialize(ParseContext&
 
     std::shared_ptr<RichTextBlock> richTextBlock = BaseCardElement::Deserialize<RichTextBlock>(context, json);
     richTextBlock->SetHorizontalAlignment(ParseUtil::GetOptionalEnumValue<HorizontalAlignment>(
-        json, AdaptiveCardSchemaKey::HorizontalAlignment, HorizontalAlignmentFromString));
+        json, AdaptiveCardSchemaKey::HorizontalAlignment, HorizontalAlignmentTryFromString));
 
     auto inlines = ParseUtil::GetElementCollectionOfSingleType<Inline>(
         context, json, AdaptiveCardSchemaKey::Inlines, Inline::Deserialize, false);
@@ -80,7 +80,8 @@ std::shared_ptr<BaseCardElement> RichTextBlockParser::DeserializeFromString(Pars
 
 void RichTextBlock::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Inlines)});
+    SetKnownProperties(knownProperties);
 }
@@ -10,6 +10,7 @@
 #include "SemanticVersion.h"
 #include "ParseContext.h"
 #include "BackgroundImage.h"
+#include "StreamingCardReader.h"
 
 using namespace AdaptiveCards;
 
@@ -64,7 +65,6 @@ AdaptiveCard::AdaptiveCard(
     m_language(language), m_verticalContentAlignment(verticalContentAlignment), m_height(height),
     m_minHeight(minHeight), m_internalId{InternalId::Next()}, m_additionalProperties{}
 {
-    PopulateKnownPropertiesSet();
 }
 
 AdaptiveCard::AdaptiveCard(
@@ -116,7 +116,6 @@ AdaptiveCard::AdaptiveCard(
     m_verticalContentAlignment(verticalContentAlignment), m_height(height),
     m_minHeight(minHeight), m_internalId{InternalId::Next()}, m_body(body), m_actions(actions), m_additionalProperties{}
 {
-    PopulateKnownPropertiesSet();
 }
 
 #ifdef __ANDROID__
@@ -138,10 +137,15 @@ std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromFile(
 std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromFile(const std::string& jsonFile, const std::string& rendererVersion, ParseContext& context)
 #endif // __ANDROID__
 {
+    const ParseContext::DeserializeScope deserializeScope(context);
+
     std::ifstream jsonFileStream(jsonFile);
 
     Json::Value root;
-    jsonFileStream >> root;
+    {
+        const ParseStatistics::PhaseTimer jsonParseTimer(context.GetStatistics(), &ParseStatistics::jsonParseTime);
+        jsonFileStream >> root;
+    }
 
     return AdaptiveCard::Deserialize(root, rendererVersion, context);
 }
@@ -162,6 +166,7 @@ void AdaptiveCard::_ValidateLanguage(const std::string& language, std::vector<st
     }
     catch (std::runtime_error)
     {
+        ParseStatistics::CountCaughtException();
         warnings.push_back(std::make_shared<AdaptiveCardParseWarning>(
             AdaptiveCards::WarningStatusCode::InvalidLanguage, "Invalid language identifier: " + language));
     }
@@ -173,6 +178,27 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(
 #else
 std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json, const std::string& rendererVersion, ParseContext& context)
 #endif // __ANDROID__
+{
+    const ParseContext::DeserializeScope deserializeScope(context);
+
+    return AdaptiveCard::_Deserialize(
+        json,
+        rendererVersion,
+        context,
+        [&json](ParseContext& parseContext) {
+            return ParseUtil::GetElementCollection<BaseCardElement>(true, parseContext, json, AdaptiveCardSchemaKey::Body, false);
+        },
+        [&json](ParseContext& parseContext) { return ParseUtil::GetActionCollection(parseContext, json, AdaptiveCardSchemaKey::Actions, false); });
+}
+
+// json holds every top-level property of the card. The body and actions may live elsewhere (see
+// DeserializeFromStringStreaming), so they're parsed by the supplied callbacks at the point the card needs them.
+std::shared_ptr<ParseResult> AdaptiveCard::_Deserialize(
+    const Json::Value& json,
+    const std::string& rendererVersion,
+    ParseContext& context,
+    const std::function<std::vector<std::shared_ptr<BaseCardElement>>(ParseContext&)>& deserializeBody,
+    const std::function<std::vector<std::shared_ptr<BaseActionElement>>(ParseContext&)>& deserializeActions)
 {
     ParseUtil::ThrowIfNotJsonObject(json);
 
@@ -218,7 +244,8 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
 
             context.warnings.push_back(std::make_shared<AdaptiveCardParseWarning>(
                 AdaptiveCards::WarningStatusCode::UnsupportedSchemaVersion, "Schema version not supported"));
-            return std::make_shared<ParseResult>(MakeFallbackTextCard(fallbackText, language, speak), context.warnings);
+            return std::make_shared<ParseResult>(
+                MakeFallbackTextCard(fallbackText, language, speak), context.warnings, context.GetArena(), context.m_statistics);
         }
     }
 
@@ -229,25 +256,25 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
         context, json, AdaptiveCardSchemaKey::Authentication, Authentication::Deserialize);
 
     ContainerStyle style =
-        ParseUtil::GetEnumValue<ContainerStyle>(json, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleFromString);
+        ParseUtil::GetEnumValue<ContainerStyle>(json, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleTryFromString);
     context.SetParentalContainerStyle(style);
 
     VerticalContentAlignment verticalContentAlignment = ParseUtil::GetEnumValue<VerticalContentAlignment>(
-        json, AdaptiveCardSchemaKey::VerticalContentAlignment, VerticalContentAlignment::Top, VerticalContentAlignmentFromString);
+        json, AdaptiveCardSchemaKey::VerticalContentAlignment, VerticalContentAlignment::Top, VerticalContentAlignmentTryFromString);
     HeightType height =
-        ParseUtil::GetEnumValue<HeightType>(json, AdaptiveCardSchemaKey::Height, HeightType::Auto, HeightTypeFromString);
+        ParseUtil::GetEnumValue<HeightType>(json, AdaptiveCardSchemaKey::Height, HeightType::Auto, HeightTypeTryFromString);
 
     unsigned int minHeight =
         ParseSizeForPixelSize(ParseUtil::GetString(json, AdaptiveCardSchemaKey::MinHeight), &context.warnings).value_or(0);
 
     // Parse body
-    auto body = ParseUtil::GetElementCollection<BaseCardElement>(true, context, json, AdaptiveCardSchemaKey::Body, false);
+    auto body = deserializeBody(context);
     // Parse actions if present
-    auto actions = ParseUtil::GetActionCollection(context, json, AdaptiveCardSchemaKey::Actions, false);
+    auto actions = deserializeActions(context);
 
     EnsureShowCardVersions(actions, version);
 
-    auto result = std::make_shared<AdaptiveCard>(
+    auto result = context.MakeShared<AdaptiveCard>(
         version, fallbackText, backgroundImage, refresh, authentication, style, speak, language, verticalContentAlignment, height, minHeight, body, actions);
     result->SetLanguage(language);
     result->SetRtl(ParseUtil::GetOptionalBool(json, AdaptiveCardSchemaKey::Rtl));
@@ -257,9 +284,13 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
 
     Json::Value additionalProperties;
     HandleUnknownProperties(json, result->GetKnownProperties(), additionalProperties);
-    result->SetAdditionalProperties(additionalProperties);
+    if (ParseStatistics* statistics = context.GetStatistics())
+    {
+        statistics->jsonValueCopies += additionalProperties.size();
+    }
+    result->SetAdditionalProperties(std::move(additionalProperties));
 
-    return std::make_shared<ParseResult>(result, context.warnings);
+    return std::make_shared<ParseResult>(result, context.warnings, context.GetArena(), context.m_statistics);
 }
 
 #ifdef __ANDROID__
@@ -280,7 +311,150 @@ std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromString(
 std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromString(const std::string& jsonString, const std::string& rendererVersion, ParseContext& context)
 #endif // __ANDROID__
 {
-    return AdaptiveCard::Deserialize(ParseUtil::GetJsonValueFromString(jsonString), rendererVersion, context);
+    const ParseContext::DeserializeScope deserializeScope(context);
+
+    Json::Value json;
+    {
+        const ParseStatistics::PhaseTimer jsonParseTimer(context.GetStatistics(), &ParseStatistics::jsonParseTime);
+        json = ParseUtil::GetJsonValueFromString(jsonString);
+    }
+
+    return AdaptiveCard::Deserialize(json, rendererVersion, context);
+}
+
+#ifdef __ANDROID__
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromStringStreaming(
+    const std::string& jsonString, std::string rendererVersion) throw(AdaptiveCards::AdaptiveCardParseException)
+#else
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromStringStreaming(const std::string& jsonString, const std::string& rendererVersion)
+#endif // __ANDROID__
+{
+    ParseContext context;
+    return AdaptiveCard::DeserializeFromStringStreaming(jsonString, rendererVersion, context);
+}
+
+// Produces the same result as DeserializeFromString, but never holds a Json::Value for the entire card. Each
+// member of "body" and "actions" is materialized just before its parser runs and released right after, so the
+// peak json footprint is that of the largest single top-level element (see StreamingCardReader).
+#ifdef __ANDROID__
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromStringStreaming(
+    const std::string& jsonString, std::string rendererVersion, ParseContext& context) throw(AdaptiveCards::AdaptiveCardParseException)
+#else
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromStringStreaming(
+    const std::string& jsonString, const std::string& rendererVersion, ParseContext& context)
+#endif // __ANDROID__
+{
+    const ParseContext::DeserializeScope deserializeScope(context);
+
+    std::optional<StreamingCardReader> streamingReader;
+    {
+        const ParseStatistics::PhaseTimer jsonParseTimer(context.GetStatistics(), &ParseStatistics::jsonParseTime);
+        streamingReader.emplace(jsonString);
+    }
+
+    const StreamingCardReader& reader = *streamingReader;
+    if (!reader.IsObject())
+    {
+        // let the regular path produce its usual error
+        return AdaptiveCard::DeserializeFromString(jsonString, rendererVersion, context);
+    }
+
+    const Json::Value& header = reader.GetHeader();
+    return AdaptiveCard::_Deserialize(
+        header,
+        rendererVersion,
+        context,
+        [&reader, &header](ParseContext& parseContext) {
+            const auto& spans = reader.GetBodySpans();
+            if (!spans.has_value())
+            {
+                return ParseUtil::GetElementCollection<BaseCardElement>(true, parseContext, header, AdaptiveCardSchemaKey::Body, false);
+            }
+
+            return ParseUtil::GetElementCollection<BaseCardElement>(
+                true, parseContext, spans->size(), [&spans](size_t index) { return StreamingCardReader::ParseSpan(spans->at(index)); });
+        },
+        [&reader, &header](ParseContext& parseContext) {
+            const auto& spans = reader.GetActionSpans();
+            if (!spans.has_value())
+            {
+                return ParseUtil::GetActionCollection(parseContext, header, AdaptiveCardSchemaKey::Actions, false);
+            }
+
+            return ParseUtil::GetActionCollection(
+                parseContext, spans->size(), [&spans](size_t index) { return StreamingCardReader::ParseSpan(spans->at(index)); });
+        });
+}
+
+std::vector<std::shared_ptr<ParseResult>> AdaptiveCard::DeserializeBatch(
+    const std::vector<std::string>& jsonStrings,
+    const std::string& rendererVersion,
+    std::shared_ptr<ElementParserRegistration> elementParserRegistration,
+    std::shared_ptr<ActionParserRegistration> actionParserRegistration,
+    unsigned int maxThreads,
+    std::vector<std::exception_ptr>* errors)
+{
+    // Every parse gets its own ParseContext, but they all share one set of registrations -- lookups don't modify
+    // them and the parsers they hand out are stateless
+    if (!elementParserRegistration)
+    {
+        elementParserRegistration = std::make_shared<ElementParserRegistration>();
+    }
+    if (!actionParserRegistration)
+    {
+        actionParserRegistration = std::make_shared<ActionParserRegistration>();
+    }
+
+    std::vector<std::shared_ptr<ParseResult>> results(jsonStrings.size());
+    if (errors != nullptr)
+    {
+        errors->assign(jsonStrings.size(), nullptr);
+    }
+
+    std::atomic<size_t> nextCard{0};
+    const auto parseCards = [&]() {
+        for (size_t index = nextCard++; index < jsonStrings.size(); index = nextCard++)
+        {
+            try
+            {
+                ParseContext context(elementParserRegistration, actionParserRegistration);
+                results[index] = DeserializeFromString(jsonStrings[index], rendererVersion, context);
+            }
+            catch (...)
+            {
+                if (errors != nullptr)
+                {
+                    (*errors)[index] = std::current_exception();
+                }
+            }
+        }
+    };
+
+    unsigned int threadCount = (maxThreads != 0) ? maxThreads : std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, jsonStrings.size()));
+
+    // the calling thread takes a share of the work too
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        try
+        {
+            workers.emplace_back(parseCards);
+        }
+        catch (const std::system_error&)
+        {
+            // couldn't start another thread; the ones we have will get through the rest of the cards
+            break;
+        }
+    }
+    parseCards();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    return results;
 }
 
 Json::Value AdaptiveCard::SerializeToJsonValue() const
@@ -389,6 +563,11 @@ std::string AdaptiveCard::Serialize() const
     return ParseUtil::JsonToString(SerializeToJsonValue());
 }
 
+void AdaptiveCard::Serialize(std::string& output) const
+{
+    ParseUtil::JsonToString(SerializeToJsonValue(), output);
+}
+
 std::string AdaptiveCard::GetVersion() const
 {
     return m_version;
@@ -545,30 +724,26 @@ void AdaptiveCard::SetRtl(const std::optional<bool>& value)
     m_rtl = value;
 }
 
-void AdaptiveCard::PopulateKnownPropertiesSet()
-{
-    m_knownProperties.insert(
-        {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Version),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::FallbackText),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::BackgroundImage),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Refresh),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Authentication),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MinHeight),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Speak),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Language),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::VerticalContentAlignment),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Schema)});
-}
-
 const std::unordered_set<std::string>& AdaptiveCard::GetKnownProperties() const
 {
-    return m_knownProperties;
+    static const std::unordered_set<std::string> knownProperties{
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Version),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::FallbackText),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::BackgroundImage),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Refresh),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Authentication),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MinHeight),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Speak),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Language),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::VerticalContentAlignment),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
+        AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Schema)};
+    return knownProperties;
 }
 
 const Json::Value& AdaptiveCard::GetAdditionalProperties() const
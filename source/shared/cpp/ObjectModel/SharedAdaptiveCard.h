@@ -137,6 +137,10 @@ public:
         const std::string& jsonString, std::string rendererVersion, ParseContext& context) throw(AdaptiveCards::AdaptiveCardParseException);
     static std::shared_ptr<ParseResult> DeserializeFromString(
         const std::string& jsonString, std::string rendererVersion) throw(AdaptiveCards::AdaptiveCardParseException);
+    static std::shared_ptr<ParseResult> DeserializeFromStringStreaming(
+        const std::string& jsonString, std::string rendererVersion, ParseContext& context) throw(AdaptiveCards::AdaptiveCardParseException);
+    static std::shared_ptr<ParseResult> DeserializeFromStringStreaming(
+        const std::string& jsonString, std::string rendererVersion) throw(AdaptiveCards::AdaptiveCardParseException);
     static std::shared_ptr<AdaptiveCard> MakeFallbackTextCard(
         const std::string& fallbackText, const std::string& language, const std::string& speak) throw(AdaptiveCards::AdaptiveCardParseException);
 #else
@@ -148,12 +152,31 @@ public:
     static std::shared_ptr<ParseResult> DeserializeFromString(const std::string& jsonString, const std::string& rendererVersion, ParseContext& context);
     static std::shared_ptr<ParseResult> DeserializeFromString(const std::string& jsonString, const std::string& rendererVersion);
 
+    static std::shared_ptr<ParseResult> DeserializeFromStringStreaming(
+        const std::string& jsonString, const std::string& rendererVersion, ParseContext& context);
+    static std::shared_ptr<ParseResult> DeserializeFromStringStreaming(const std::string& jsonString, const std::string& rendererVersion);
+
     static std::shared_ptr<AdaptiveCard> MakeFallbackTextCard(
         const std::string& fallbackText, const std::string& language, const std::string& speak);
 
 #endif // __ANDROID__
+
+    // Parses each of jsonStrings on up to maxThreads threads (0 means one per hardware thread). All of the parses
+    // share the given registrations (or one default pair), which must not be modified until the call returns.
+    // Results are in input order. A card that fails to parse gets a nullptr result; if errors is provided, the
+    // exception is stored at the same index.
+    static std::vector<std::shared_ptr<ParseResult>> DeserializeBatch(
+        const std::vector<std::string>& jsonStrings,
+        const std::string& rendererVersion,
+        std::shared_ptr<ElementParserRegistration> elementParserRegistration = nullptr,
+        std::shared_ptr<ActionParserRegistration> actionParserRegistration = nullptr,
+        unsigned int maxThreads = 0,
+        std::vector<std::exception_ptr>* errors = nullptr);
+
     Json::Value SerializeToJsonValue() const;
     std::string Serialize() const;
+    // Serializes into output (replacing its contents), so that a buffer can be reused across calls
+    void Serialize(std::string& output) const;
 
     const InternalId GetInternalId() const
     {
@@ -161,8 +184,13 @@ public:
     }
 
 private:
+    static std::shared_ptr<ParseResult> _Deserialize(
+        const Json::Value& json,
+        const std::string& rendererVersion,
+        ParseContext& context,
+        const std::function<std::vector<std::shared_ptr<BaseCardElement>>(ParseContext&)>& deserializeBody,
+        const std::function<std::vector<std::shared_ptr<BaseActionElement>>(ParseContext&)>& deserializeActions);
     static void _ValidateLanguage(const std::string& language, std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& warnings);
-    void PopulateKnownPropertiesSet();
 
     std::string m_version;
     std::string m_fallbackText;
@@ -177,7 +205,6 @@ private:
     unsigned int m_minHeight;
     std::optional<bool> m_rtl;
     InternalId m_internalId;
-    std::unordered_set<std::string> m_knownProperties;
     Json::Value m_additionalProperties;
 
     std::vector<std::shared_ptr<BaseCardElement>> m_body;
@@ -24,20 +24,34 @@ Json::Value ShowCardAction::SerializeToJsonValue() const
 
 std::shared_ptr<AdaptiveCard> ShowCardAction::GetCard() const
 {
-    return m_card;
+    return m_deferredCard ? m_deferredCard->GetCard() : m_card;
 }
 
 void ShowCardAction::SetCard(const std::shared_ptr<AdaptiveCard> card)
 {
     m_card = card;
+    m_deferredCard.reset();
+}
+
+void ShowCardAction::SetDefaultCardVersion(const std::string& version)
+{
+    if (m_deferredCard)
+    {
+        m_deferredCard->SetDefaultCardVersion(version);
+    }
+    else if (m_card->GetVersion().empty())
+    {
+        m_card->SetVersion(version);
+    }
 }
 
 void ShowCardAction::SetLanguage(const std::string& value)
 {
     // If the card inside doesn't specify language, propagate
-    if (m_card->GetLanguage().empty())
+    const auto card = GetCard();
+    if (card->GetLanguage().empty())
     {
-        m_card->SetLanguage(value);
+        card->SetLanguage(value);
     }
 }
 
@@ -45,9 +59,13 @@ std::shared_ptr<BaseActionElement> ShowCardActionParser::Deserialize(ParseContex
 {
     std::shared_ptr<ShowCardAction> showCardAction = BaseActionElement::Deserialize<ShowCardAction>(context, json);
 
-    const std::string& propertyName = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card);
+    showCardAction->m_deferredCard = DeferredParse::DeferShowCard(context, ParseUtil::GetJsonValue(json, AdaptiveCardSchemaKey::Card));
+    if (showCardAction->m_deferredCard)
+    {
+        return showCardAction;
+    }
 
-    auto parseResult = AdaptiveCard::Deserialize(json.get(propertyName, Json::Value()), "", context);
+    auto parseResult = AdaptiveCard::Deserialize(ParseUtil::GetJsonValue(json, AdaptiveCardSchemaKey::Card), "", context);
 
     auto showCardWarnings = parseResult->GetWarnings();
     auto warningsEnd = context.warnings.insert(context.warnings.end(), showCardWarnings.begin(), showCardWarnings.end());
@@ -64,7 +82,9 @@ std::shared_ptr<BaseActionElement> ShowCardActionParser::DeserializeFromString(P
 
 void ShowCardAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)});
+    SetKnownProperties(knownProperties);
 }
 
 void ShowCardAction::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
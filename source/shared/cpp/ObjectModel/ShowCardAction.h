@@ -11,6 +11,8 @@ namespace AdaptiveCards
 {
 class ShowCardAction : public BaseActionElement
 {
+    friend class ShowCardActionParser;
+
 public:
     ShowCardAction();
     ShowCardAction(const ShowCardAction&) = default;
@@ -21,9 +23,13 @@ public:
 
     Json::Value SerializeToJsonValue() const override;
 
+    // Parses the card first if its parsing was deferred (see ParseContext::SetUseLazyParsing())
     std::shared_ptr<AdaptiveCards::AdaptiveCard> GetCard() const;
     void SetCard(const std::shared_ptr<AdaptiveCards::AdaptiveCard>);
 
+    // Sets the card's version if it doesn't have one, without parsing a deferred card
+    void SetDefaultCardVersion(const std::string& version);
+
     void SetLanguage(const std::string& value);
 
     void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) override;
@@ -32,6 +38,7 @@ private:
     void PopulateKnownPropertiesSet();
 
     std::shared_ptr<AdaptiveCard> m_card;
+    std::shared_ptr<DeferredParse> m_deferredCard;
 };
 
 class ShowCardActionParser : public ActionElementParser
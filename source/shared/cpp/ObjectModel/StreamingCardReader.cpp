@@ -0,0 +1,274 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "StreamingCardReader.h"
+#include "AdaptiveCardParseException.h"
+#include "ParseUtil.h"
+#include <cstring>
+
+namespace
+{
+// Minimal JSON scanner. It only understands enough of the grammar to find where values begin and end -- the
+// values themselves are always handed to jsoncpp, which remains the only thing that actually parses JSON.
+class JsonScanner
+{
+public:
+    JsonScanner(const char* begin, const char* end) : m_current(begin), m_end(end) {}
+
+    char Peek() const
+    {
+        return (m_current < m_end) ? *m_current : '\0';
+    }
+
+    // jsoncpp allows comments by default, so we treat them as whitespace
+    void SkipWhitespace()
+    {
+        while (m_current < m_end)
+        {
+            const char c = *m_current;
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            {
+                ++m_current;
+            }
+            else if (c == '/' && (m_current + 1) < m_end && *(m_current + 1) == '/')
+            {
+                while (m_current < m_end && *m_current != '\n')
+                {
+                    ++m_current;
+                }
+            }
+            else if (c == '/' && (m_current + 1) < m_end && *(m_current + 1) == '*')
+            {
+                m_current += 2;
+                while ((m_current + 1) < m_end && !(*m_current == '*' && *(m_current + 1) == '/'))
+                {
+                    ++m_current;
+                }
+                if ((m_current + 1) >= m_end)
+                {
+                    ThrowInvalidJson("unterminated comment");
+                }
+                m_current += 2;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    bool TryConsume(char c)
+    {
+        SkipWhitespace();
+        if (Peek() == c)
+        {
+            ++m_current;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(char c)
+    {
+        if (!TryConsume(c))
+        {
+            ThrowInvalidJson(std::string("expected '") + c + "'");
+        }
+    }
+
+    // Returns the raw text of the string, including its quotes
+    std::string_view ReadString()
+    {
+        SkipWhitespace();
+        const char* start = m_current;
+        if (Peek() != '"')
+        {
+            ThrowInvalidJson("expected string");
+        }
+
+        ++m_current;
+        while (m_current < m_end && *m_current != '"')
+        {
+            // skip whatever is escaped, including an escaped quote
+            m_current += (*m_current == '\\') ? 2 : 1;
+        }
+
+        if (m_current >= m_end)
+        {
+            ThrowInvalidJson("unterminated string");
+        }
+
+        ++m_current;
+        return {start, static_cast<size_t>(m_current - start)};
+    }
+
+    // Returns the raw text of the next value, whatever its type
+    std::string_view SkipValue()
+    {
+        SkipWhitespace();
+        const char* start = m_current;
+        const char c = Peek();
+        if (c == '"')
+        {
+            return ReadString();
+        }
+
+        if (c == '{' || c == '[')
+        {
+            unsigned int depth = 0;
+            do
+            {
+                const char current = Peek();
+                if (current == '"')
+                {
+                    ReadString();
+                    continue;
+                }
+
+                if (current == '{' || current == '[')
+                {
+                    ++depth;
+                }
+                else if (current == '}' || current == ']')
+                {
+                    --depth;
+                }
+                else if (current == '\0' && m_current >= m_end)
+                {
+                    ThrowInvalidJson("unexpected end of input");
+                }
+
+                ++m_current;
+                if (depth != 0)
+                {
+                    SkipWhitespace();
+                }
+            } while (depth != 0);
+
+            return {start, static_cast<size_t>(m_current - start)};
+        }
+
+        // numbers and literals run until the next structural character
+        while (m_current < m_end && std::strchr(",}] \t\r\n/", *m_current) == nullptr)
+        {
+            ++m_current;
+        }
+
+        if (m_current == start)
+        {
+            ThrowInvalidJson("expected value");
+        }
+
+        return {start, static_cast<size_t>(m_current - start)};
+    }
+
+    [[noreturn]] static void ThrowInvalidJson(const std::string& details)
+    {
+        throw AdaptiveCards::AdaptiveCardParseException(
+            AdaptiveCards::ErrorStatusCode::InvalidJson, "Expected JSON Object (" + details + ")");
+    }
+
+private:
+    const char* m_current;
+    const char* m_end;
+};
+
+std::string DecodeKey(std::string_view rawKey)
+{
+    // The common case -- no escapes, so the key is just the text between the quotes
+    if (rawKey.find('\\') == std::string_view::npos)
+    {
+        return std::string(rawKey.substr(1, rawKey.size() - 2));
+    }
+
+    return AdaptiveCards::StreamingCardReader::ParseSpan(rawKey).asString();
+}
+
+std::vector<std::string_view> ReadArraySpans(JsonScanner& scanner)
+{
+    std::vector<std::string_view> spans;
+
+    scanner.Expect('[');
+    if (scanner.TryConsume(']'))
+    {
+        return spans;
+    }
+
+    do
+    {
+        spans.push_back(scanner.SkipValue());
+    } while (scanner.TryConsume(','));
+
+    scanner.Expect(']');
+    return spans;
+}
+} // namespace
+
+namespace AdaptiveCards
+{
+StreamingCardReader::StreamingCardReader(const std::string& jsonString) :
+    m_jsonString(jsonString), m_isObject(false), m_header(Json::objectValue)
+{
+    ReadRootObject();
+}
+
+void StreamingCardReader::ReadRootObject()
+{
+    JsonScanner scanner(m_jsonString.data(), m_jsonString.data() + m_jsonString.size());
+
+    scanner.SkipWhitespace();
+    if (scanner.Peek() != '{')
+    {
+        return;
+    }
+
+    m_isObject = true;
+    scanner.Expect('{');
+
+    // Reassemble everything we aren't streaming into a (small) object and let jsoncpp parse it
+    std::string headerText{"{"};
+    if (!scanner.TryConsume('}'))
+    {
+        do
+        {
+            const std::string_view rawKey = scanner.ReadString();
+            scanner.Expect(':');
+            scanner.SkipWhitespace();
+
+            if (scanner.Peek() == '[')
+            {
+                const std::string key = DecodeKey(rawKey);
+                if (key == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body))
+                {
+                    m_bodySpans = ReadArraySpans(scanner);
+                    continue;
+                }
+                if (key == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions))
+                {
+                    m_actionSpans = ReadArraySpans(scanner);
+                    continue;
+                }
+            }
+
+            const std::string_view value = scanner.SkipValue();
+            if (headerText.size() > 1)
+            {
+                headerText.push_back(',');
+            }
+            headerText.append(rawKey);
+            headerText.push_back(':');
+            headerText.append(value);
+        } while (scanner.TryConsume(','));
+
+        scanner.Expect('}');
+    }
+    headerText.push_back('}');
+
+    m_header = ParseUtil::GetJsonValueFromBuffer(headerText.data(), headerText.data() + headerText.size());
+}
+
+Json::Value StreamingCardReader::ParseSpan(std::string_view span)
+{
+    return ParseUtil::GetJsonValueFromBuffer(span.data(), span.data() + span.size());
+}
+} // namespace AdaptiveCards
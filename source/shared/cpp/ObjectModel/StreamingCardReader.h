@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveCards
+{
+// StreamingCardReader walks the text of a card once, left to right, without building a Json::Value for the whole
+// document. Every top-level property other than "body" and "actions" is gathered into a small header object. The
+// members of the "body" and "actions" arrays are only located (as spans of the source text) so that callers can
+// turn them into Json::Values one at a time, hand each one to the registered parser, and release it before moving
+// on to the next. Peak memory is therefore bounded by the largest top-level element rather than by the card.
+//
+// The reader does not copy the source text; jsonString must outlive the reader and any span it hands out.
+class StreamingCardReader
+{
+public:
+    StreamingCardReader(const std::string& jsonString);
+
+    StreamingCardReader(const StreamingCardReader&) = delete;
+    StreamingCardReader& operator=(const StreamingCardReader&) = delete;
+
+    // false if the document root isn't a JSON object. Callers should fall back to the regular parse path so that
+    // errors are reported exactly as they are today.
+    bool IsObject() const
+    {
+        return m_isObject;
+    }
+
+    // All top-level properties except streamed "body"/"actions" arrays
+    const Json::Value& GetHeader() const
+    {
+        return m_header;
+    }
+
+    // Spans are only present when the property was an array. Anything else (null, an object, a string...) is left
+    // in the header so that the usual validation reports it.
+    const std::optional<std::vector<std::string_view>>& GetBodySpans() const
+    {
+        return m_bodySpans;
+    }
+    const std::optional<std::vector<std::string_view>>& GetActionSpans() const
+    {
+        return m_actionSpans;
+    }
+
+    static Json::Value ParseSpan(std::string_view span);
+
+private:
+    void ReadRootObject();
+
+    const std::string& m_jsonString;
+    bool m_isObject;
+    Json::Value m_header;
+    std::optional<std::vector<std::string_view>> m_bodySpans;
+    std::optional<std::vector<std::string_view>> m_actionSpans;
+};
+} // namespace AdaptiveCards
@@ -109,10 +109,10 @@ std::shared_ptr<T> StyledCollectionElement::Deserialize(ParseContext& context, c
     collection->SetCanFallbackToAncestor(canFallbackToAncestor);
 
     collection->SetStyle(ParseUtil::GetEnumValue<ContainerStyle>(
-        value, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleFromString));
+        value, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleTryFromString));
 
     collection->SetVerticalContentAlignment(ParseUtil::GetOptionalEnumValue<VerticalContentAlignment>(
-        value, AdaptiveCardSchemaKey::VerticalContentAlignment, VerticalContentAlignmentFromString));
+        value, AdaptiveCardSchemaKey::VerticalContentAlignment, VerticalContentAlignmentTryFromString));
 
     collection->SetBleed(ParseUtil::GetBool(value, AdaptiveCardSchemaKey::Bleed, false));
 
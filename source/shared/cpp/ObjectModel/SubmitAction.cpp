@@ -62,9 +62,15 @@ std::shared_ptr<BaseActionElement> SubmitActionParser::Deserialize(ParseContext&
 {
     std::shared_ptr<SubmitAction> submitAction = BaseActionElement::Deserialize<SubmitAction>(context, json);
 
-    submitAction->SetDataJson(ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Data));
+    const Json::Value& data = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Data);
+    submitAction->SetDataJson(data);
+    ParseStatistics* statistics = context.GetStatistics();
+    if (statistics && !data.isNull())
+    {
+        ++statistics->jsonValueCopies;
+    }
     submitAction->SetAssociatedInputs(ParseUtil::GetEnumValue<AssociatedInputs>(
-        json, AdaptiveCardSchemaKey::AssociatedInputs, AssociatedInputs::Auto, AssociatedInputsFromString));
+        json, AdaptiveCardSchemaKey::AssociatedInputs, AssociatedInputs::Auto, AssociatedInputsTryFromString));
 
     return submitAction;
 }
@@ -76,7 +82,8 @@ std::shared_ptr<BaseActionElement> SubmitActionParser::DeserializeFromString(Par
 
 void SubmitAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Data),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AssociatedInputs)});
+    SetKnownProperties(knownProperties);
 }
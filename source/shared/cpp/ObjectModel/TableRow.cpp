@@ -18,12 +18,13 @@ TableRow::TableRow() :
 
 void TableRow::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Cells),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalCellContentAlignment),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Rtl),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::VerticalCellContentAlignment)});
+    SetKnownProperties(knownProperties);
 }
 
 std::vector<std::shared_ptr<TableCell>>& TableRow::GetCells()
@@ -115,11 +116,11 @@ std::shared_ptr<TableRow> TableRow::DeserializeTableRow(ParseContext& context, c
     std::shared_ptr<TableRow> tableRow = BaseCardElement::Deserialize<TableRow>(context, json);
 
     tableRow->SetHorizontalCellContentAlignment(ParseUtil::GetOptionalEnumValue<HorizontalAlignment>(
-        json, AdaptiveCardSchemaKey::HorizontalCellContentAlignment, HorizontalAlignmentFromString));
+        json, AdaptiveCardSchemaKey::HorizontalCellContentAlignment, HorizontalAlignmentTryFromString));
     tableRow->SetVerticalCellContentAlignment(ParseUtil::GetOptionalEnumValue<VerticalContentAlignment>(
-        json, AdaptiveCardSchemaKey::VerticalCellContentAlignment, VerticalContentAlignmentFromString));
+        json, AdaptiveCardSchemaKey::VerticalCellContentAlignment, VerticalContentAlignmentTryFromString));
     tableRow->SetStyle(ParseUtil::GetEnumValue<ContainerStyle>(
-        json, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleFromString));
+        json, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleTryFromString));
 
     auto cells = ParseUtil::GetElementCollectionOfSingleType<TableCell>(
         context, json, AdaptiveCardSchemaKey::Cells, &TableCell::DeserializeTableCell, false);
@@ -20,6 +20,28 @@ TextBlock::TextBlock() :
     PopulateKnownPropertiesSet();
 }
 
+// copies don't share their text properties, so setting a copy's text leaves the original's alone
+TextBlock::TextBlock(const TextBlock& other) :
+    BaseCardElement(other), m_wrap(other.m_wrap), m_maxLines(other.m_maxLines), m_hAlignment(other.m_hAlignment),
+    m_textStyle(other.m_textStyle),
+    m_textElementProperties(std::make_shared<TextElementProperties>(*other.m_textElementProperties))
+{
+}
+
+TextBlock& TextBlock::operator=(const TextBlock& other)
+{
+    if (this != &other)
+    {
+        BaseCardElement::operator=(other);
+        m_wrap = other.m_wrap;
+        m_maxLines = other.m_maxLines;
+        m_hAlignment = other.m_hAlignment;
+        m_textStyle = other.m_textStyle;
+        m_textElementProperties = std::make_shared<TextElementProperties>(*other.m_textElementProperties);
+    }
+    return *this;
+}
+
 Json::Value TextBlock::SerializeToJsonValue() const
 {
     Json::Value root = BaseCardElement::SerializeToJsonValue();
@@ -67,6 +89,11 @@ DateTimePreparser TextBlock::GetTextForDateParsing() const
     return m_textElementProperties->GetTextForDateParsing();
 }
 
+std::shared_ptr<const MarkDownResult> TextBlock::GetMarkDownResult(const std::string& text, MarkDownCache* cache) const
+{
+    return m_textElementProperties->GetMarkDownResult(text, cache);
+}
+
 std::optional<TextStyle> TextBlock::GetStyle() const
 {
     return m_textStyle;
@@ -175,10 +202,10 @@ std::shared_ptr<BaseCardElement> TextBlockParser::Deserialize(ParseContext& cont
     textBlock->m_textElementProperties->Deserialize(context, json);
 
     textBlock->SetWrap(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::Wrap, false));
-    textBlock->SetStyle(ParseUtil::GetOptionalEnumValue<TextStyle>(json, AdaptiveCardSchemaKey::Style, TextStyleFromString));
+    textBlock->SetStyle(ParseUtil::GetOptionalEnumValue<TextStyle>(json, AdaptiveCardSchemaKey::Style, TextStyleTryFromString));
     textBlock->SetMaxLines(ParseUtil::GetUInt(json, AdaptiveCardSchemaKey::MaxLines, 0));
     textBlock->SetHorizontalAlignment(ParseUtil::GetOptionalEnumValue<HorizontalAlignment>(
-        json, AdaptiveCardSchemaKey::HorizontalAlignment, HorizontalAlignmentFromString));
+        json, AdaptiveCardSchemaKey::HorizontalAlignment, HorizontalAlignmentTryFromString));
 
     return textBlock;
 }
@@ -190,11 +217,14 @@ std::shared_ptr<BaseCardElement> TextBlockParser::DeserializeFromString(ParseCon
 
 void TextBlock::PopulateKnownPropertiesSet()
 {
-    m_textElementProperties->PopulateKnownPropertiesSet(m_knownProperties);
-
-    m_knownProperties.insert(
-        {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MaxLines),
-         AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment)});
+    static const std::unordered_set<std::string> knownProperties = [this]() {
+        std::unordered_set<std::string> properties = ExtendKnownProperties(
+            {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap),
+             AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
+             AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MaxLines),
+             AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment)});
+        m_textElementProperties->PopulateKnownPropertiesSet(properties);
+        return properties;
+    }();
+    SetKnownProperties(knownProperties);
 }
@@ -11,16 +11,18 @@
 namespace AdaptiveCards
 {
 class TextBlockParser;
+class CardSnapshotReader;
 
 class TextBlock : public BaseCardElement
 {
     friend TextBlockParser;
+    friend CardSnapshotReader;
 
 public:
     TextBlock();
-    TextBlock(const TextBlock&) = default;
+    TextBlock(const TextBlock& other);
     TextBlock(TextBlock&&) = default;
-    TextBlock& operator=(const TextBlock&) = default;
+    TextBlock& operator=(const TextBlock& other);
     TextBlock& operator=(TextBlock&&) = default;
     ~TextBlock() = default;
 
@@ -29,6 +31,8 @@ public:
     std::string GetText() const;
     void SetText(const std::string& value);
     DateTimePreparser GetTextForDateParsing() const;
+    // markdown of the text as the host renders it, kept on the element for later renders, see MarkDownResultHolder
+    std::shared_ptr<const MarkDownResult> GetMarkDownResult(const std::string& text, MarkDownCache* cache = nullptr) const;
 
     std::optional<TextStyle> GetStyle() const;
     void SetStyle(const std::optional<TextStyle> value);
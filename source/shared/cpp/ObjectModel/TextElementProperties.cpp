@@ -109,6 +109,11 @@ DateTimePreparser TextElementProperties::GetTextForDateParsing() const
     return DateTimePreparser(m_text);
 }
 
+std::shared_ptr<const MarkDownResult> TextElementProperties::GetMarkDownResult(const std::string& text, MarkDownCache* cache) const
+{
+    return m_markDownResult.Transform(text, cache);
+}
+
 std::optional<TextSize> TextElementProperties::GetTextSize() const
 {
     return m_textSize;
@@ -178,10 +183,10 @@ void TextElementProperties::Deserialize(ParseContext& context, const Json::Value
             WarningStatusCode::RequiredPropertyMissing, "required property, \"text\", is either empty or missing"));
     }
 
-    SetTextSize(ParseUtil::GetOptionalEnumValue<TextSize>(json, AdaptiveCardSchemaKey::Size, TextSizeFromString));
-    SetTextColor(ParseUtil::GetOptionalEnumValue<ForegroundColor>(json, AdaptiveCardSchemaKey::Color, ForegroundColorFromString));
-    SetTextWeight(ParseUtil::GetOptionalEnumValue<TextWeight>(json, AdaptiveCardSchemaKey::TextWeight, TextWeightFromString));
-    SetFontType(ParseUtil::GetOptionalEnumValue<FontType>(json, AdaptiveCardSchemaKey::FontType, FontTypeFromString));
+    SetTextSize(ParseUtil::GetOptionalEnumValue<TextSize>(json, AdaptiveCardSchemaKey::Size, TextSizeTryFromString));
+    SetTextColor(ParseUtil::GetOptionalEnumValue<ForegroundColor>(json, AdaptiveCardSchemaKey::Color, ForegroundColorTryFromString));
+    SetTextWeight(ParseUtil::GetOptionalEnumValue<TextWeight>(json, AdaptiveCardSchemaKey::TextWeight, TextWeightTryFromString));
+    SetFontType(ParseUtil::GetOptionalEnumValue<FontType>(json, AdaptiveCardSchemaKey::FontType, FontTypeTryFromString));
     SetIsSubtle(ParseUtil::GetOptionalBool(json, AdaptiveCardSchemaKey::IsSubtle));
     SetLanguage(context.GetLanguage());
 }
@@ -7,6 +7,7 @@
 #include "ElementParserRegistration.h"
 #include "DateTimePreparser.h"
 #include "HostConfig.h"
+#include "MarkDownCache.h"
 
 namespace AdaptiveCards
 {
@@ -26,6 +27,8 @@ public:
     std::string GetText() const;
     void SetText(const std::string& value);
     DateTimePreparser GetTextForDateParsing() const;
+    // markdown of the text as the host renders it, kept on the element for later renders, see MarkDownResultHolder
+    std::shared_ptr<const MarkDownResult> GetMarkDownResult(const std::string& text, MarkDownCache* cache = nullptr) const;
 
     std::optional<TextSize> GetTextSize() const;
     void SetTextSize(const std::optional<TextSize> value);
@@ -49,6 +52,8 @@ public:
     virtual void PopulateKnownPropertiesSet(std::unordered_set<std::string>& knownProperties);
 
 private:
+    friend class CardSnapshotReader;
+
     static std::string _ProcessHTMLEntities(const std::string& input);
 
     std::string m_text;
@@ -58,5 +63,6 @@ private:
     std::optional<ForegroundColor> m_textColor;
     std::optional<bool> m_isSubtle;
     std::string m_language;
+    MarkDownResultHolder m_markDownResult;
 };
 } // namespace AdaptiveCards
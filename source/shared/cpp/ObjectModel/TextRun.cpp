@@ -12,9 +12,33 @@ TextRun::TextRun() :
     PopulateKnownPropertiesSet();
 }
 
+// copies don't share their text properties, so setting a copy's text leaves the original's alone
+TextRun::TextRun(const TextRun& other) :
+    Inline(other), m_textElementProperties(std::make_shared<RichTextElementProperties>(*other.m_textElementProperties)),
+    m_selectAction(other.m_selectAction), m_highlight(other.m_highlight)
+{
+}
+
+TextRun& TextRun::operator=(const TextRun& other)
+{
+    if (this != &other)
+    {
+        Inline::operator=(other);
+        m_textElementProperties = std::make_shared<RichTextElementProperties>(*other.m_textElementProperties);
+        m_selectAction = other.m_selectAction;
+        m_highlight = other.m_highlight;
+    }
+    return *this;
+}
+
 void TextRun::PopulateKnownPropertiesSet()
 {
-    m_textElementProperties->PopulateKnownPropertiesSet(m_knownProperties);
+    static const std::unordered_set<std::string> knownProperties = [this]() {
+        std::unordered_set<std::string> properties{*m_knownProperties};
+        m_textElementProperties->PopulateKnownPropertiesSet(properties);
+        return properties;
+    }();
+    m_knownProperties = &knownProperties;
 }
 
 Json::Value TextRun::SerializeToJsonValue() const
@@ -51,6 +75,11 @@ DateTimePreparser TextRun::GetTextForDateParsing() const
     return m_textElementProperties->GetTextForDateParsing();
 }
 
+std::shared_ptr<const MarkDownResult> TextRun::GetMarkDownResult(const std::string& text, MarkDownCache* cache) const
+{
+    return m_textElementProperties->GetMarkDownResult(text, cache);
+}
+
 std::optional<TextSize> TextRun::GetTextSize() const
 {
     return m_textElementProperties->GetTextSize();
@@ -163,7 +192,7 @@ void TextRun::SetUnderline(const bool value)
 
 std::shared_ptr<Inline> TextRun::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<TextRun> inlineTextRun = std::make_shared<TextRun>();
+    std::shared_ptr<TextRun> inlineTextRun = context.MakeShared<TextRun>();
 
     if (json.isString())
     {
@@ -178,7 +207,7 @@ std::shared_ptr<Inline> TextRun::Deserialize(ParseContext& context, const Json::
         inlineTextRun->SetUnderline(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::Underline, false));
         inlineTextRun->SetSelectAction(ParseUtil::GetAction(context, json, AdaptiveCardSchemaKey::SelectAction, false));
 
-        HandleUnknownProperties(json, inlineTextRun->m_knownProperties, inlineTextRun->m_additionalProperties);
+        HandleUnknownProperties(json, *inlineTextRun->m_knownProperties, inlineTextRun->m_additionalProperties);
     }
 
     return inlineTextRun;
@@ -9,13 +9,17 @@
 
 namespace AdaptiveCards
 {
+class CardSnapshotReader;
+
 class TextRun : public Inline
 {
+    friend CardSnapshotReader;
+
 public:
     TextRun();
-    TextRun(const TextRun&) = default;
+    TextRun(const TextRun& other);
     TextRun(TextRun&&) = default;
-    TextRun& operator=(const TextRun&) = default;
+    TextRun& operator=(const TextRun& other);
     TextRun& operator=(TextRun&&) = default;
     ~TextRun() = default;
 
@@ -26,6 +30,8 @@ public:
     std::string GetText() const;
     void SetText(const std::string& value);
     DateTimePreparser GetTextForDateParsing() const;
+    // markdown of the text as the host renders it, kept on the element for later renders, see MarkDownResultHolder
+    std::shared_ptr<const MarkDownResult> GetMarkDownResult(const std::string& text, MarkDownCache* cache = nullptr) const;
 
     std::optional<TextSize> GetTextSize() const;
     void SetTextSize(const std::optional<TextSize> value);
@@ -113,10 +113,11 @@ std::shared_ptr<BaseCardElement> ToggleInputParser::DeserializeFromString(ParseC
 
 void ToggleInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert(
+    static const std::unordered_set<std::string> knownProperties = ExtendKnownProperties(
         {AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ValueOn),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ValueOff),
          AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap)});
+    SetKnownProperties(knownProperties);
 }
@@ -53,5 +53,7 @@ std::shared_ptr<BaseActionElement> ToggleVisibilityActionParser::DeserializeFrom
 
 void ToggleVisibilityAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::TargetElements)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::TargetElements)});
+    SetKnownProperties(knownProperties);
 }
@@ -19,6 +19,10 @@ std::shared_ptr<BaseActionElement> UnknownActionParser::Deserialize(ParseContext
     std::string actualType = ParseUtil::GetTypeAsString(json);
     std::shared_ptr<UnknownAction> unknown = BaseActionElement::Deserialize<UnknownAction>(context, json);
     unknown->SetAdditionalProperties(json);
+    if (ParseStatistics* statistics = context.GetStatistics())
+    {
+        ++statistics->jsonValueCopies;
+    }
     unknown->SetElementTypeString(actualType);
     return unknown;
 }
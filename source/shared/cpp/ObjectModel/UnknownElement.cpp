@@ -23,6 +23,10 @@ std::shared_ptr<BaseCardElement> UnknownElementParser::Deserialize(ParseContext&
     std::string actualType = ParseUtil::GetTypeAsString(json);
     std::shared_ptr<UnknownElement> unknown = BaseCardElement::Deserialize<UnknownElement>(context, json);
     unknown->SetAdditionalProperties(json);
+    if (ParseStatistics* statistics = context.GetStatistics())
+    {
+        ++statistics->jsonValueCopies;
+    }
     unknown->SetElementTypeString(actualType);
 
     return unknown;
@@ -2,13 +2,37 @@
 // Licensed under the MIT License.
 #include "pch.h"
 
+#include "ActionSet.h"
+#include "ChoiceInput.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
 #include "ColumnSet.h"
 #include "Container.h"
+#include "DateInput.h"
+#include "ExecuteAction.h"
+#include "Fact.h"
 #include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "NumberInput.h"
+#include "OpenUrlAction.h"
 #include "RichTextBlock.h"
 #include "ShowCardAction.h"
+#include "SubmitAction.h"
+#include "Table.h"
+#include "TableCell.h"
+#include "TableRow.h"
 #include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+#include "ToggleVisibilityAction.h"
+#include "UnknownAction.h"
+#include "UnknownElement.h"
 #include "Util.h"
+#include <typeinfo>
 
 using namespace AdaptiveCards;
 
@@ -70,6 +94,7 @@ void ValidateUserInputForDimensionWithUnit(
         }
         catch (const std::invalid_argument&)
         {
+            ParseStatistics::CountCaughtException();
             if (warnings)
             {
                 warnings->emplace_back(std::make_shared<AdaptiveCardParseWarning>(
@@ -78,6 +103,7 @@ void ValidateUserInputForDimensionWithUnit(
         }
         catch (const std::out_of_range&)
         {
+            ParseStatistics::CountCaughtException();
             if (warnings)
             {
                 warnings->emplace_back(std::make_shared<AdaptiveCardParseWarning>(
@@ -140,11 +166,7 @@ void EnsureShowCardVersions(const std::vector<std::shared_ptr<BaseActionElement>
     {
         if (action->GetElementType() == ActionType::ShowCard)
         {
-            auto showCardAction = std::static_pointer_cast<ShowCardAction>(action);
-            if (showCardAction->GetCard()->GetVersion().empty())
-            {
-                showCardAction->GetCard()->SetVersion(version);
-            }
+            std::static_pointer_cast<ShowCardAction>(action)->SetDefaultCardVersion(version);
         }
     }
 }
@@ -160,3 +182,192 @@ void HandleUnknownProperties(const Json::Value& json, const std::unordered_set<s
         }
     }
 }
+
+namespace
+{
+template <typename T>
+std::shared_ptr<T> CopyAs(const BaseCardElement& element)
+{
+    // a host's subclass of a built-in element would be sliced
+    if (typeid(element) != typeid(T))
+    {
+        throw std::invalid_argument("Custom elements can't be copied");
+    }
+    return std::make_shared<T>(static_cast<const T&>(element));
+}
+
+template <typename T>
+std::shared_ptr<BaseActionElement> CopyActionAs(const std::shared_ptr<BaseActionElement>& action)
+{
+    // a host's subclass of a built-in action can't be copied without slicing it, so the copy shares it instead
+    if (typeid(*action) != typeid(T))
+    {
+        return action;
+    }
+    return std::make_shared<T>(static_cast<const T&>(*action));
+}
+
+std::shared_ptr<BaseActionElement> CopyActionElement(const std::shared_ptr<BaseActionElement>& action)
+{
+    if (!action)
+    {
+        return action;
+    }
+
+    switch (action->GetElementType())
+    {
+    case ActionType::Execute:
+        return CopyActionAs<ExecuteAction>(action);
+    case ActionType::OpenUrl:
+        return CopyActionAs<OpenUrlAction>(action);
+    case ActionType::ShowCard:
+        // the card itself is still shared, the same as an element's children
+        return CopyActionAs<ShowCardAction>(action);
+    case ActionType::Submit:
+        return CopyActionAs<SubmitAction>(action);
+    case ActionType::ToggleVisibility:
+    {
+        auto copy = CopyActionAs<ToggleVisibilityAction>(action);
+        if (copy != action)
+        {
+            for (auto& target : std::static_pointer_cast<ToggleVisibilityAction>(copy)->GetTargetElements())
+            {
+                target = std::make_shared<ToggleVisibilityTarget>(*target);
+            }
+        }
+        return copy;
+    }
+    case ActionType::UnknownAction:
+        return CopyActionAs<UnknownAction>(action);
+    default:
+        return action;
+    }
+}
+
+void CopyActionElements(std::vector<std::shared_ptr<BaseActionElement>>& actions)
+{
+    for (auto& action : actions)
+    {
+        action = CopyActionElement(action);
+    }
+}
+
+template <typename T>
+void CopyEach(std::vector<std::shared_ptr<T>>& items)
+{
+    for (auto& item : items)
+    {
+        if (item)
+        {
+            item = std::make_shared<T>(*item);
+        }
+    }
+}
+
+void CopyInlines(std::vector<std::shared_ptr<Inline>>& inlines)
+{
+    for (auto& inlineElement : inlines)
+    {
+        // hosts' custom inlines can't be copied, so the copy shares them
+        if (inlineElement && typeid(*inlineElement) == typeid(TextRun))
+        {
+            auto textRun = std::make_shared<TextRun>(static_cast<const TextRun&>(*inlineElement));
+            textRun->SetSelectAction(CopyActionElement(textRun->GetSelectAction()));
+            inlineElement = std::move(textRun);
+        }
+    }
+}
+
+template <typename T>
+std::shared_ptr<BaseCardElement> CopyStyledCollectionAs(const BaseCardElement& element)
+{
+    auto copy = CopyAs<T>(element);
+    if (const auto backgroundImage = copy->GetBackgroundImage())
+    {
+        copy->SetBackgroundImage(std::make_shared<BackgroundImage>(*backgroundImage));
+    }
+    copy->SetSelectAction(CopyActionElement(copy->GetSelectAction()));
+    return copy;
+}
+} // namespace
+
+std::shared_ptr<BaseCardElement> CopyCardElement(const BaseCardElement& element)
+{
+    switch (element.GetElementType())
+    {
+    case CardElementType::ActionSet:
+    {
+        auto copy = CopyAs<ActionSet>(element);
+        CopyActionElements(copy->GetActions());
+        return copy;
+    }
+    case CardElementType::ChoiceSetInput:
+    {
+        auto copy = CopyAs<ChoiceSetInput>(element);
+        CopyEach(copy->GetChoices());
+        return copy;
+    }
+    case CardElementType::Column:
+        return CopyStyledCollectionAs<Column>(element);
+    case CardElementType::ColumnSet:
+        return CopyStyledCollectionAs<ColumnSet>(element);
+    case CardElementType::Container:
+        return CopyStyledCollectionAs<Container>(element);
+    case CardElementType::DateInput:
+        return CopyAs<DateInput>(element);
+    case CardElementType::FactSet:
+    {
+        auto copy = CopyAs<FactSet>(element);
+        CopyEach(copy->GetFacts());
+        return copy;
+    }
+    case CardElementType::Image:
+    {
+        auto copy = CopyAs<Image>(element);
+        copy->SetSelectAction(CopyActionElement(copy->GetSelectAction()));
+        return copy;
+    }
+    case CardElementType::ImageSet:
+        return CopyAs<ImageSet>(element);
+    case CardElementType::Media:
+    {
+        auto copy = CopyAs<Media>(element);
+        CopyEach(copy->GetSources());
+        return copy;
+    }
+    case CardElementType::NumberInput:
+        return CopyAs<NumberInput>(element);
+    case CardElementType::RichTextBlock:
+    {
+        auto copy = CopyAs<RichTextBlock>(element);
+        CopyInlines(copy->GetInlines());
+        return copy;
+    }
+    case CardElementType::Table:
+    {
+        auto copy = CopyAs<Table>(element);
+        CopyEach(copy->GetColumns());
+        return copy;
+    }
+    case CardElementType::TableCell:
+        return CopyStyledCollectionAs<TableCell>(element);
+    case CardElementType::TableRow:
+        return CopyAs<TableRow>(element);
+    case CardElementType::TextBlock:
+        return CopyAs<TextBlock>(element);
+    case CardElementType::TextInput:
+    {
+        auto copy = CopyAs<TextInput>(element);
+        copy->SetInlineAction(CopyActionElement(copy->GetInlineAction()));
+        return copy;
+    }
+    case CardElementType::TimeInput:
+        return CopyAs<TimeInput>(element);
+    case CardElementType::ToggleInput:
+        return CopyAs<ToggleInput>(element);
+    case CardElementType::Unknown:
+        return CopyAs<UnknownElement>(element);
+    default:
+        throw std::invalid_argument("Custom elements can't be copied");
+    }
+}
@@ -13,3 +13,9 @@ std::optional<int> ParseSizeForPixelSize(
 void EnsureShowCardVersions(const std::vector<std::shared_ptr<AdaptiveCards::BaseActionElement>>& actions, const std::string& version);
 
 void HandleUnknownProperties(const Json::Value& json, const std::unordered_set<std::string>& knownProperties, Json::Value& unknownProperties);
+
+// A copy of a built-in element that shares its child elements (and a ShowCard action's card) with the original but
+// not its other sub-objects: text properties, inlines, facts, choices, actions and the like are copied too. Hosts'
+// custom actions and inlines can't be copied and stay shared. Throws std::invalid_argument for custom elements,
+// including hosts' subclasses of built-in ones.
+std::shared_ptr<AdaptiveCards::BaseCardElement> CopyCardElement(const AdaptiveCards::BaseCardElement& element);
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Replacing the global allocation functions lets us count every allocation the object model makes (including the
+// ones inside jsoncpp and the standard library) without instrumenting it. The nothrow and sized variants provided by
+// the standard library forward to these. The std::align_val_t variants are replaced as well, so that over-aligned
+// types are counted too.
+namespace
+{
+std::atomic<uint64_t> s_allocations{0};
+std::atomic<uint64_t> s_bytes{0};
+
+void* CountedAllocate(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* CountedAllocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    const auto alignmentBytes = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    void* memory = _aligned_malloc(size != 0 ? size : 1, alignmentBytes);
+#else
+    // aligned_alloc wants a size that's a multiple of the alignment
+    const std::size_t roundedSize = ((size != 0 ? size : 1) + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+    void* memory = std::aligned_alloc(alignmentBytes, roundedSize);
+#endif
+    if (memory)
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void FreeAligned(void* memory)
+{
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return CountedAllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+namespace AdaptiveCards
+{
+namespace Benchmark
+{
+    AllocationCounts GetAllocationCounts()
+    {
+        return {s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)};
+    }
+} // namespace Benchmark
+} // namespace AdaptiveCards
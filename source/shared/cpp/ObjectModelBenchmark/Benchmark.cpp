@@ -0,0 +1,189 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace AdaptiveCards
+{
+namespace Benchmark
+{
+    BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options) : m_options(options), m_results{} {}
+
+    const BenchmarkOptions& BenchmarkRunner::GetOptions() const
+    {
+        return m_options;
+    }
+
+    bool BenchmarkRunner::IsSelected(const std::string& suite, const std::string& name, const std::string& file) const
+    {
+        if (m_options.filter.empty())
+        {
+            return true;
+        }
+        return (suite + "/" + name + "/" + file).find(m_options.filter) != std::string::npos;
+    }
+
+    void BenchmarkRunner::Run(const std::string& suite, const std::string& name, const std::string& file, const std::function<void()>& operation)
+    {
+        Run(suite, name, file, 0, operation);
+    }
+
+    void BenchmarkRunner::Run(const std::string& suite,
+                              const std::string& name,
+                              const std::string& file,
+                              uint64_t inputBytes,
+                              const std::function<void()>& operation)
+    {
+        if (!IsSelected(suite, name, file))
+        {
+            return;
+        }
+
+        BenchmarkResult result{suite, name, file, 0, 0.0, 0.0, 0.0, 0.0, std::string()};
+
+        try
+        {
+            // warm up caches (and the function-local statics in the object model) before timing anything
+            operation();
+
+            const auto minTime = std::chrono::milliseconds(m_options.minTimeMs);
+            const AllocationCounts allocationsBefore = GetAllocationCounts();
+            const auto start = std::chrono::steady_clock::now();
+            auto elapsed = std::chrono::steady_clock::duration::zero();
+
+            // run in batches that double in size so that the clock is read rarely for fast operations
+            for (uint64_t batchSize = 1; elapsed < minTime; batchSize *= 2)
+            {
+                for (uint64_t i = 0; i < batchSize; ++i)
+                {
+                    operation();
+                }
+                result.iterations += batchSize;
+                elapsed = std::chrono::steady_clock::now() - start;
+            }
+
+            const AllocationCounts allocationsAfter = GetAllocationCounts();
+            const double iterations = static_cast<double>(result.iterations);
+            result.nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+            result.allocationsPerOp = static_cast<double>(allocationsAfter.allocations - allocationsBefore.allocations) / iterations;
+            result.bytesPerOp = static_cast<double>(allocationsAfter.bytes - allocationsBefore.bytes) / iterations;
+            // bytes per nanosecond is GB/s
+            result.mbPerSecond = static_cast<double>(inputBytes) / result.nsPerOp * 1000.0;
+        }
+        catch (const std::exception& e)
+        {
+            result = BenchmarkResult{suite, name, file, 0, 0.0, 0.0, 0.0, 0.0, e.what()};
+        }
+
+        std::cerr << suite << "/" << name << (file.empty() ? "" : " " + file) << ": ";
+        if (result.error.empty())
+        {
+            std::cerr << static_cast<uint64_t>(result.nsPerOp) << " ns/op, " << result.allocationsPerOp << " allocs/op";
+            if (inputBytes != 0)
+            {
+                std::cerr << ", " << result.mbPerSecond << " MB/s";
+            }
+            std::cerr << std::endl;
+        }
+        else
+        {
+            std::cerr << "error: " << result.error << std::endl;
+        }
+
+        m_results.push_back(std::move(result));
+    }
+
+    const std::vector<BenchmarkResult>& BenchmarkRunner::GetResults() const
+    {
+        return m_results;
+    }
+
+    Json::Value BenchmarkRunner::ToJson() const
+    {
+        Json::Value root(Json::objectValue);
+
+        Json::Value& context = root["context"];
+        const std::time_t now = std::time(nullptr);
+        char date[32]{};
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        context["date"] = date;
+#ifdef NDEBUG
+        context["buildType"] = "release";
+#else
+        context["buildType"] = "debug";
+#endif
+        context["hardwareConcurrency"] = std::thread::hardware_concurrency();
+        context["minTimeMs"] = m_options.minTimeMs;
+        context["samplesDirectory"] = m_options.samplesDirectory;
+
+        Json::Value& benchmarks = root["benchmarks"];
+        benchmarks = Json::Value(Json::arrayValue);
+        for (const auto& result : m_results)
+        {
+            Json::Value benchmark(Json::objectValue);
+            benchmark["suite"] = result.suite;
+            benchmark["name"] = result.name;
+            if (!result.file.empty())
+            {
+                benchmark["file"] = result.file;
+            }
+
+            if (!result.error.empty())
+            {
+                benchmark["error"] = result.error;
+            }
+            else
+            {
+                benchmark["iterations"] = static_cast<Json::UInt64>(result.iterations);
+                benchmark["nsPerOp"] = result.nsPerOp;
+                benchmark["allocationsPerOp"] = result.allocationsPerOp;
+                benchmark["bytesPerOp"] = result.bytesPerOp;
+                if (result.mbPerSecond != 0.0)
+                {
+                    benchmark["mbPerSecond"] = result.mbPerSecond;
+                }
+            }
+            benchmarks.append(benchmark);
+        }
+
+        return root;
+    }
+
+    std::vector<std::string> FindJsonFiles(const std::string& directory)
+    {
+        std::vector<std::string> files;
+        if (!std::filesystem::is_directory(directory))
+        {
+            return files;
+        }
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".json")
+            {
+                files.push_back(entry.path().generic_string());
+            }
+        }
+
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    std::string ReadFile(const std::string& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << stream.rdbuf();
+        return contents.str();
+    }
+} // namespace Benchmark
+} // namespace AdaptiveCards
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+namespace AdaptiveCards
+{
+namespace Benchmark
+{
+    // Running totals of every heap allocation made by the process (see AllocationCounter.cpp)
+    struct AllocationCounts
+    {
+        uint64_t allocations;
+        uint64_t bytes;
+    };
+    AllocationCounts GetAllocationCounts();
+
+    struct BenchmarkResult
+    {
+        std::string suite;
+        std::string name;
+        std::string file; // empty for benchmarks that don't run over a single sample
+        uint64_t iterations;
+        double nsPerOp;
+        double allocationsPerOp;
+        double bytesPerOp;
+        // throughput over the operation's input, for benchmarks that say how much input each operation processes
+        // (0 otherwise)
+        double mbPerSecond;
+        std::string error; // set (and the measurements left at 0) if the operation threw
+    };
+
+    struct BenchmarkOptions
+    {
+        std::string samplesDirectory;
+        // only benchmarks whose "suite/name/file" contains this are run
+        std::string filter;
+        // each benchmark is repeated until it has run for at least this long
+        unsigned int minTimeMs;
+    };
+
+    class BenchmarkRunner
+    {
+    public:
+        BenchmarkRunner(const BenchmarkOptions& options);
+
+        const BenchmarkOptions& GetOptions() const;
+
+        bool IsSelected(const std::string& suite, const std::string& name, const std::string& file = std::string()) const;
+
+        // Times operation (after one untimed warm-up call) and records the result. Does nothing if the benchmark
+        // isn't selected.
+        void Run(const std::string& suite, const std::string& name, const std::string& file, const std::function<void()>& operation);
+        // Same, also reporting throughput over the inputBytes that each call of operation processes
+        void Run(const std::string& suite,
+                 const std::string& name,
+                 const std::string& file,
+                 uint64_t inputBytes,
+                 const std::function<void()>& operation);
+
+        const std::vector<BenchmarkResult>& GetResults() const;
+
+        // {"context": {...}, "benchmarks": [{"suite", "name", "file", "iterations", "nsPerOp", "allocationsPerOp", "bytesPerOp",
+        // "mbPerSecond"}, ...]}
+        Json::Value ToJson() const;
+
+    private:
+        BenchmarkOptions m_options;
+        std::vector<BenchmarkResult> m_results;
+    };
+
+    // Every *.json file under directory (recursively), sorted so that runs are comparable
+    std::vector<std::string> FindJsonFiles(const std::string& directory);
+    std::string ReadFile(const std::string& path);
+
+    // Suites (see CorpusBenchmarks.cpp and ScenarioBenchmarks.cpp)
+    void RunCorpusBenchmarks(BenchmarkRunner& runner);
+    void RunScenarioBenchmarks(BenchmarkRunner& runner);
+} // namespace Benchmark
+} // namespace AdaptiveCards
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "Benchmark.h"
+
+#include "CardSnapshot.h"
+#include "DateTimePreparser.h"
+#include "HostConfig.h"
+#include "MarkDownParser.h"
+#include "ParseContext.h"
+#include "ParsedCardCache.h"
+#include "ParseUtil.h"
+#include "SharedAdaptiveCard.h"
+
+#include <numeric>
+#include <sstream>
+
+// Benchmarks that run over every card in samples/v1.0 - v1.6 and every host config in samples/HostConfig
+namespace
+{
+constexpr auto c_corpusSuite = "corpus";
+constexpr auto c_rendererVersion = "1.6";
+constexpr const char* c_cardDirectories[] = {"v1.0", "v1.1", "v1.2", "v1.3", "v1.4", "v1.5", "v1.6"};
+constexpr auto c_hostConfigDirectory = "HostConfig";
+
+// The "text" of every TextBlock, TextRun, etc. in the card -- what a renderer hands to the markdown parser and the
+// date/time preparser
+void CollectText(const Json::Value& json, std::vector<std::string>& texts)
+{
+    if (json.isObject())
+    {
+        for (auto it = json.begin(); it != json.end(); ++it)
+        {
+            if (it.name() == "text" && it->isString())
+            {
+                texts.push_back(it->asString());
+            }
+            else
+            {
+                CollectText(*it, texts);
+            }
+        }
+    }
+    else if (json.isArray())
+    {
+        for (const auto& item : json)
+        {
+            CollectText(item, texts);
+        }
+    }
+}
+
+void RunCardBenchmarks(AdaptiveCards::Benchmark::BenchmarkRunner& runner, const std::string& path, const std::string& file)
+{
+    using namespace AdaptiveCards;
+
+    const std::string json = Benchmark::ReadFile(path);
+
+    runner.Run(c_corpusSuite, "DeserializeFromString", file, [&json]() {
+        AdaptiveCard::DeserializeFromString(json, c_rendererVersion);
+    });
+
+    runner.Run(c_corpusSuite, "DeserializeFromFile", file, [&path]() {
+        AdaptiveCard::DeserializeFromFile(path, c_rendererVersion);
+    });
+
+    runner.Run(c_corpusSuite, "DeserializeFromStringStreaming", file, [&json]() {
+        AdaptiveCard::DeserializeFromStringStreaming(json, c_rendererVersion);
+    });
+
+    runner.Run(c_corpusSuite, "DeserializeFromString/arena", file, [&json]() {
+        ParseContext context;
+        context.SetUseArenaAllocation(true);
+        AdaptiveCard::DeserializeFromString(json, c_rendererVersion, context);
+    });
+
+    ParsedCardCache cache;
+    runner.Run(c_corpusSuite, "ParsedCardCache/hit", file, [&json, &cache]() {
+        cache.DeserializeFromString(json, c_rendererVersion);
+    });
+
+    std::shared_ptr<AdaptiveCard> card;
+    try
+    {
+        card = AdaptiveCard::DeserializeFromString(json, c_rendererVersion)->GetAdaptiveCard();
+    }
+    catch (const std::exception&)
+    {
+        // the parse benchmarks above have already recorded the error
+        return;
+    }
+
+    runner.Run(c_corpusSuite, "SerializeToJsonValue", file, [&card]() { card->SerializeToJsonValue(); });
+    runner.Run(c_corpusSuite, "Serialize", file, [&card]() { card->Serialize(); });
+
+    std::string buffer;
+    runner.Run(c_corpusSuite, "Serialize/reusedBuffer", file, [&card, &buffer]() { card->Serialize(buffer); });
+
+    // How Serialize() wrote its output before it had its own writer, for comparison
+    runner.Run(c_corpusSuite, "Serialize/StreamWriter", file, [&card]() {
+        Json::StreamWriterBuilder builder;
+        builder["commentStyle"] = "None";
+        builder["indentation"] = "";
+        const std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+        std::ostringstream outStream;
+        writer->write(card->SerializeToJsonValue(), &outStream);
+        outStream << std::endl;
+        outStream.str();
+    });
+
+    runner.Run(c_corpusSuite, "GetResourceInformation", file, [&card]() { card->GetResourceInformation(); });
+
+    runner.Run(c_corpusSuite, "CardSnapshot::Save", file, [&card]() { CardSnapshot::Save(*card); });
+
+    const std::vector<uint8_t> snapshot = CardSnapshot::Save(*card);
+    runner.Run(c_corpusSuite, "CardSnapshot::Load", file, [&snapshot]() {
+        CardSnapshot::Load(snapshot.data(), snapshot.size(), c_rendererVersion);
+    });
+
+    std::vector<std::string> texts;
+    CollectText(ParseUtil::GetJsonValueFromString(json), texts);
+    if (!texts.empty())
+    {
+        const uint64_t textBytes = std::accumulate(
+            texts.begin(), texts.end(), uint64_t{0}, [](uint64_t total, const std::string& text) { return total + text.size(); });
+        runner.Run(c_corpusSuite, "MarkDownParser::TransformToHtml", file, textBytes, [&texts]() {
+            for (const auto& text : texts)
+            {
+                MarkDownParser(text).TransformToHtml();
+            }
+        });
+
+        runner.Run(c_corpusSuite, "DateTimePreparser", file, [&texts]() {
+            for (const auto& text : texts)
+            {
+                DateTimePreparser{text}.GetTextTokens();
+            }
+        });
+    }
+}
+} // namespace
+
+namespace AdaptiveCards
+{
+namespace Benchmark
+{
+    void RunCorpusBenchmarks(BenchmarkRunner& runner)
+    {
+        const std::string& samples = runner.GetOptions().samplesDirectory;
+
+        for (const char* directory : c_cardDirectories)
+        {
+            for (const auto& path : FindJsonFiles(samples + "/" + directory))
+            {
+                RunCardBenchmarks(runner, path, path.substr(samples.size() + 1));
+            }
+        }
+
+        for (const auto& path : FindJsonFiles(samples + "/" + c_hostConfigDirectory))
+        {
+            const std::string json = ReadFile(path);
+            runner.Run(c_corpusSuite, "HostConfig::DeserializeFromString", path.substr(samples.size() + 1), [&json]() {
+                HostConfig::DeserializeFromString(json);
+            });
+        }
+    }
+} // namespace Benchmark
+} // namespace AdaptiveCards
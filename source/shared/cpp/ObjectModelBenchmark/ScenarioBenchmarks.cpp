@@ -0,0 +1,498 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "Benchmark.h"
+
+#include "CardPatch.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "CaseInsensitive.h"
+#include "Container.h"
+#include "ElementParserRegistration.h"
+#include "FeatureRegistration.h"
+#include "HostFeatures.h"
+#include "Image.h"
+#include "ImmutableCard.h"
+#include "MarkDownCache.h"
+#include "MarkDownParser.h"
+#include "ParseContext.h"
+#include "SharedAdaptiveCard.h"
+#include "SubmitAction.h"
+#include "Table.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+
+// Benchmarks over synthetic cards and individual pieces of the object model, for the cases the sample corpus doesn't
+// exercise well: very large or deeply nested cards, enum conversion, element construction, and multithreaded parsing.
+namespace
+{
+using namespace AdaptiveCards;
+
+constexpr auto c_scenarioSuite = "scenarios";
+constexpr auto c_rendererVersion = "1.6";
+
+std::string WrapInCard(const std::string& body)
+{
+    return R"({ "type": "AdaptiveCard", "version": "1.5", "body": [ )" + body + " ] }";
+}
+
+// A Container holding a TextBlock and the next level down, depth levels deep
+std::string MakeNestedContainers(unsigned int depth)
+{
+    std::string body = R"({ "type": "TextBlock", "text": "leaf" })";
+    for (unsigned int level = 0; level < depth; ++level)
+    {
+        body = R"({ "type": "Container", "style": "emphasis", "items": [ { "type": "TextBlock", "text": "level )" +
+               std::to_string(level) + R"(" }, )" + body + " ] }";
+    }
+    return WrapInCard(body);
+}
+
+// A flat body cycling through a handful of common element types
+std::string MakeLargeBody(unsigned int elementCount)
+{
+    std::string body;
+    for (unsigned int i = 0; i < elementCount; ++i)
+    {
+        const std::string id = std::to_string(i);
+        switch (i % 4)
+        {
+        case 0:
+            body += R"({ "type": "TextBlock", "text": "Text )" + id + R"(", "wrap": true, "size": "large" },)";
+            break;
+        case 1:
+            body += R"({ "type": "Image", "url": "https://adaptivecards.io/content/cats/)" + id + R"(.png", "size": "small" },)";
+            break;
+        case 2:
+            body += R"({ "type": "Input.Text", "id": "input)" + id + R"(", "placeholder": "Enter text" },)";
+            break;
+        default:
+            body += R"({ "type": "Container", "items": [ { "type": "TextBlock", "text": "Nested )" + id + R"(" } ] },)";
+            break;
+        }
+    }
+    body.pop_back();
+    return WrapInCard(body);
+}
+
+std::string MakeLargeTable(unsigned int rowCount, unsigned int columnCount)
+{
+    std::string columns;
+    std::string cells;
+    for (unsigned int column = 0; column < columnCount; ++column)
+    {
+        columns += R"({ "width": 1 },)";
+        cells += R"({ "type": "TableCell", "items": [ { "type": "TextBlock", "text": "Cell )" + std::to_string(column) + R"(" } ] },)";
+    }
+    columns.pop_back();
+    cells.pop_back();
+
+    std::string rows;
+    for (unsigned int row = 0; row < rowCount; ++row)
+    {
+        rows += R"({ "type": "TableRow", "cells": [ )" + cells + " ] },";
+    }
+    rows.pop_back();
+
+    return WrapInCard(R"({ "type": "Table", "columns": [ )" + columns + R"( ], "rows": [ )" + rows + " ] }");
+}
+
+// A short body, then actionCount Action.ShowCard actions, each holding a form of elementsPerCard elements with
+// fallback content for its inputs
+std::string MakeShowCards(unsigned int actionCount, unsigned int elementsPerCard)
+{
+    std::string actions;
+    for (unsigned int action = 0; action < actionCount; ++action)
+    {
+        std::string body;
+        for (unsigned int i = 0; i < elementsPerCard; ++i)
+        {
+            const std::string id = std::to_string(action) + "_" + std::to_string(i);
+            body += R"({ "type": "Input.Rating", "id": "input)" + id +
+                    R"(", "fallback": { "type": "Input.Text", "id": "input)" + id + R"(", "placeholder": "Enter text" } },)";
+            body += R"({ "type": "TextBlock", "text": "Label )" + id + R"(", "wrap": true },)";
+        }
+        body.pop_back();
+        actions += R"({ "type": "Action.ShowCard", "title": "Form )" + std::to_string(action) +
+                   R"(", "card": { "type": "AdaptiveCard", "body": [ )" + body + " ] } },";
+    }
+    actions.pop_back();
+
+    return R"({ "type": "AdaptiveCard", "version": "1.5", "body": [ { "type": "TextBlock", "text": "Pick a form" } ], "actions": [ )" +
+           actions + " ] }";
+}
+
+// Chat-style TextBlock text: plain sentences or, with markDown, the emphasis, links and lists people use in messages
+std::vector<std::string> MakeChatMessages(unsigned int count, bool markDown)
+{
+    std::vector<std::string> messages;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const std::string id = std::to_string(i);
+        if (!markDown)
+        {
+            messages.push_back("Request " + id + " was approved by the reviewer, who left no further comments on it.");
+            continue;
+        }
+
+        switch (i % 4)
+        {
+        case 0:
+            messages.push_back("**Status:** Approved by _the reviewer_ for request " + id);
+            break;
+        case 1:
+            messages.push_back("See [request " + id + "](https://adaptivecards.io/requests/" + id + ") for the details & history");
+            break;
+        case 2:
+            messages.push_back("- first item " + id + "\r- second item with **bold** text\r- third item");
+            break;
+        default:
+            messages.push_back("1. Open the request\n2. Check the *changes* in " + id + "\n3. Approve it");
+            break;
+        }
+    }
+    return messages;
+}
+
+void RunParseBenchmark(Benchmark::BenchmarkRunner& runner, const std::string& name, const std::string& json, size_t parallelParseThreshold = 0)
+{
+    runner.Run(c_scenarioSuite, name, std::string(), [&json, parallelParseThreshold]() {
+        ParseContext context;
+        context.SetParallelParseThreshold(parallelParseThreshold);
+        AdaptiveCard::DeserializeFromString(json, c_rendererVersion, context);
+    });
+}
+
+template <typename T>
+void RunConstructionBenchmark(Benchmark::BenchmarkRunner& runner, const std::string& typeName)
+{
+    runner.Run(c_scenarioSuite, "Construct/" + typeName, std::string(), []() { std::make_shared<T>(); });
+}
+
+// Enum conversion over every value of the enum, in both directions, plus the cost of a value that isn't recognized
+template <typename T>
+void RunEnumBenchmarks(
+    Benchmark::BenchmarkRunner& runner,
+    const std::string& typeName,
+    const std::string& (*toString)(const T),
+    T (*fromString)(const std::string&),
+    std::optional<T> (*tryFromString)(const std::string&))
+{
+    // Our enums are small and non-negative, so probing the first few hundred values finds all of them
+    std::vector<T> values;
+    std::vector<std::string> strings;
+    for (int i = 0; i < 512; ++i)
+    {
+        try
+        {
+            strings.push_back(toString(static_cast<T>(i)));
+            values.push_back(static_cast<T>(i));
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+
+    const std::string prefix = "EnumConversion/" + typeName + "/";
+    runner.Run(c_scenarioSuite, prefix + "ToString", std::string(), [&values, toString]() {
+        for (const T value : values)
+        {
+            toString(value);
+        }
+    });
+
+    runner.Run(c_scenarioSuite, prefix + "TryFromString", std::string(), [&strings, tryFromString]() {
+        for (const auto& string : strings)
+        {
+            tryFromString(string);
+        }
+    });
+
+    const std::string unknown{"notAValueOfThisEnum"};
+    runner.Run(c_scenarioSuite, prefix + "TryFromString/unknown", std::string(), [&unknown, tryFromString]() {
+        tryFromString(unknown);
+    });
+
+    runner.Run(c_scenarioSuite, prefix + "FromString/unknown", std::string(), [&unknown, fromString]() {
+        try
+        {
+            fromString(unknown);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    });
+}
+
+#define RUN_ENUM_BENCHMARKS(ENUMTYPE) \
+    RunEnumBenchmarks<ENUMTYPE>(runner, #ENUMTYPE, ENUMTYPE##ToString, ENUMTYPE##FromString, ENUMTYPE##TryFromString)
+} // namespace
+
+namespace AdaptiveCards
+{
+namespace Benchmark
+{
+    void RunScenarioBenchmarks(BenchmarkRunner& runner)
+    {
+        // Deeply nested cards (cost should grow with the number of elements, not depth x size)
+        for (unsigned int depth : {1u, 8u, 32u, 128u})
+        {
+            RunParseBenchmark(runner, "NestedContainers/depth:" + std::to_string(depth), MakeNestedContainers(depth));
+        }
+
+        // Large bodies (dominated by per-element dispatch and construction)
+        for (unsigned int elementCount : {100u, 1000u, 10000u})
+        {
+            const std::string json = MakeLargeBody(elementCount);
+            const std::string name = "LargeBody/elements:" + std::to_string(elementCount);
+            RunParseBenchmark(runner, name, json);
+            RunParseBenchmark(runner, name + "/parallelThreshold:64", json, 64);
+
+            runner.Run(c_scenarioSuite, name + "/streaming", std::string(), [&json]() {
+                AdaptiveCard::DeserializeFromStringStreaming(json, c_rendererVersion);
+            });
+            runner.Run(c_scenarioSuite, name + "/arena", std::string(), [&json]() {
+                ParseContext context;
+                context.SetUseArenaAllocation(true);
+                AdaptiveCard::DeserializeFromString(json, c_rendererVersion, context);
+            });
+            runner.Run(c_scenarioSuite, name + "/statistics", std::string(), [&json]() {
+                ParseContext context;
+                context.SetCollectStatistics(true);
+                context.SetAllocationCounter([]() {
+                    const AllocationCounts counts = GetAllocationCounts();
+                    return ParseStatistics::AllocationCounts{static_cast<size_t>(counts.allocations), static_cast<size_t>(counts.bytes)};
+                });
+                AdaptiveCard::DeserializeFromString(json, c_rendererVersion, context);
+            });
+        }
+
+        // Per-user variants of a large card: path-copying edits against re-parsing the card for every variant
+        {
+            const std::string json = MakeLargeBody(1000);
+            const ImmutableCard card(AdaptiveCard::DeserializeFromString(json, c_rendererVersion)->GetAdaptiveCard());
+            runner.Run(c_scenarioSuite, "CardVariant/elements:1000/ImmutableCard::WithInputValue", std::string(), [&card]() {
+                card.WithInputValue("input998", "value");
+            });
+            runner.Run(c_scenarioSuite, "CardVariant/elements:1000/reparse", std::string(), [&json]() {
+                const auto card = AdaptiveCard::DeserializeFromString(json, c_rendererVersion)->GetAdaptiveCard();
+                std::static_pointer_cast<TextInput>(card->GetBody()[998])->SetValue("value");
+            });
+
+            // Updating a card a host already has: diffing against the new version and applying the patch
+            const auto variant = card.WithInputValue("input998", "value").WithIsVisible("input2", false).GetCard();
+            runner.Run(c_scenarioSuite, "CardVariant/elements:1000/CardPatch::Diff", std::string(), [&card, &variant]() {
+                CardPatch::Diff(*card.GetCard(), *variant);
+            });
+            const CardPatch patch = CardPatch::Diff(*card.GetCard(), *variant);
+            runner.Run(c_scenarioSuite, "CardVariant/elements:1000/CardPatch::Apply", std::string(), [&card, &patch]() {
+                patch.Apply(*card.GetCard(), c_rendererVersion);
+            });
+        }
+
+        // ShowCard forms and fallback content nobody looks at, parsed up front and lazily (and then all of it
+        // parsed through the lazy path, for the cost of deferring)
+        {
+            const std::string json = MakeShowCards(20, 25);
+            RunParseBenchmark(runner, "ShowCards/actions:20", json);
+            runner.Run(c_scenarioSuite, "ShowCards/actions:20/lazy", std::string(), [&json]() {
+                ParseContext context;
+                context.SetUseLazyParsing(true);
+                AdaptiveCard::DeserializeFromString(json, c_rendererVersion, context);
+            });
+            runner.Run(c_scenarioSuite, "ShowCards/actions:20/lazy/Serialize", std::string(), [&json]() {
+                ParseContext context;
+                context.SetUseLazyParsing(true);
+                AdaptiveCard::DeserializeFromString(json, c_rendererVersion, context)->GetAdaptiveCard()->Serialize();
+            });
+        }
+
+        // Markdown throughput over chat-style messages, with and without markdown syntax, as html and as runs, and
+        // from a warm MarkDownCache
+        for (const bool markDown : {false, true})
+        {
+            const std::vector<std::string> messages = MakeChatMessages(200, markDown);
+            const uint64_t messageBytes = std::accumulate(messages.begin(), messages.end(), uint64_t{0}, [](uint64_t total, const std::string& message) {
+                return total + message.size();
+            });
+            runner.Run(c_scenarioSuite, std::string("MarkDown/messages:200/") + (markDown ? "markDown" : "plain"), std::string(), messageBytes, [&messages]() {
+                for (const auto& message : messages)
+                {
+                    MarkDownParser(message).TransformToHtml();
+                }
+            });
+            runner.Run(c_scenarioSuite, std::string("MarkDown/messages:200/") + (markDown ? "markDown" : "plain") + "/runs", std::string(), messageBytes, [&messages]() {
+                for (const auto& message : messages)
+                {
+                    MarkDownParser(message).TransformToRuns();
+                }
+            });
+
+            MarkDownCache cache;
+            runner.Run(c_scenarioSuite, std::string("MarkDown/messages:200/") + (markDown ? "markDown" : "plain") + "/MarkDownCache", std::string(), messageBytes, [&messages, &cache]() {
+                for (const auto& message : messages)
+                {
+                    cache.Transform(message);
+                }
+            });
+        }
+
+        // Checking requirements and resolving fallback for a host, against what every renderer does today: a
+        // BaseElement::MeetsRequirements() call per element
+        {
+            std::string json = MakeLargeBody(1000);
+            const std::string element = R"({ "type": )";
+            for (size_t position = json.find(element); position != std::string::npos; position = json.find(element, position + 1))
+            {
+                json.insert(position + 2, R"("requires": { "adaptiveCards": "1.2", "foobar": "1" }, )");
+            }
+            const auto card = AdaptiveCard::DeserializeFromString(json, c_rendererVersion)->GetAdaptiveCard();
+
+            FeatureRegistration featureRegistration;
+            featureRegistration.AddFeature("foobar", "1.5");
+            const HostFeatures hostFeatures(featureRegistration);
+            runner.Run(c_scenarioSuite, "Requirements/elements:1000/BaseElement::MeetsRequirements", std::string(), [&card, &featureRegistration]() {
+                for (const auto& element : card->GetBody())
+                {
+                    element->MeetsRequirements(featureRegistration);
+                }
+            });
+            runner.Run(c_scenarioSuite, "Requirements/elements:1000/HostFeatures::MeetsRequirements", std::string(), [&card, &hostFeatures]() {
+                for (const auto& element : card->GetBody())
+                {
+                    hostFeatures.MeetsRequirements(*element);
+                }
+            });
+            runner.Run(c_scenarioSuite, "Requirements/elements:1000/HostFeatures::Resolve", std::string(), [&card, &hostFeatures]() {
+                hostFeatures.Resolve(*card);
+            });
+        }
+
+        // Large tables, serial and with rows parsed in parallel
+        {
+            const std::string json = MakeLargeTable(2000, 4);
+            RunParseBenchmark(runner, "LargeTable/rows:2000", json);
+            RunParseBenchmark(runner, "LargeTable/rows:2000/parallelThreshold:64", json, 64);
+        }
+
+        // Batch deserialization of the whole card corpus across 1 - 32 threads
+        {
+            std::vector<std::string> cards;
+            const std::string& samples = runner.GetOptions().samplesDirectory;
+            for (const char* directory : {"v1.0", "v1.1", "v1.2", "v1.3", "v1.4", "v1.5", "v1.6"})
+            {
+                for (const auto& path : FindJsonFiles(samples + "/" + directory))
+                {
+                    cards.push_back(ReadFile(path));
+                }
+            }
+
+            for (unsigned int threads : {1u, 2u, 4u, 8u, 16u, 32u})
+            {
+                runner.Run(c_scenarioSuite, "DeserializeBatch/threads:" + std::to_string(threads), std::string(), [&cards, threads]() {
+                    AdaptiveCard::DeserializeBatch(cards, c_rendererVersion, nullptr, nullptr, threads);
+                });
+            }
+        }
+
+        // Construction of individual elements (includes setting up their known property tables)
+        RunConstructionBenchmark<TextBlock>(runner, "TextBlock");
+        RunConstructionBenchmark<Image>(runner, "Image");
+        RunConstructionBenchmark<Container>(runner, "Container");
+        RunConstructionBenchmark<ColumnSet>(runner, "ColumnSet");
+        RunConstructionBenchmark<Column>(runner, "Column");
+        RunConstructionBenchmark<Table>(runner, "Table");
+        RunConstructionBenchmark<TextInput>(runner, "TextInput");
+        RunConstructionBenchmark<SubmitAction>(runner, "SubmitAction");
+
+        RUN_ENUM_BENCHMARKS(AdaptiveCardSchemaKey);
+        RUN_ENUM_BENCHMARKS(CardElementType);
+        RUN_ENUM_BENCHMARKS(InlineElementType);
+        RUN_ENUM_BENCHMARKS(TextStyle);
+        RUN_ENUM_BENCHMARKS(TextSize);
+        RUN_ENUM_BENCHMARKS(TextWeight);
+        RUN_ENUM_BENCHMARKS(FontType);
+        RUN_ENUM_BENCHMARKS(ForegroundColor);
+        RUN_ENUM_BENCHMARKS(HorizontalAlignment);
+        RUN_ENUM_BENCHMARKS(VerticalAlignment);
+        RUN_ENUM_BENCHMARKS(ImageFillMode);
+        RUN_ENUM_BENCHMARKS(ImageStyle);
+        RUN_ENUM_BENCHMARKS(ImageSize);
+        RUN_ENUM_BENCHMARKS(TextInputStyle);
+        RUN_ENUM_BENCHMARKS(ActionType);
+        RUN_ENUM_BENCHMARKS(ActionAlignment);
+        RUN_ENUM_BENCHMARKS(AssociatedInputs);
+        RUN_ENUM_BENCHMARKS(ChoiceSetStyle);
+        RUN_ENUM_BENCHMARKS(SeparatorThickness);
+        RUN_ENUM_BENCHMARKS(Spacing);
+        RUN_ENUM_BENCHMARKS(ActionsOrientation);
+        RUN_ENUM_BENCHMARKS(ActionMode);
+        RUN_ENUM_BENCHMARKS(ContainerStyle);
+        RUN_ENUM_BENCHMARKS(Mode);
+        RUN_ENUM_BENCHMARKS(ErrorStatusCode);
+        RUN_ENUM_BENCHMARKS(IconPlacement);
+        RUN_ENUM_BENCHMARKS(VerticalContentAlignment);
+        RUN_ENUM_BENCHMARKS(HeightType);
+
+        // Case-insensitive comparison and hashing of type names, and the lookups built on them
+        {
+            const std::vector<std::string> typeNames{"TextBlock", "RichTextBlock", "Image", "ImageSet", "Container",
+                                                     "ColumnSet", "Column", "FactSet", "Table", "ActionSet",
+                                                     "Input.Text", "Input.ChoiceSet", "Action.ShowCard",
+                                                     "Action.ToggleVisibility"};
+            std::vector<std::string> upperTypeNames = typeNames;
+            for (auto& typeName : upperTypeNames)
+            {
+                std::transform(typeName.begin(), typeName.end(), typeName.begin(), [](char c) {
+                    return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                });
+            }
+
+            runner.Run(c_scenarioSuite, "CaseInsensitive/Equals", std::string(), [&typeNames, &upperTypeNames]() {
+                for (size_t i = 0; i < typeNames.size(); ++i)
+                {
+                    CaseInsensitive::Equals(typeNames[i], upperTypeNames[i]);
+                }
+            });
+            // what comparisons used to cost: lowercasing both sides through the current locale
+            runner.Run(c_scenarioSuite, "CaseInsensitive/Equals/localeToLower", std::string(), [&typeNames, &upperTypeNames]() {
+                const auto toLower = [](const std::string& value) {
+                    std::string lower(value.size(), '\0');
+                    std::transform(value.begin(), value.end(), lower.begin(), [](char c) { return std::tolower(c, std::locale()); });
+                    return lower;
+                };
+                for (size_t i = 0; i < typeNames.size(); ++i)
+                {
+                    (void)(toLower(typeNames[i]) == toLower(upperTypeNames[i]));
+                }
+            });
+            runner.Run(c_scenarioSuite, "CaseInsensitive/Compare", std::string(), [&typeNames, &upperTypeNames]() {
+                for (size_t i = 0; i < typeNames.size(); ++i)
+                {
+                    CaseInsensitive::Compare(typeNames[i], upperTypeNames[(i + 1) % upperTypeNames.size()]);
+                }
+            });
+            runner.Run(c_scenarioSuite, "CaseInsensitive/Hash", std::string(), [&upperTypeNames]() {
+                for (const auto& typeName : upperTypeNames)
+                {
+                    CaseInsensitive::Hash(typeName);
+                }
+            });
+
+            const ElementParserRegistration elementParserRegistration;
+            runner.Run(c_scenarioSuite, "CaseInsensitive/ElementParserRegistration::GetParser", std::string(), [&elementParserRegistration, &upperTypeNames]() {
+                for (const auto& typeName : upperTypeNames)
+                {
+                    elementParserRegistration.GetParser(typeName);
+                }
+            });
+
+            FeatureRegistration featureRegistration;
+            featureRegistration.AddFeature("acTest", "1.0");
+            const std::string featureName{"ACTEST"};
+            runner.Run(c_scenarioSuite, "CaseInsensitive/FeatureRegistration::GetFeatureVersion", std::string(), [&featureRegistration, &featureName]() {
+                featureRegistration.GetFeatureVersion(featureName);
+            });
+        }
+    }
+} // namespace Benchmark
+} // namespace AdaptiveCards
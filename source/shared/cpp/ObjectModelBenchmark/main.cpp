@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "Benchmark.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#ifndef ADAPTIVECARDS_SAMPLES_DIR
+#define ADAPTIVECARDS_SAMPLES_DIR "samples"
+#endif
+
+namespace
+{
+void PrintUsage()
+{
+    std::cerr << "usage: ObjectModelBenchmark [options]\n"
+                 "  --samples <dir>      sample corpus to run over (default: " ADAPTIVECARDS_SAMPLES_DIR ")\n"
+                 "  --suite <name>       corpus, scenarios, or all (default: all)\n"
+                 "  --filter <text>      only run benchmarks whose suite/name/file contains text\n"
+                 "  --min-time-ms <n>    minimum time to spend on each benchmark (default: 25)\n"
+                 "  --output <file>      write the JSON results to file instead of stdout\n";
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    AdaptiveCards::Benchmark::BenchmarkOptions options{ADAPTIVECARDS_SAMPLES_DIR, std::string(), 25};
+    std::string suite{"all"};
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument{argv[i]};
+        if (argument == "--help" || argument == "-h")
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        const std::string value{argv[++i]};
+        if (argument == "--samples")
+        {
+            options.samplesDirectory = value;
+        }
+        else if (argument == "--suite")
+        {
+            suite = value;
+        }
+        else if (argument == "--filter")
+        {
+            options.filter = value;
+        }
+        else if (argument == "--min-time-ms")
+        {
+            options.minTimeMs = static_cast<unsigned int>(std::stoul(value));
+        }
+        else if (argument == "--output")
+        {
+            outputPath = value;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (suite != "all" && suite != "corpus" && suite != "scenarios")
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // Files are reported relative to the samples directory, so give it one canonical spelling
+    options.samplesDirectory = std::filesystem::path(options.samplesDirectory).lexically_normal().generic_string();
+    if (options.samplesDirectory.size() > 1 && options.samplesDirectory.back() == '/')
+    {
+        options.samplesDirectory.pop_back();
+    }
+
+    AdaptiveCards::Benchmark::BenchmarkRunner runner(options);
+    if (suite == "all" || suite == "corpus")
+    {
+        AdaptiveCards::Benchmark::RunCorpusBenchmarks(runner);
+    }
+    if (suite == "all" || suite == "scenarios")
+    {
+        AdaptiveCards::Benchmark::RunScenarioBenchmarks(runner);
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    const std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+
+    if (outputPath.empty())
+    {
+        writer->write(runner.ToJson(), &std::cout);
+        std::cout << std::endl;
+    }
+    else
+    {
+        std::ofstream output(outputPath);
+        writer->write(runner.ToJson(), &output);
+        output << std::endl;
+    }
+
+    return 0;
+}